@@ -0,0 +1,33 @@
+//! Shared scaffolding for the `harness = false` benches of the workspace.
+//!
+//! Every bench compares the previous implementation with the current one and
+//! prints one line per variant. Run one with
+//! `cargo bench -p <crate> --bench <name> [count]`, where `count` overrides
+//! how many iterations it runs.
+
+use std::str::FromStr;
+use std::time::{Duration, Instant};
+
+/// The first command-line argument that parses as a count, or `default`.
+/// Flags cargo passes to the bench, such as `--bench`, are skipped.
+pub fn count_arg<T: FromStr>(default: T) -> T {
+    std::env::args()
+        .skip(1)
+        .find_map(|arg| arg.parse().ok())
+        .unwrap_or(default)
+}
+
+/// Runs `f` `iterations` times and returns the total time.
+pub fn time<T>(iterations: u64, mut f: impl FnMut() -> T) -> Duration {
+    let start = Instant::now();
+    for _ in 0..iterations {
+        std::hint::black_box(f());
+    }
+    start.elapsed()
+}
+
+/// Prints the total time of `count` units of work and the time per unit.
+pub fn report(name: &str, count: u64, unit: &str, elapsed: Duration) {
+    let per_unit = Duration::from_secs_f64(elapsed.as_secs_f64() / count.max(1) as f64);
+    println!("{name:<28} {count:>10} {unit}s  {elapsed:>12.3?} total  {per_unit:>10.3?}/{unit}");
+}
@@ -0,0 +1,49 @@
+//! SQL_C_CHAR formatting of FIXED values: a `String` per cell from `format!`
+//! versus writing the digits straight into the bound buffer.
+
+use bench_support::{count_arg, report, time};
+use sfodbc::bench_internals::{
+    MAX_DECIMAL_TEXT_LEN, decimal_text_len, decimal_to_string, write_decimal_text,
+};
+
+const VALUES_PER_ITERATION: usize = 10_000;
+
+fn bench(name: &str, values: &[i128], scale: u32, iterations: u64) {
+    let cells = values.len() as u64 * iterations;
+    let mut target = [0u8; MAX_DECIMAL_TEXT_LEN];
+
+    let elapsed = time(iterations, || {
+        for &value in values {
+            let text = decimal_to_string(std::hint::black_box(value), scale);
+            target[..text.len()].copy_from_slice(text.as_bytes());
+            std::hint::black_box(&target);
+        }
+    });
+    report(&format!("{name} format!"), cells, "cell", elapsed);
+
+    let elapsed = time(iterations, || {
+        for &value in values {
+            let value = std::hint::black_box(value);
+            let len = decimal_text_len(value, scale);
+            write_decimal_text(value, scale, &mut target[..len]);
+            std::hint::black_box(&target);
+        }
+    });
+    report(&format!("{name} direct"), cells, "cell", elapsed);
+}
+
+fn main() {
+    let iterations = count_arg(200);
+
+    // Deterministic spread of signs and magnitudes, no RNG dependency needed
+    let amounts: Vec<i128> = (0..VALUES_PER_ITERATION as i128)
+        .map(|i| (i * 7_919 - 20_000_000) * 13)
+        .collect();
+    let wide: Vec<i128> = (0..VALUES_PER_ITERATION as i128)
+        .map(|i| i128::MAX / (i + 1) * if i % 2 == 0 { 1 } else { -1 })
+        .collect();
+
+    bench("NUMBER(18,0)", &amounts, 0, iterations);
+    bench("NUMBER(12,2)", &amounts, 2, iterations);
+    bench("NUMBER(38,10)", &wide, 10, iterations);
+}
@@ -4,7 +4,7 @@ use crate::api::{
     error::InvalidPortSnafu,
 };
 use odbc_sys as sql;
-use sf_core::protobuf_apis::database_driver_v1::DatabaseDriverClient;
+use sf_core::protobuf_apis::database_driver_v1::DatabaseDriverLocalClient;
 use sf_core::protobuf_gen::database_driver_v1::*;
 use snafu::ResultExt;
 use std::collections::HashMap;
@@ -37,199 +37,93 @@ pub fn driver_connect(
     );
 
     let connection = conn_from_handle(connection_handle);
-    let db_handle = DatabaseDriverClient::database_new(DatabaseNewRequest {})?
+    let db_handle = DatabaseDriverLocalClient::database_new(DatabaseNewRequest {})?
         .db_handle
         .required("Database handle is required")?;
-    let conn_handle = DatabaseDriverClient::connection_new(ConnectionNewRequest {})?
+    let conn_handle = DatabaseDriverLocalClient::connection_new(ConnectionNewRequest {})?
         .conn_handle
         .required("Connection handle is required")?;
 
+    // Collected first and sent in one call, so the connection is configured
+    // under a single lock
+    let mut options = HashMap::new();
     for (key, value) in connection_string_map {
-        match key.as_str() {
+        let (key, value) = match key.as_str() {
             // TODO: Do it more generically
-            "DRIVER" => {
-                // ignore
-            }
-            "ACCOUNT" => {
-                DatabaseDriverClient::connection_set_option_string(
-                    ConnectionSetOptionStringRequest {
-                        conn_handle: Some(conn_handle),
-                        key: "account".to_owned(),
-                        value,
-                    },
-                )?;
-            }
-            "SERVER" => {
-                DatabaseDriverClient::connection_set_option_string(
-                    ConnectionSetOptionStringRequest {
-                        conn_handle: Some(conn_handle),
-                        key: "host".to_owned(),
-                        value,
-                    },
-                )?;
-            }
-            "PWD" => {
-                DatabaseDriverClient::connection_set_option_string(
-                    ConnectionSetOptionStringRequest {
-                        conn_handle: Some(conn_handle),
-                        key: "password".to_owned(),
-                        value,
-                    },
-                )?;
-            }
-            "UID" => {
-                DatabaseDriverClient::connection_set_option_string(
-                    ConnectionSetOptionStringRequest {
-                        conn_handle: Some(conn_handle),
-                        key: "user".to_owned(),
-                        value,
-                    },
-                )?;
-            }
+            "DRIVER" => continue,
+            "ACCOUNT" => ("account", option_value::Value::StringValue(value)),
+            "SERVER" => ("host", option_value::Value::StringValue(value)),
+            "PWD" => ("password", option_value::Value::StringValue(value)),
+            "UID" => ("user", option_value::Value::StringValue(value)),
             "PORT" => {
                 let port_int: i64 = value.parse().context(InvalidPortSnafu {
                     port: value.clone(),
                 })?;
-                DatabaseDriverClient::connection_set_option_int(ConnectionSetOptionIntRequest {
-                    conn_handle: Some(conn_handle),
-                    key: "port".to_owned(),
-                    value: port_int,
-                })?;
-            }
-            "PROTOCOL" => {
-                DatabaseDriverClient::connection_set_option_string(
-                    ConnectionSetOptionStringRequest {
-                        conn_handle: Some(conn_handle),
-                        key: "protocol".to_owned(),
-                        value,
-                    },
-                )?;
-            }
-            "DATABASE" => {
-                DatabaseDriverClient::connection_set_option_string(
-                    ConnectionSetOptionStringRequest {
-                        conn_handle: Some(conn_handle),
-                        key: "database".to_owned(),
-                        value,
-                    },
-                )?;
-            }
-            "WAREHOUSE" => {
-                DatabaseDriverClient::connection_set_option_string(
-                    ConnectionSetOptionStringRequest {
-                        conn_handle: Some(conn_handle),
-                        key: "warehouse".to_owned(),
-                        value,
-                    },
-                )?;
-            }
-            "ROLE" => {
-                DatabaseDriverClient::connection_set_option_string(
-                    ConnectionSetOptionStringRequest {
-                        conn_handle: Some(conn_handle),
-                        key: "role".to_owned(),
-                        value,
-                    },
-                )?;
-            }
-            "SCHEMA" => {
-                DatabaseDriverClient::connection_set_option_string(
-                    ConnectionSetOptionStringRequest {
-                        conn_handle: Some(conn_handle),
-                        key: "schema".to_owned(),
-                        value,
-                    },
-                )?;
-            }
-            "PRIV_KEY_FILE" => {
-                DatabaseDriverClient::connection_set_option_string(
-                    ConnectionSetOptionStringRequest {
-                        conn_handle: Some(conn_handle),
-                        key: "private_key_file".to_owned(),
-                        value,
-                    },
-                )?;
-            }
-            "AUTHENTICATOR" => {
-                DatabaseDriverClient::connection_set_option_string(
-                    ConnectionSetOptionStringRequest {
-                        conn_handle: Some(conn_handle),
-                        key: "authenticator".to_owned(),
-                        value,
-                    },
-                )?;
-            }
-            "PRIV_KEY_FILE_PWD" => {
-                DatabaseDriverClient::connection_set_option_string(
-                    ConnectionSetOptionStringRequest {
-                        conn_handle: Some(conn_handle),
-                        key: "private_key_password".to_owned(),
-                        value,
-                    },
-                )?;
-            }
-            "TOKEN" => {
-                DatabaseDriverClient::connection_set_option_string(
-                    ConnectionSetOptionStringRequest {
-                        conn_handle: Some(conn_handle),
-                        key: "token".to_owned(),
-                        value,
-                    },
-                )?;
-            }
-            "TLS_CUSTOM_ROOT_STORE_PATH" => {
-                DatabaseDriverClient::connection_set_option_string(
-                    ConnectionSetOptionStringRequest {
-                        conn_handle: Some(conn_handle),
-                        key: "custom_root_store_path".to_owned(),
-                        value,
-                    },
-                )?;
-            }
-            "TLS_VERIFY_HOSTNAME" => {
-                DatabaseDriverClient::connection_set_option_string(
-                    ConnectionSetOptionStringRequest {
-                        conn_handle: Some(conn_handle),
-                        key: "verify_hostname".to_owned(),
-                        value,
-                    },
-                )?;
-            }
-            "TLS_VERIFY_CERTIFICATES" => {
-                DatabaseDriverClient::connection_set_option_string(
-                    ConnectionSetOptionStringRequest {
-                        conn_handle: Some(conn_handle),
-                        key: "verify_certificates".to_owned(),
-                        value,
-                    },
-                )?;
-            }
+                ("port", option_value::Value::IntValue(port_int))
+            }
+            "PROTOCOL" => ("protocol", option_value::Value::StringValue(value)),
+            "DATABASE" => ("database", option_value::Value::StringValue(value)),
+            "WAREHOUSE" => ("warehouse", option_value::Value::StringValue(value)),
+            "ROLE" => ("role", option_value::Value::StringValue(value)),
+            "SCHEMA" => ("schema", option_value::Value::StringValue(value)),
+            "PRIV_KEY_FILE" => ("private_key_file", option_value::Value::StringValue(value)),
+            "AUTHENTICATOR" => ("authenticator", option_value::Value::StringValue(value)),
+            "PRIV_KEY_FILE_PWD" => (
+                "private_key_password",
+                option_value::Value::StringValue(value),
+            ),
+            "TOKEN" => ("token", option_value::Value::StringValue(value)),
+            "TLS_CUSTOM_ROOT_STORE_PATH" => (
+                "custom_root_store_path",
+                option_value::Value::StringValue(value),
+            ),
+            "TLS_VERIFY_HOSTNAME" => ("verify_hostname", option_value::Value::StringValue(value)),
+            "TLS_VERIFY_CERTIFICATES" => (
+                "verify_certificates",
+                option_value::Value::StringValue(value),
+            ),
             // CRL settings via options
-            "CRL_ENABLED" => {
-                DatabaseDriverClient::connection_set_option_string(
-                    ConnectionSetOptionStringRequest {
-                        conn_handle: Some(conn_handle),
-                        key: "crl_enabled".to_owned(),
-                        value,
-                    },
-                )?;
-            }
-            "CRL_MODE" => {
-                DatabaseDriverClient::connection_set_option_string(
-                    ConnectionSetOptionStringRequest {
-                        conn_handle: Some(conn_handle),
-                        key: "crl_mode".to_owned(),
-                        value: value.to_uppercase(),
-                    },
-                )?;
-            }
+            "CRL_ENABLED" => ("crl_enabled", option_value::Value::StringValue(value)),
+            "CRL_MODE" => (
+                "crl_mode",
+                option_value::Value::StringValue(value.to_uppercase()),
+            ),
+            // Result chunk prefetching
+            "CHUNK_PREFETCH_DEPTH" => (
+                "chunk_prefetch_depth",
+                option_value::Value::StringValue(value),
+            ),
+            "CHUNK_PREFETCH_MEMORY_BUDGET" => (
+                "chunk_prefetch_memory_budget",
+                option_value::Value::StringValue(value),
+            ),
+            // PUT multipart uploads
+            "PUT_MULTIPART_THRESHOLD" => (
+                "put_multipart_threshold",
+                option_value::Value::StringValue(value),
+            ),
+            "PUT_MULTIPART_PART_SIZE" => (
+                "put_multipart_part_size",
+                option_value::Value::StringValue(value),
+            ),
+            "PUT_MULTIPART_CONCURRENCY" => (
+                "put_multipart_concurrency",
+                option_value::Value::StringValue(value),
+            ),
             _ => {
                 tracing::warn!("driver_connect: unknown connection string key: {:?}", key);
+                continue;
             }
-        }
+        };
+        options.insert(key.to_owned(), OptionValue { value: Some(value) });
     }
 
-    DatabaseDriverClient::connection_init(ConnectionInitRequest {
+    DatabaseDriverLocalClient::connection_set_options(ConnectionSetOptionsRequest {
+        conn_handle: Some(conn_handle),
+        options,
+    })?;
+
+    DatabaseDriverLocalClient::connection_init(ConnectionInitRequest {
         conn_handle: Some(conn_handle),
         db_handle: Some(db_handle),
     })?;
@@ -1,94 +1,81 @@
 use crate::api::error::{
-    ArrowReadSnafu, DataNotFetchedSnafu, ExecutionDoneSnafu, FetchDataSnafu, NoMoreDataSnafu,
-    StatementErrorStateSnafu, StatementNotExecutedSnafu,
+    ArrowReadSnafu, DataNotFetchedSnafu, ExecutionDoneSnafu, FetchDataSnafu,
+    GetDataWithBlockCursorSnafu, InvalidColumnNumberSnafu, NoMoreDataSnafu, RowConversionSnafu,
+    StatementErrorStateSnafu, StatementNotExecutedSnafu, UnsupportedFetchOrientationSnafu,
 };
-use crate::api::{OdbcResult, StatementState, WithState, stmt_from_handle};
-use crate::cdata_types::{CDataType, Double, Real, SBigInt, UBigInt};
-use crate::read_arrow::{Buffer, ExtractError, ReadArrowValue, Value};
-use arrow::{array::Array, datatypes::Field};
+use crate::api::{
+    ColumnBinding, OdbcError, OdbcResult, StatementAttributes, StatementState, WithState,
+    stmt_from_handle,
+};
+use crate::cdata_types::CDataType;
+use crate::column_descriptors::ColumnDescriptor;
+use crate::column_kernels::BoundColumn;
+use crate::read_arrow::ExtractError;
+use arrow::array::RecordBatch;
 use odbc_sys as sql;
-use snafu::ResultExt;
+use snafu::{IntoError, ResultExt};
+use std::collections::HashMap;
+use std::ops::Range;
 use tracing;
 
-fn read_arrow_value(
-    target_type: CDataType,
-    target_value_ptr: sql::Pointer,
-    buffer_length: sql::Len,
-    str_len_or_ind_ptr: *mut sql::Len,
-    array_ref: &dyn Array,
-    field: &Field,
-    batch_idx: usize,
-) -> Result<(), ExtractError> {
-    match target_type {
-        CDataType::Char => {
-            let buffer = Buffer::new(
-                target_value_ptr as *mut sql::Char,
-                buffer_length as usize,
-                str_len_or_ind_ptr,
-            );
-            ReadArrowValue::read(buffer, array_ref, field, batch_idx)
-        }
-        CDataType::UBigInt => ReadArrowValue::read(
-            Value::new(target_value_ptr as *mut UBigInt),
-            array_ref,
-            field,
-            batch_idx,
-        ),
-        CDataType::SBigInt => ReadArrowValue::read(
-            Value::new(target_value_ptr as *mut SBigInt),
-            array_ref,
-            field,
-            batch_idx,
-        ),
-        CDataType::Long | CDataType::SLong => {
-            let sink = Value::new(target_value_ptr as *mut sql::Integer);
-            let sink = sink.contramap::<SBigInt>(|v| v as sql::Integer);
-            ReadArrowValue::read(sink, array_ref, field, batch_idx)
-        }
-        CDataType::ULong => {
-            let sink = Value::new(target_value_ptr as *mut sql::UInteger);
-            let sink = sink.contramap::<UBigInt>(|v| v as sql::UInteger);
-            ReadArrowValue::read(sink, array_ref, field, batch_idx)
-        }
-        CDataType::SShort | CDataType::Short => {
-            let sink = Value::new(target_value_ptr as *mut sql::SmallInt);
-            let sink = sink.contramap::<SBigInt>(|v| v as sql::SmallInt);
-            ReadArrowValue::read(sink, array_ref, field, batch_idx)
-        }
-        CDataType::UShort => {
-            let sink = Value::new(target_value_ptr as *mut sql::USmallInt);
-            let sink = sink.contramap::<UBigInt>(|v| v as sql::USmallInt);
-            ReadArrowValue::read(sink, array_ref, field, batch_idx)
-        }
-        CDataType::STinyInt | CDataType::TinyInt => {
-            let sink = Value::new(target_value_ptr as *mut sql::SChar);
-            let sink = sink.contramap::<SBigInt>(|v| v as sql::SChar);
-            ReadArrowValue::read(sink, array_ref, field, batch_idx)
-        }
-        CDataType::UTinyInt => {
-            let sink = Value::new(target_value_ptr as *mut sql::Char);
-            let sink = sink.contramap::<UBigInt>(|v| v as sql::Char);
-            ReadArrowValue::read(sink, array_ref, field, batch_idx)
-        }
-        CDataType::Float => {
-            let sink = Value::new(target_value_ptr as *mut Real);
-            let sink = sink.contramap::<Double>(|v| v as Real);
-            ReadArrowValue::read(sink, array_ref, field, batch_idx)
-        }
-        CDataType::Double => {
-            let sink = Value::new(target_value_ptr as *mut Double);
-            ReadArrowValue::read(sink, array_ref, field, batch_idx)
-        }
-        _ => Err(ExtractError::UnsupportedTargetType(target_type)),
-    }
+const SQL_FETCH_NEXT: sql::SmallInt = 1;
+const SQL_ROW_SUCCESS: sql::USmallInt = 0;
+const SQL_ROW_NOROW: sql::USmallInt = 3;
+const SQL_ROW_ERROR: sql::USmallInt = 5;
+
+/// Select conversion kernels for the bound columns of the current result set
+fn resolve_bound_columns(
+    bindings: &HashMap<u16, ColumnBinding>,
+    columns: &[ColumnDescriptor],
+) -> OdbcResult<Vec<BoundColumn>> {
+    bindings
+        .iter()
+        .map(|(&column_number, binding)| {
+            let column_idx = (column_number - 1) as usize;
+            let descriptor = columns.get(column_idx).ok_or_else(|| {
+                InvalidColumnNumberSnafu {
+                    number: column_number,
+                }
+                .build()
+            })?;
+            BoundColumn::new(column_idx, binding.clone(), descriptor).context(ArrowReadSnafu)
+        })
+        .collect()
 }
 
-/// Fetch the next row of data
-pub fn fetch(statement_handle: sql::Handle) -> OdbcResult<()> {
-    tracing::debug!("fetch called");
-    let stmt = stmt_from_handle(statement_handle);
-    stmt.state.transition_or_err(|state| match state {
-        StatementState::Executed { mut reader, .. } => match reader.next() {
+/// Move the cursor one row forward, pulling the next non-empty batch when needed
+fn next_row(state: StatementState) -> Result<StatementState, (StatementState, OdbcError)> {
+    let mut reader = match state {
+        StatementState::Executed { reader, .. } => reader,
+        StatementState::Fetching {
+            reader,
+            record_batch,
+            batch_idx,
+        } => {
+            if batch_idx + 1 < record_batch.num_rows() {
+                return Ok(StatementState::Fetching {
+                    reader,
+                    record_batch,
+                    batch_idx: batch_idx + 1,
+                });
+            }
+            reader
+        }
+        state @ StatementState::Error => {
+            tracing::error!("fetch: statement error");
+            return StatementErrorStateSnafu.fail().with_state(state);
+        }
+        state @ StatementState::Done => {
+            tracing::debug!("fetch: statement execution is done");
+            return NoMoreDataSnafu.fail().with_state(state);
+        }
+        state @ StatementState::Created => {
+            tracing::error!("fetch: statement not executed");
+            return StatementNotExecutedSnafu.fail().with_state(state);
+        }
+    };
+    loop {
+        match reader.next() {
             Some(record_batch_result) => {
                 let record_batch = record_batch_result
                     .context(FetchDataSnafu)
@@ -97,66 +84,216 @@ pub fn fetch(statement_handle: sql::Handle) -> OdbcResult<()> {
                     "fetch: fetched record_batch with {} rows",
                     record_batch.num_rows()
                 );
-                let next_state = StatementState::Fetching {
+                if record_batch.num_rows() == 0 {
+                    continue;
+                }
+                return Ok(StatementState::Fetching {
                     reader,
                     record_batch,
                     batch_idx: 0,
-                };
-                Ok((next_state, ()))
+                });
             }
             None => {
                 tracing::debug!("fetch: no more data available");
-                NoMoreDataSnafu.fail().with_state(StatementState::Done)
+                return NoMoreDataSnafu.fail().with_state(StatementState::Done);
             }
-        },
-        StatementState::Fetching {
-            mut reader,
-            record_batch,
-            batch_idx,
-        } => {
-            let new_batch_idx = batch_idx + 1;
-            if new_batch_idx < record_batch.num_rows() {
-                Ok((
-                    StatementState::Fetching {
+        }
+    }
+}
+
+/// Converts `rows` of the batch for every bound column. On failure, returns
+/// how many rows all columns converted and the error of the row after them.
+fn convert_run(
+    bound_columns: &[BoundColumn],
+    record_batch: &RecordBatch,
+    rows: Range<usize>,
+    first_slot: usize,
+    row_bind_type: usize,
+) -> Result<(), (usize, ExtractError)> {
+    let mut converted = rows.len();
+    let mut failure = None;
+    for column in bound_columns {
+        // Only the rows every earlier column managed still need converting
+        let rows = rows.start..rows.start + converted;
+        if let Err(e) = column.convert(record_batch, rows, first_slot, row_bind_type) {
+            converted = e.rows_converted;
+            failure = Some(e.source);
+        }
+    }
+    match failure {
+        Some(source) => Err((converted, source)),
+        None => Ok(()),
+    }
+}
+
+/// Fetch up to `row_array_size` rows, converting each bound column one batch slice at a time.
+///
+/// When a cell of a multi-row rowset fails to convert, the rowset ends at its
+/// row: the rows before it are returned and the error reports its position.
+fn fetch_rowset(
+    state: StatementState,
+    bound_columns: &[BoundColumn],
+    attributes: &StatementAttributes,
+) -> Result<(StatementState, usize), (StatementState, OdbcError)> {
+    let mut state = next_row(state)?;
+    let mut rows_fetched = 0;
+    loop {
+        state = match state {
+            StatementState::Fetching {
+                reader,
+                record_batch,
+                batch_idx,
+            } => {
+                let run = (attributes.row_array_size - rows_fetched)
+                    .min(record_batch.num_rows() - batch_idx);
+                let converted = convert_run(
+                    bound_columns,
+                    &record_batch,
+                    batch_idx..batch_idx + run,
+                    rows_fetched,
+                    attributes.row_bind_type,
+                );
+                if let Err((converted, source)) = converted {
+                    // Leave the cursor on the failing row, the next fetch resumes after it
+                    let state = StatementState::Fetching {
                         reader,
                         record_batch,
-                        batch_idx: new_batch_idx,
-                    },
-                    (),
-                ))
-            } else {
-                match reader.next() {
-                    Some(new_record_batch_result) => {
-                        let new_record_batch = new_record_batch_result
-                            .context(FetchDataSnafu)
-                            .with_state(StatementState::Error)?;
-                        let next_state = StatementState::Fetching {
-                            reader,
-                            record_batch: new_record_batch,
-                            batch_idx: 0,
-                        };
-                        Ok((next_state, ()))
-                    }
-                    None => {
-                        tracing::debug!("fetch: no more data available");
-                        NoMoreDataSnafu.fail().with_state(StatementState::Done)
-                    }
+                        batch_idx: batch_idx + converted,
+                    };
+                    let error = if attributes.row_array_size == 1 {
+                        ArrowReadSnafu.into_error(source)
+                    } else {
+                        RowConversionSnafu {
+                            row: rows_fetched + converted + 1,
+                        }
+                        .into_error(source)
+                    };
+                    return Err((state, error));
+                }
+                rows_fetched += run;
+                // Leave the cursor on the last row of the rowset taken from this batch
+                StatementState::Fetching {
+                    reader,
+                    record_batch,
+                    batch_idx: batch_idx + run - 1,
                 }
             }
+            other => other,
+        };
+        if rows_fetched >= attributes.row_array_size {
+            break;
         }
-        state @ StatementState::Error => {
-            tracing::error!("fetch: statement error");
-            StatementErrorStateSnafu.fail().with_state(state)
+        // A short rowset is only returned at the end of the result set
+        match next_row(state) {
+            Ok(next_state) => state = next_state,
+            Err((done @ StatementState::Done, _)) => {
+                state = done;
+                break;
+            }
+            Err(e) => return Err(e),
         }
-        state @ StatementState::Done => {
-            tracing::debug!("fetch: statement execution is done");
-            ExecutionDoneSnafu.fail().with_state(state)
+    }
+    Ok((state, rows_fetched))
+}
+
+/// Reports the rows of the rowset, the last one failed when `last_row_failed`.
+fn report_rowset(attributes: &StatementAttributes, rows_fetched: usize, last_row_failed: bool) {
+    if !attributes.rows_fetched_ptr.is_null() {
+        unsafe { std::ptr::write(attributes.rows_fetched_ptr, rows_fetched as sql::ULen) };
+    }
+    if !attributes.row_status_ptr.is_null() {
+        for i in 0..attributes.row_array_size {
+            let status = if last_row_failed && i + 1 == rows_fetched {
+                SQL_ROW_ERROR
+            } else if i < rows_fetched {
+                SQL_ROW_SUCCESS
+            } else {
+                SQL_ROW_NOROW
+            };
+            unsafe { std::ptr::write(attributes.row_status_ptr.add(i), status) };
         }
-        state @ StatementState::Created => {
-            tracing::error!("fetch: statement not executed");
-            StatementNotExecutedSnafu.fail().with_state(state)
+    }
+}
+
+/// Fetch the next rowset of data
+pub fn fetch(statement_handle: sql::Handle) -> OdbcResult<()> {
+    tracing::debug!("fetch called");
+    let stmt = stmt_from_handle(statement_handle);
+    let has_result = matches!(
+        stmt.state.as_ref(),
+        StatementState::Executed { .. } | StatementState::Fetching { .. }
+    );
+    if stmt.bound_columns.is_none() && has_result {
+        stmt.bound_columns = Some(resolve_bound_columns(&stmt.column_bindings, &stmt.columns)?);
+    }
+    let attributes = stmt.attributes;
+    let bound_columns = stmt.bound_columns.as_deref().unwrap_or_default();
+    let result = stmt
+        .state
+        .transition_or_err(|state| fetch_rowset(state, bound_columns, &attributes));
+    match &result {
+        Ok(rows_fetched) => report_rowset(&attributes, *rows_fetched, false),
+        Err(OdbcError::RowConversion { row, .. }) => report_rowset(&attributes, *row, true),
+        Err(OdbcError::NoMoreData { .. }) => report_rowset(&attributes, 0, false),
+        Err(_) => {}
+    }
+    result.map(|_| ())
+}
+
+/// Fetch a rowset in the given direction, only `SQL_FETCH_NEXT` is supported
+pub fn fetch_scroll(
+    statement_handle: sql::Handle,
+    fetch_orientation: sql::SmallInt,
+    _fetch_offset: sql::Len,
+) -> OdbcResult<()> {
+    tracing::debug!("fetch_scroll: fetch_orientation={}", fetch_orientation);
+    if fetch_orientation != SQL_FETCH_NEXT {
+        return UnsupportedFetchOrientationSnafu {
+            orientation: fetch_orientation,
+        }
+        .fail();
+    }
+    fetch(statement_handle)
+}
+
+/// Bind an application buffer to a result column, a null buffer unbinds it
+pub fn bind_col(
+    statement_handle: sql::Handle,
+    column_number: sql::USmallInt,
+    target_type: CDataType,
+    target_value_ptr: sql::Pointer,
+    buffer_length: sql::Len,
+    str_len_or_ind_ptr: *mut sql::Len,
+) -> OdbcResult<()> {
+    tracing::debug!(
+        "bind_col: column_number={}, target_type={:?}",
+        column_number,
+        target_type
+    );
+    if column_number == 0 {
+        tracing::error!("bind_col: bookmark columns are not supported");
+        return InvalidColumnNumberSnafu {
+            number: column_number,
         }
-    })
+        .fail();
+    }
+
+    let stmt = stmt_from_handle(statement_handle);
+    stmt.bound_columns = None;
+    if target_value_ptr.is_null() {
+        stmt.column_bindings.remove(&column_number);
+        return Ok(());
+    }
+    stmt.column_bindings.insert(
+        column_number,
+        ColumnBinding {
+            target_type,
+            target_value_ptr,
+            buffer_length,
+            str_len_or_ind_ptr,
+        },
+    );
+    Ok(())
 }
 
 /// Get data from a specific column
@@ -170,26 +307,36 @@ pub fn get_data(
 ) -> OdbcResult<()> {
     tracing::debug!("get_data: statement_handle={:?}", statement_handle);
     let stmt = stmt_from_handle(statement_handle);
+    if stmt.attributes.row_array_size > 1 {
+        tracing::error!("get_data: block cursors require SQLSetPos, which is not supported");
+        return GetDataWithBlockCursorSnafu.fail();
+    }
     match stmt.state.as_ref() {
         StatementState::Fetching {
             reader: _,
             record_batch,
             batch_idx,
         } => {
-            let array_ref = record_batch.column((col_or_param_num - 1) as usize);
-            let schema = record_batch.schema();
-            let field = schema.field((col_or_param_num - 1) as usize);
-
-            read_arrow_value(
+            let column_idx = (col_or_param_num as usize).wrapping_sub(1);
+            let descriptor = stmt.columns.get(column_idx).ok_or_else(|| {
+                InvalidColumnNumberSnafu {
+                    number: col_or_param_num,
+                }
+                .build()
+            })?;
+            let binding = ColumnBinding {
                 target_type,
                 target_value_ptr,
                 buffer_length,
                 str_len_or_ind_ptr,
-                array_ref,
-                field,
-                *batch_idx,
-            )
-            .context(ArrowReadSnafu)?;
+            };
+            BoundColumn::new(column_idx, binding, descriptor)
+                .and_then(|column| {
+                    column
+                        .convert(record_batch, *batch_idx..*batch_idx + 1, 0, 0)
+                        .map_err(|e| e.source)
+                })
+                .context(ArrowReadSnafu)?;
 
             Ok(())
         }
@@ -211,3 +358,115 @@ pub fn get_data(
         }
     }
 }
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::api::ToSqlReturn;
+    use crate::cdata_types::SBigInt;
+    use crate::column_kernels::{ColumnTarget, KernelError};
+    use crate::read_arrow::FieldMeta;
+    use arrow::array::{Array, Int64Array, RecordBatchIterator};
+    use arrow::datatypes::{DataType, Field, Schema};
+    use arrow::ffi_stream::{ArrowArrayStreamReader, FFI_ArrowArrayStream};
+    use std::sync::Arc;
+
+    fn executed(field: &Field, values: Vec<i64>) -> StatementState {
+        let schema = Arc::new(Schema::new(vec![field.clone()]));
+        let batch =
+            RecordBatch::try_new(schema.clone(), vec![Arc::new(Int64Array::from(values))]).unwrap();
+        let stream =
+            FFI_ArrowArrayStream::new(Box::new(RecordBatchIterator::new(vec![Ok(batch)], schema)));
+        StatementState::Executed {
+            reader: ArrowArrayStreamReader::try_new(stream).unwrap(),
+            rows_affected: 0,
+        }
+    }
+
+    /// Fails on the row holding 3, converting nothing
+    fn fail_on_three(
+        _target: &ColumnTarget,
+        array: &dyn Array,
+        _meta: &FieldMeta,
+        rows: Range<usize>,
+        _first_slot: usize,
+    ) -> Result<(), KernelError> {
+        let array = array.as_any().downcast_ref::<Int64Array>().unwrap();
+        match rows.clone().position(|row| array.value(row) == 3) {
+            Some(rows_converted) => Err(KernelError {
+                rows_converted,
+                source: ExtractError::ConversionError("3".to_string()),
+            }),
+            None => Ok(()),
+        }
+    }
+
+    #[test]
+    fn conversion_failure_ends_the_rowset_at_the_failing_row() {
+        let field = Field::new("ID", DataType::Int64, true).with_metadata(HashMap::from([
+            ("logicalType".to_string(), "FIXED".to_string()),
+            ("scale".to_string(), "0".to_string()),
+            ("precision".to_string(), "38".to_string()),
+        ]));
+        let mut ids = [0 as SBigInt; 4];
+        let mut status = [SQL_ROW_NOROW; 4];
+        let mut rows_fetched = 0 as sql::ULen;
+        let binding = |target_value_ptr| ColumnBinding {
+            target_type: CDataType::SBigInt,
+            target_value_ptr,
+            buffer_length: 0,
+            str_len_or_ind_ptr: std::ptr::null_mut(),
+        };
+        let bound_columns = [
+            BoundColumn::new(
+                0,
+                binding(ids.as_mut_ptr() as sql::Pointer),
+                &ColumnDescriptor::new(&field),
+            )
+            .unwrap(),
+            BoundColumn::with_kernel(0, binding(std::ptr::null_mut()), fail_on_three),
+        ];
+        let attributes = StatementAttributes {
+            row_array_size: 4,
+            rows_fetched_ptr: &mut rows_fetched,
+            row_status_ptr: status.as_mut_ptr(),
+            ..Default::default()
+        };
+
+        let (state, error) = fetch_rowset(
+            executed(&field, (0..6).collect()),
+            &bound_columns,
+            &attributes,
+        )
+        .err()
+        .unwrap();
+        let row = match &error {
+            OdbcError::RowConversion { row, .. } => *row,
+            _ => panic!("expected a row conversion error, got {error:?}"),
+        };
+        assert_eq!(row, 4);
+        assert_eq!(ids[..3], [0, 1, 2]);
+        report_rowset(&attributes, row, true);
+        assert_eq!(rows_fetched, 4);
+        assert_eq!(
+            status,
+            [
+                SQL_ROW_SUCCESS,
+                SQL_ROW_SUCCESS,
+                SQL_ROW_SUCCESS,
+                SQL_ROW_ERROR
+            ]
+        );
+        assert_eq!(
+            Err::<(), _>(error).to_sql_return(),
+            sql::SqlReturn::SUCCESS_WITH_INFO
+        );
+
+        // The next rowset resumes after the failing row
+        let (_, fetched) = fetch_rowset(state, &bound_columns, &attributes)
+            .ok()
+            .unwrap();
+        assert_eq!(fetched, 2);
+        assert_eq!(ids[..2], [4, 5]);
+    }
+}
@@ -54,6 +54,52 @@ pub enum OdbcError {
         location: Location,
     },
 
+    #[snafu(display("Invalid value {value} for attribute {attribute}"))]
+    InvalidAttributeValue {
+        attribute: i32,
+        value: usize,
+        #[snafu(implicit)]
+        location: Location,
+    },
+
+    #[snafu(display("Invalid column number: {number}"))]
+    InvalidColumnNumber {
+        number: sql::USmallInt,
+        #[snafu(implicit)]
+        location: Location,
+    },
+
+    #[snafu(display("Column attribute {identifier} is not supported"))]
+    UnsupportedColumnAttribute {
+        identifier: sql::USmallInt,
+        #[snafu(implicit)]
+        location: Location,
+    },
+
+    /// Warning returned after every output was written, one string cut short.
+    #[snafu(display(
+        "String data, right truncated: {length} bytes in a buffer of {buffer_length}"
+    ))]
+    StringTruncated {
+        length: usize,
+        buffer_length: sql::Len,
+        #[snafu(implicit)]
+        location: Location,
+    },
+
+    #[snafu(display("Fetch orientation {orientation} is not supported"))]
+    UnsupportedFetchOrientation {
+        orientation: sql::SmallInt,
+        #[snafu(implicit)]
+        location: Location,
+    },
+
+    #[snafu(display("SQLGetData is not supported when the rowset size is greater than 1"))]
+    GetDataWithBlockCursor {
+        #[snafu(implicit)]
+        location: Location,
+    },
+
     #[snafu(display("Parameter number cannot be 0"))]
     InvalidParameterNumber {
         #[snafu(implicit)]
@@ -66,6 +112,12 @@ pub enum OdbcError {
         location: Location,
     },
 
+    #[snafu(display("Statement not prepared"))]
+    StatementNotPrepared {
+        #[snafu(implicit)]
+        location: Location,
+    },
+
     #[snafu(display("Statement is in error state"))]
     StatementErrorState {
         #[snafu(implicit)]
@@ -140,6 +192,15 @@ pub enum OdbcError {
         location: Location,
     },
 
+    /// Ends a multi-row rowset early, the rows before `row` were fetched.
+    #[snafu(display("Error reading arrow value of rowset row {row}: {source:?}"))]
+    RowConversion {
+        row: usize,
+        source: ExtractError,
+        #[snafu(implicit)]
+        location: Location,
+    },
+
     #[snafu(display("Error binding arrow parameters: {source:?}"))]
     ArrowBinding {
         source: ArrowBindingError,
@@ -174,6 +235,13 @@ pub enum OdbcError {
         location: Location,
     },
 
+    #[snafu(display("Error importing arrow schema: {source}"))]
+    ArrowSchemaImport {
+        source: ArrowError,
+        #[snafu(implicit)]
+        location: Location,
+    },
+
     #[snafu(display("Error while creating arrow array stream reader: {source}"))]
     ArrowArrayStreamReaderCreation {
         source: ArrowError,
@@ -240,6 +308,10 @@ impl OdbcError {
             message_text: self.to_string(),
             sql_state: self.to_sql_state(),
             native_error: self.to_native_error(),
+            row_number: match self {
+                OdbcError::RowConversion { row, .. } => Some(*row as sql::Integer),
+                _ => None,
+            },
             ..Default::default()
         }
     }
@@ -253,8 +325,17 @@ impl OdbcError {
                 SqlState::InvalidDescriptorFieldIdentifier
             }
             OdbcError::UnknownAttribute { .. } => SqlState::GeneralError,
+            OdbcError::InvalidAttributeValue { .. } => SqlState::InvalidAttributeValue,
+            OdbcError::InvalidColumnNumber { .. } => SqlState::InvalidDescriptorIndex,
+            OdbcError::UnsupportedColumnAttribute { .. } => {
+                SqlState::InvalidDescriptorFieldIdentifier
+            }
+            OdbcError::StringTruncated { .. } => SqlState::StringDataRightTruncated,
+            OdbcError::UnsupportedFetchOrientation { .. } => SqlState::FetchTypeOutOfRange,
+            OdbcError::GetDataWithBlockCursor { .. } => SqlState::InvalidCursorPosition,
             OdbcError::InvalidParameterNumber { .. } => SqlState::WrongNumberOfParameters,
             OdbcError::StatementNotExecuted { .. } => SqlState::FunctionSequenceError,
+            OdbcError::StatementNotPrepared { .. } => SqlState::FunctionSequenceError,
             OdbcError::DataNotFetched { .. } => SqlState::FunctionSequenceError,
             OdbcError::ExecutionDone { .. } => SqlState::FunctionSequenceError,
             OdbcError::NoMoreData { .. } => SqlState::NoDataFound,
@@ -265,6 +346,7 @@ impl OdbcError {
             OdbcError::BindParameters { .. } => SqlState::WrongNumberOfParameters,
             OdbcError::ConnectionInit { .. } => SqlState::ClientUnableToEstablishConnection,
             OdbcError::ArrowRead { .. } => SqlState::GeneralError,
+            OdbcError::RowConversion { .. } => SqlState::GeneralError,
             OdbcError::ParameterBinding { .. } => SqlState::WrongNumberOfParameters,
             OdbcError::FetchData { .. } => SqlState::GeneralError,
             OdbcError::TextConversionUtf8 { .. } => SqlState::StringDataRightTruncated,
@@ -295,6 +377,7 @@ impl OdbcError {
             OdbcError::ProtoTransport { .. } => SqlState::ClientUnableToEstablishConnection,
             OdbcError::ProtoRequiredFieldMissing { .. } => SqlState::GeneralError,
             OdbcError::ArrowArrayStreamReaderCreation { .. } => SqlState::GeneralError,
+            OdbcError::ArrowSchemaImport { .. } => SqlState::GeneralError,
             OdbcError::StatementErrorState { .. } => SqlState::GeneralError,
         }
     }
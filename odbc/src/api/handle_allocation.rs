@@ -1,11 +1,11 @@
 use crate::api::{
-    Connection, ConnectionState, Environment, OdbcResult, Statement, StatementState,
-    conn_from_handle,
+    Connection, ConnectionState, Environment, OdbcResult, Statement, StatementAttributes,
+    StatementState, conn_from_handle,
     diagnostic::DiagnosticInfo,
     error::{DisconnectedSnafu, InvalidHandleSnafu, Required},
 };
 use odbc_sys as sql;
-use sf_core::protobuf_apis::database_driver_v1::DatabaseDriverClient;
+use sf_core::protobuf_apis::database_driver_v1::DatabaseDriverLocalClient;
 use sf_core::protobuf_gen::database_driver_v1::StatementNewRequest;
 use tracing;
 
@@ -38,7 +38,7 @@ pub fn alloc_statement(input_handle: sql::Handle) -> OdbcResult<*mut Statement<'
             db_handle: _,
             conn_handle,
         } => {
-            let response = DatabaseDriverClient::statement_new(StatementNewRequest {
+            let response = DatabaseDriverLocalClient::statement_new(StatementNewRequest {
                 conn_handle: Some(*conn_handle),
             })?;
             let stmt_handle = response
@@ -50,6 +50,11 @@ pub fn alloc_statement(input_handle: sql::Handle) -> OdbcResult<*mut Statement<'
                 stmt_handle,
                 state: StatementState::Created.into(),
                 parameter_bindings: std::collections::HashMap::new(),
+                columns: Vec::new(),
+                parameters: None,
+                column_bindings: std::collections::HashMap::new(),
+                bound_columns: None,
+                attributes: StatementAttributes::default(),
                 diagnostic_info: DiagnosticInfo::default(),
             });
             Ok(Box::into_raw(stmt))
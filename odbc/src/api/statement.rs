@@ -1,15 +1,21 @@
 use crate::api::api_utils::cstr_to_string;
 use crate::api::error::{
-    ArrowArrayStreamReaderCreationSnafu, ArrowBindingSnafu, DisconnectedSnafu,
-    InvalidParameterNumberSnafu, Required,
+    ArrowArrayStreamReaderCreationSnafu, ArrowBindingSnafu, ArrowSchemaImportSnafu,
+    DisconnectedSnafu, InvalidAttributeValueSnafu, InvalidParameterNumberSnafu, Required,
+    UnknownAttributeSnafu,
+};
+use crate::api::{
+    ConnectionState, OdbcResult, ParameterBinding, Statement, StatementState, stmt_from_handle,
 };
-use crate::api::{ConnectionState, OdbcResult, ParameterBinding, StatementState, stmt_from_handle};
 use crate::cdata_types::CDataType;
+use crate::column_descriptors::describe_columns;
 use crate::write_arrow::odbc_bindings_to_arrow_bindings;
+use arrow::datatypes::Schema;
 use arrow::ffi::{FFI_ArrowArray, FFI_ArrowSchema};
 use arrow::ffi_stream::{ArrowArrayStreamReader, FFI_ArrowArrayStream};
+use arrow::record_batch::RecordBatchReader;
 use odbc_sys as sql;
-use sf_core::protobuf_apis::database_driver_v1::DatabaseDriverClient;
+use sf_core::protobuf_apis::database_driver_v1::DatabaseDriverLocalClient;
 use sf_core::protobuf_gen::database_driver_v1::{
     ArrowArrayPtr, ArrowSchemaPtr, StatementBindRequest, StatementExecuteQueryRequest,
     StatementExecuteQueryResponse, StatementPrepareRequest, StatementSetSqlQueryRequest,
@@ -49,17 +55,21 @@ pub fn exec_direct(
         } => {
             let query = cstr_to_string(statement_text, text_length)?;
 
-            DatabaseDriverClient::statement_set_sql_query(StatementSetSqlQueryRequest {
+            DatabaseDriverLocalClient::statement_set_sql_query(StatementSetSqlQueryRequest {
                 stmt_handle: Some(stmt.stmt_handle),
                 query,
             })?;
+            stmt.parameters = None;
 
             let response =
-                DatabaseDriverClient::statement_execute_query(StatementExecuteQueryRequest {
+                DatabaseDriverLocalClient::statement_execute_query(StatementExecuteQueryRequest {
                     stmt_handle: Some(stmt.stmt_handle),
                 })?;
 
-            stmt.state = create_execute_state(response)?.into();
+            set_execute_result(stmt, response)?;
+            // No parameters are sent with SQLExecDirect, so the statement it
+            // ran has none and SQLNumParams reports 0
+            stmt.parameters = Some(Vec::new());
             Ok(())
         }
         ConnectionState::Disconnected => {
@@ -87,15 +97,22 @@ pub fn prepare(
             tracing::debug!("prepare: query = {}", query);
 
             // Set the SQL query for the statement
-            DatabaseDriverClient::statement_set_sql_query(StatementSetSqlQueryRequest {
+            DatabaseDriverLocalClient::statement_set_sql_query(StatementSetSqlQueryRequest {
                 stmt_handle: Some(stmt.stmt_handle),
                 query,
             })?;
+            stmt.parameters = None;
 
-            // Call the prepare method on the statement
-            DatabaseDriverClient::statement_prepare(StatementPrepareRequest {
+            // Describe the statement once, so SQLDescribeCol and SQLNumParams
+            // are answered locally and SQLExecute does not describe again
+            let response = DatabaseDriverLocalClient::statement_prepare(StatementPrepareRequest {
                 stmt_handle: Some(stmt.stmt_handle),
             })?;
+            let result_schema = import_schema(response.result_schema)?;
+            let parameter_schema = import_schema(response.parameter_schema)?;
+            stmt.columns = describe_columns(&result_schema);
+            stmt.parameters = Some(describe_columns(&parameter_schema));
+            stmt.bound_columns = None;
 
             tracing::info!("prepare: Successfully prepared statement");
             Ok(())
@@ -117,18 +134,27 @@ pub fn execute(statement_handle: sql::Handle) -> OdbcResult<()> {
             db_handle: _,
             conn_handle: _,
         } => {
+            let params_processed_ptr = stmt.attributes.params_processed_ptr;
+            write_params_processed(params_processed_ptr, 0);
+
             // If there are bound parameters, we should bind them to the statement
             if !stmt.parameter_bindings.is_empty() {
                 tracing::info!(
-                    "execute: Found {} bound parameters",
-                    stmt.parameter_bindings.len()
+                    "execute: Found {} bound parameters in {} parameter sets",
+                    stmt.parameter_bindings.len(),
+                    stmt.attributes.paramset_size
                 );
 
-                let (schema, array) = odbc_bindings_to_arrow_bindings(&stmt.parameter_bindings)
-                    .context(ArrowBindingSnafu {})?;
+                // All parameter sets go to the server as one array binding
+                let (schema, array) = odbc_bindings_to_arrow_bindings(
+                    &stmt.parameter_bindings,
+                    stmt.attributes.paramset_size,
+                    stmt.attributes.param_bind_type,
+                )
+                .context(ArrowBindingSnafu {})?;
 
                 // Bind parameters to statement
-                DatabaseDriverClient::statement_bind(StatementBindRequest {
+                DatabaseDriverLocalClient::statement_bind(StatementBindRequest {
                     stmt_handle: Some(stmt.stmt_handle),
                     schema: Some(protobuf_from_ffi_arrow_schema(Box::into_raw(schema))),
                     array: Some(protobuf_from_ffi_arrow_array(Box::into_raw(array))),
@@ -139,12 +165,15 @@ pub fn execute(statement_handle: sql::Handle) -> OdbcResult<()> {
 
             // Execute the prepared statement
             let response =
-                DatabaseDriverClient::statement_execute_query(StatementExecuteQueryRequest {
+                DatabaseDriverLocalClient::statement_execute_query(StatementExecuteQueryRequest {
                     stmt_handle: Some(stmt.stmt_handle),
                 })?;
 
             tracing::info!("execute: Successfully executed statement");
-            stmt.state = create_execute_state(response)?.into();
+            set_execute_result(stmt, response)?;
+            if !stmt.parameter_bindings.is_empty() {
+                write_params_processed(params_processed_ptr, stmt.attributes.paramset_size);
+            }
             Ok(())
         }
         ConnectionState::Disconnected => {
@@ -154,6 +183,32 @@ pub fn execute(statement_handle: sql::Handle) -> OdbcResult<()> {
     }
 }
 
+fn write_params_processed(params_processed_ptr: *mut sql::ULen, count: usize) {
+    if !params_processed_ptr.is_null() {
+        unsafe { std::ptr::write(params_processed_ptr, count as sql::ULen) };
+    }
+}
+
+fn set_execute_result(
+    stmt: &mut Statement,
+    response: StatementExecuteQueryResponse,
+) -> OdbcResult<()> {
+    let state = create_execute_state(response)?;
+    stmt.columns = match &state {
+        StatementState::Executed { reader, .. } => describe_columns(&reader.schema()),
+        _ => Vec::new(),
+    };
+    stmt.state = state.into();
+    stmt.bound_columns = None;
+    Ok(())
+}
+
+fn import_schema(schema: Option<ArrowSchemaPtr>) -> OdbcResult<Schema> {
+    let schema_ptr: *mut FFI_ArrowSchema = schema.required("Schema is required")?.into();
+    let schema = unsafe { FFI_ArrowSchema::from_raw(schema_ptr) };
+    Schema::try_from(&schema).context(ArrowSchemaImportSnafu {})
+}
+
 fn create_execute_state(response: StatementExecuteQueryResponse) -> OdbcResult<StatementState> {
     let result = response.result.required("Execute result is required")?;
     let stream_ptr: *mut FFI_ArrowArrayStream =
@@ -215,3 +270,139 @@ pub fn bind_parameter(
     );
     Ok(())
 }
+
+fn to_stmt_attr(attribute: i32) -> Option<sql::StatementAttribute> {
+    match attribute {
+        5 => Some(sql::StatementAttribute::RowBindType),
+        18 => Some(sql::StatementAttribute::ParamBindType),
+        21 => Some(sql::StatementAttribute::ParamsProcessedPtr),
+        22 => Some(sql::StatementAttribute::ParamsetSize),
+        25 => Some(sql::StatementAttribute::RowStatusPtr),
+        26 => Some(sql::StatementAttribute::RowsFetchedPtr),
+        27 => Some(sql::StatementAttribute::RowArraySize),
+        _ => None,
+    }
+}
+
+/// Set a statement attribute
+pub fn set_stmt_attr(
+    statement_handle: sql::Handle,
+    attribute: sql::Integer,
+    value: sql::Pointer,
+) -> OdbcResult<()> {
+    tracing::debug!("set_stmt_attr: attribute={}", attribute);
+    let stmt = stmt_from_handle(statement_handle);
+    let attr = to_stmt_attr(attribute).ok_or(UnknownAttributeSnafu { attribute }.build())?;
+
+    match attr {
+        sql::StatementAttribute::RowArraySize => {
+            let row_array_size = value as usize;
+            if row_array_size == 0 {
+                return InvalidAttributeValueSnafu {
+                    attribute,
+                    value: row_array_size,
+                }
+                .fail();
+            }
+            stmt.attributes.row_array_size = row_array_size;
+            Ok(())
+        }
+        sql::StatementAttribute::RowBindType => {
+            stmt.attributes.row_bind_type = value as usize;
+            Ok(())
+        }
+        sql::StatementAttribute::RowsFetchedPtr => {
+            stmt.attributes.rows_fetched_ptr = value as *mut sql::ULen;
+            Ok(())
+        }
+        sql::StatementAttribute::RowStatusPtr => {
+            stmt.attributes.row_status_ptr = value as *mut sql::USmallInt;
+            Ok(())
+        }
+        sql::StatementAttribute::ParamsetSize => {
+            let paramset_size = value as usize;
+            if paramset_size == 0 {
+                return InvalidAttributeValueSnafu {
+                    attribute,
+                    value: paramset_size,
+                }
+                .fail();
+            }
+            stmt.attributes.paramset_size = paramset_size;
+            Ok(())
+        }
+        sql::StatementAttribute::ParamBindType => {
+            stmt.attributes.param_bind_type = value as usize;
+            Ok(())
+        }
+        sql::StatementAttribute::ParamsProcessedPtr => {
+            stmt.attributes.params_processed_ptr = value as *mut sql::ULen;
+            Ok(())
+        }
+        _ => {
+            tracing::error!("Unhandled statement attribute: {:?}", attribute);
+            UnknownAttributeSnafu { attribute }.fail()
+        }
+    }
+}
+
+/// Get a statement attribute
+pub fn get_stmt_attr(
+    statement_handle: sql::Handle,
+    attribute: sql::Integer,
+    value: sql::Pointer,
+) -> OdbcResult<()> {
+    tracing::debug!("get_stmt_attr: attribute={}", attribute);
+    let stmt = stmt_from_handle(statement_handle);
+    let attr = to_stmt_attr(attribute).ok_or(UnknownAttributeSnafu { attribute }.build())?;
+
+    match attr {
+        sql::StatementAttribute::RowArraySize => unsafe {
+            std::ptr::write(
+                value as *mut sql::ULen,
+                stmt.attributes.row_array_size as sql::ULen,
+            );
+        },
+        sql::StatementAttribute::RowBindType => unsafe {
+            std::ptr::write(
+                value as *mut sql::ULen,
+                stmt.attributes.row_bind_type as sql::ULen,
+            );
+        },
+        sql::StatementAttribute::RowsFetchedPtr => unsafe {
+            std::ptr::write(
+                value as *mut *mut sql::ULen,
+                stmt.attributes.rows_fetched_ptr,
+            );
+        },
+        sql::StatementAttribute::RowStatusPtr => unsafe {
+            std::ptr::write(
+                value as *mut *mut sql::USmallInt,
+                stmt.attributes.row_status_ptr,
+            );
+        },
+        sql::StatementAttribute::ParamsetSize => unsafe {
+            std::ptr::write(
+                value as *mut sql::ULen,
+                stmt.attributes.paramset_size as sql::ULen,
+            );
+        },
+        sql::StatementAttribute::ParamBindType => unsafe {
+            std::ptr::write(
+                value as *mut sql::ULen,
+                stmt.attributes.param_bind_type as sql::ULen,
+            );
+        },
+        sql::StatementAttribute::ParamsProcessedPtr => unsafe {
+            std::ptr::write(
+                value as *mut *mut sql::ULen,
+                stmt.attributes.params_processed_ptr,
+            );
+        },
+        _ => {
+            tracing::error!("Unhandled statement attribute: {:?}", attribute);
+            return UnknownAttributeSnafu { attribute }.fail();
+        }
+    }
+    Ok(())
+}
@@ -1,5 +1,7 @@
 use crate::api::{OdbcError, diagnostic::DiagnosticInfo};
 use crate::cdata_types::CDataType;
+use crate::column_descriptors::ColumnDescriptor;
+use crate::column_kernels::BoundColumn;
 use arrow::{array::RecordBatch, ffi_stream::ArrowArrayStreamReader};
 use odbc_sys as sql;
 use sf_core::protobuf_gen::database_driver_v1::{
@@ -19,6 +21,9 @@ impl ToSqlReturn for OdbcResult<()> {
     fn to_sql_return(self) -> sql::SqlReturn {
         match self {
             Ok(_) => sql::SqlReturn::SUCCESS,
+            // The rows before the failing one were fetched
+            Err(OdbcError::RowConversion { .. }) => sql::SqlReturn::SUCCESS_WITH_INFO,
+            Err(OdbcError::StringTruncated { .. }) => sql::SqlReturn::SUCCESS_WITH_INFO,
             Err(OdbcError::NoMoreData { .. }) => sql::SqlReturn::NO_DATA,
             Err(OdbcError::InvalidHandle { .. }) => sql::SqlReturn::INVALID_HANDLE,
             Err(_) => sql::SqlReturn::ERROR,
@@ -57,6 +62,44 @@ pub struct ParameterBinding {
     pub str_len_or_ind_ptr: *mut sql::Len,
 }
 
+#[derive(Debug, Clone)]
+pub struct ColumnBinding {
+    pub target_type: CDataType,
+    pub target_value_ptr: sql::Pointer,
+    pub buffer_length: sql::Len,
+    pub str_len_or_ind_ptr: *mut sql::Len,
+}
+
+/// Statement attributes controlling how many rows one fetch returns and where
+/// the driver reports them.
+#[derive(Debug, Clone, Copy)]
+pub struct StatementAttributes {
+    pub row_array_size: usize,
+    /// `SQL_BIND_BY_COLUMN` (0) or the size of the application's row structure.
+    pub row_bind_type: usize,
+    pub rows_fetched_ptr: *mut sql::ULen,
+    pub row_status_ptr: *mut sql::USmallInt,
+    /// Number of parameter sets sent by one execution.
+    pub paramset_size: usize,
+    /// `SQL_PARAM_BIND_BY_COLUMN` (0) or the size of the application's parameter structure.
+    pub param_bind_type: usize,
+    pub params_processed_ptr: *mut sql::ULen,
+}
+
+impl Default for StatementAttributes {
+    fn default() -> Self {
+        Self {
+            row_array_size: 1,
+            row_bind_type: 0,
+            rows_fetched_ptr: std::ptr::null_mut(),
+            row_status_ptr: std::ptr::null_mut(),
+            paramset_size: 1,
+            param_bind_type: 0,
+            params_processed_ptr: std::ptr::null_mut(),
+        }
+    }
+}
+
 pub enum StatementState {
     Created,
     Executed {
@@ -138,6 +181,16 @@ pub struct Statement<'a> {
     pub stmt_handle: StatementHandle,
     pub state: State<StatementState>,
     pub parameter_bindings: HashMap<u16, ParameterBinding>,
+    /// Descriptors of the current result set's columns, empty before execution
+    /// unless the statement is prepared.
+    pub columns: Vec<ColumnDescriptor>,
+    /// Descriptors of the statement's parameters, `None` until it is prepared
+    /// or executed directly.
+    pub parameters: Option<Vec<ColumnDescriptor>>,
+    pub column_bindings: HashMap<u16, ColumnBinding>,
+    /// Kernels for `column_bindings`, selected on the first fetch of a result set.
+    pub bound_columns: Option<Vec<BoundColumn>>,
+    pub attributes: StatementAttributes,
     pub diagnostic_info: DiagnosticInfo,
 }
 
@@ -1,17 +1,180 @@
-use crate::api::{OdbcResult, StatementState, stmt_from_handle};
+use crate::api::api_utils::string_to_cstr;
+use crate::api::error::{
+    InvalidColumnNumberSnafu, StatementNotPreparedSnafu, StringTruncatedSnafu,
+    UnsupportedColumnAttributeSnafu,
+};
+use crate::api::{OdbcResult, Statement, StatementState, stmt_from_handle};
+use crate::column_descriptors::ColumnDescriptor;
 use odbc_sys as sql;
 use tracing;
 
+const SQL_NO_NULLS: sql::SmallInt = 0;
+const SQL_NULLABLE: sql::SmallInt = 1;
+const SQL_FALSE: sql::Len = 0;
+
+const SQL_COLUMN_NAME: sql::USmallInt = 1;
+const SQL_DESC_CONCISE_TYPE: sql::USmallInt = 2;
+const SQL_DESC_DISPLAY_SIZE: sql::USmallInt = 6;
+const SQL_DESC_UNSIGNED: sql::USmallInt = 8;
+const SQL_DESC_LABEL: sql::USmallInt = 18;
+const SQL_DESC_COUNT: sql::USmallInt = 1001;
+const SQL_DESC_TYPE: sql::USmallInt = 1002;
+const SQL_DESC_LENGTH: sql::USmallInt = 1003;
+const SQL_DESC_PRECISION: sql::USmallInt = 1005;
+const SQL_DESC_SCALE: sql::USmallInt = 1006;
+const SQL_DESC_NULLABLE: sql::USmallInt = 1008;
+const SQL_DESC_NAME: sql::USmallInt = 1011;
+const SQL_DESC_OCTET_LENGTH: sql::USmallInt = 1013;
+
 /// Get the number of result columns
 pub fn num_result_cols(
-    _statement_handle: sql::Handle,
+    statement_handle: sql::Handle,
     column_count_ptr: *mut sql::SmallInt,
 ) -> OdbcResult<()> {
     tracing::debug!("num_result_cols called");
-    let int_ptr = column_count_ptr as *mut i32;
+    let stmt = stmt_from_handle(statement_handle);
     unsafe {
-        std::ptr::write(int_ptr, 1);
+        std::ptr::write(column_count_ptr, stmt.columns.len() as sql::SmallInt);
+    }
+    Ok(())
+}
+
+/// Get the number of parameters of a prepared or directly executed statement
+pub fn num_params(
+    statement_handle: sql::Handle,
+    parameter_count_ptr: *mut sql::SmallInt,
+) -> OdbcResult<()> {
+    tracing::debug!("num_params called");
+    let stmt = stmt_from_handle(statement_handle);
+    let parameters = stmt
+        .parameters
+        .as_ref()
+        .ok_or_else(|| StatementNotPreparedSnafu.build())?;
+    write_if_not_null(parameter_count_ptr, parameters.len() as sql::SmallInt);
+    Ok(())
+}
+
+fn column_descriptor<'a>(
+    stmt: &'a Statement,
+    column_number: sql::USmallInt,
+) -> OdbcResult<&'a ColumnDescriptor> {
+    stmt.columns
+        .get((column_number as usize).wrapping_sub(1))
+        .ok_or_else(|| {
+            InvalidColumnNumberSnafu {
+                number: column_number,
+            }
+            .build()
+        })
+}
+
+fn write_if_not_null<T>(ptr: *mut T, value: T) {
+    if !ptr.is_null() {
+        unsafe { std::ptr::write(ptr, value) };
+    }
+}
+
+/// Copies a column name into a NUL-terminated buffer, returning the
+/// truncation warning when the buffer was too small. Callers write their
+/// other outputs before returning it.
+fn write_name(name: &str, buffer: *mut sql::Char, buffer_length: sql::SmallInt) -> OdbcResult<()> {
+    if buffer.is_null() {
+        return Ok(());
     }
+    string_to_cstr(name, buffer, buffer_length as sql::Len)?;
+    if name.len() >= buffer_length.max(0) as usize {
+        return StringTruncatedSnafu {
+            length: name.len(),
+            buffer_length: buffer_length as sql::Len,
+        }
+        .fail();
+    }
+    Ok(())
+}
+
+fn nullability(descriptor: &ColumnDescriptor) -> sql::SmallInt {
+    if descriptor.nullable {
+        SQL_NULLABLE
+    } else {
+        SQL_NO_NULLS
+    }
+}
+
+/// Describe a result column
+#[allow(clippy::too_many_arguments)]
+pub fn describe_col(
+    statement_handle: sql::Handle,
+    column_number: sql::USmallInt,
+    column_name: *mut sql::Char,
+    buffer_length: sql::SmallInt,
+    name_length_ptr: *mut sql::SmallInt,
+    data_type_ptr: *mut sql::SmallInt,
+    column_size_ptr: *mut sql::ULen,
+    decimal_digits_ptr: *mut sql::SmallInt,
+    nullable_ptr: *mut sql::SmallInt,
+) -> OdbcResult<()> {
+    tracing::debug!("describe_col: column_number={}", column_number);
+    let stmt = stmt_from_handle(statement_handle);
+    let descriptor = column_descriptor(stmt, column_number)?;
+
+    let name = write_name(&descriptor.name, column_name, buffer_length);
+    write_if_not_null(name_length_ptr, descriptor.name.len() as sql::SmallInt);
+    write_if_not_null(data_type_ptr, descriptor.sql_type.0);
+    write_if_not_null(column_size_ptr, descriptor.column_size);
+    write_if_not_null(decimal_digits_ptr, descriptor.decimal_digits);
+    write_if_not_null(nullable_ptr, nullability(descriptor));
+    name
+}
+
+/// Get a descriptor field of a result column
+pub fn col_attribute(
+    statement_handle: sql::Handle,
+    column_number: sql::USmallInt,
+    field_identifier: sql::USmallInt,
+    character_attribute_ptr: sql::Pointer,
+    buffer_length: sql::SmallInt,
+    string_length_ptr: *mut sql::SmallInt,
+    numeric_attribute_ptr: *mut sql::Len,
+) -> OdbcResult<()> {
+    tracing::debug!(
+        "col_attribute: column_number={}, field_identifier={}",
+        column_number,
+        field_identifier
+    );
+    let stmt = stmt_from_handle(statement_handle);
+    if field_identifier == SQL_DESC_COUNT {
+        write_if_not_null(numeric_attribute_ptr, stmt.columns.len() as sql::Len);
+        return Ok(());
+    }
+    let descriptor = column_descriptor(stmt, column_number)?;
+
+    let numeric = match field_identifier {
+        SQL_DESC_NAME | SQL_DESC_LABEL | SQL_COLUMN_NAME => {
+            let name = write_name(
+                &descriptor.name,
+                character_attribute_ptr as *mut sql::Char,
+                buffer_length,
+            );
+            write_if_not_null(string_length_ptr, descriptor.name.len() as sql::SmallInt);
+            return name;
+        }
+        SQL_DESC_TYPE | SQL_DESC_CONCISE_TYPE => descriptor.sql_type.0 as sql::Len,
+        SQL_DESC_LENGTH | SQL_DESC_PRECISION | SQL_DESC_OCTET_LENGTH => {
+            descriptor.column_size as sql::Len
+        }
+        SQL_DESC_SCALE => descriptor.decimal_digits as sql::Len,
+        SQL_DESC_DISPLAY_SIZE => descriptor.display_size as sql::Len,
+        SQL_DESC_NULLABLE => nullability(descriptor) as sql::Len,
+        SQL_DESC_UNSIGNED => SQL_FALSE,
+        _ => {
+            tracing::error!("col_attribute: unsupported field identifier {field_identifier}");
+            return UnsupportedColumnAttributeSnafu {
+                identifier: field_identifier,
+            }
+            .fail();
+        }
+    };
+    write_if_not_null(numeric_attribute_ptr, numeric);
     Ok(())
 }
 
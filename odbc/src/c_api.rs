@@ -140,7 +140,71 @@ pub unsafe extern "C" fn SQLDisconnect(connection_handle: sql::Handle) -> sql::R
 /// This function is called by the ODBC driver manager.
 #[unsafe(no_mangle)]
 pub unsafe extern "C" fn SQLFetch(statement_handle: sql::Handle) -> sql::RetCode {
-    api::data::fetch(statement_handle).to_sql_code()
+    api::diagnostic::clear_diag_info(sql::HandleType::Stmt, statement_handle);
+    let result = api::data::fetch(statement_handle);
+    api::diagnostic::set_diag_info_from_result(sql::HandleType::Stmt, statement_handle, &result);
+    result.to_sql_code()
+}
+
+/// # Safety
+/// This function is called by the ODBC driver manager.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn SQLFetchScroll(
+    statement_handle: sql::Handle,
+    fetch_orientation: sql::SmallInt,
+    fetch_offset: sql::Len,
+) -> sql::RetCode {
+    api::diagnostic::clear_diag_info(sql::HandleType::Stmt, statement_handle);
+    let result = api::data::fetch_scroll(statement_handle, fetch_orientation, fetch_offset);
+    api::diagnostic::set_diag_info_from_result(sql::HandleType::Stmt, statement_handle, &result);
+    result.to_sql_code()
+}
+
+/// # Safety
+/// This function is called by the ODBC driver manager.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn SQLBindCol(
+    statement_handle: sql::Handle,
+    column_number: sql::USmallInt,
+    target_type: CDataType,
+    target_value_ptr: sql::Pointer,
+    buffer_length: sql::Len,
+    str_len_or_ind_ptr: *mut sql::Len,
+) -> sql::RetCode {
+    api::data::bind_col(
+        statement_handle,
+        column_number,
+        target_type,
+        target_value_ptr,
+        buffer_length,
+        str_len_or_ind_ptr,
+    )
+    .to_sql_code()
+}
+
+/// # Safety
+/// This function is called by the ODBC driver manager.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn SQLSetStmtAttr(
+    statement_handle: sql::Handle,
+    attribute: sql::Integer,
+    value: sql::Pointer,
+    _string_length: sql::Integer,
+) -> sql::RetCode {
+    api::statement::set_stmt_attr(statement_handle, attribute, value).to_sql_code()
+}
+
+/// # Safety
+/// This function is called by the ODBC driver manager.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn SQLGetStmtAttr(
+    statement_handle: sql::Handle,
+    attribute: sql::Integer,
+    value: sql::Pointer,
+    _buffer_length: sql::Integer,
+    _string_length: *mut sql::Integer,
+) -> sql::RetCode {
+    api::statement::get_stmt_attr(statement_handle, attribute, value).to_sql_code()
 }
 
 /// # Safety
@@ -175,6 +239,72 @@ pub unsafe extern "C" fn SQLNumResultCols(
     api::utils::num_result_cols(statement_handle, column_count_ptr).to_sql_code()
 }
 
+/// # Safety
+/// This function is called by the ODBC driver manager.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn SQLNumParams(
+    statement_handle: sql::Handle,
+    parameter_count_ptr: *mut sql::SmallInt,
+) -> sql::RetCode {
+    api::utils::num_params(statement_handle, parameter_count_ptr).to_sql_code()
+}
+
+/// # Safety
+/// This function is called by the ODBC driver manager.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn SQLDescribeCol(
+    statement_handle: sql::Handle,
+    column_number: sql::USmallInt,
+    column_name: *mut sql::Char,
+    buffer_length: sql::SmallInt,
+    name_length_ptr: *mut sql::SmallInt,
+    data_type_ptr: *mut sql::SmallInt,
+    column_size_ptr: *mut sql::ULen,
+    decimal_digits_ptr: *mut sql::SmallInt,
+    nullable_ptr: *mut sql::SmallInt,
+) -> sql::RetCode {
+    api::diagnostic::clear_diag_info(sql::HandleType::Stmt, statement_handle);
+    let result = api::utils::describe_col(
+        statement_handle,
+        column_number,
+        column_name,
+        buffer_length,
+        name_length_ptr,
+        data_type_ptr,
+        column_size_ptr,
+        decimal_digits_ptr,
+        nullable_ptr,
+    );
+    api::diagnostic::set_diag_info_from_result(sql::HandleType::Stmt, statement_handle, &result);
+    result.to_sql_code()
+}
+
+/// # Safety
+/// This function is called by the ODBC driver manager.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn SQLColAttribute(
+    statement_handle: sql::Handle,
+    column_number: sql::USmallInt,
+    field_identifier: sql::USmallInt,
+    character_attribute_ptr: sql::Pointer,
+    buffer_length: sql::SmallInt,
+    string_length_ptr: *mut sql::SmallInt,
+    numeric_attribute_ptr: *mut sql::Len,
+) -> sql::RetCode {
+    api::diagnostic::clear_diag_info(sql::HandleType::Stmt, statement_handle);
+    let result = api::utils::col_attribute(
+        statement_handle,
+        column_number,
+        field_identifier,
+        character_attribute_ptr,
+        buffer_length,
+        string_length_ptr,
+        numeric_attribute_ptr,
+    );
+    api::diagnostic::set_diag_info_from_result(sql::HandleType::Stmt, statement_handle, &result);
+    result.to_sql_code()
+}
+
 /// # Safety
 /// This function is called by the ODBC driver manager.
 #[unsafe(no_mangle)]
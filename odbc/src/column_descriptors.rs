@@ -0,0 +1,261 @@
+//! Per-statement description of the result columns.
+//!
+//! Built once when the result stream's schema is known so that fetching,
+//! SQLGetData, SQLBindCol, SQLDescribeCol and SQLColAttribute never parse
+//! the Arrow field metadata again.
+
+use arrow::datatypes::{DataType, Field, Schema};
+use odbc_sys as sql;
+
+use crate::cdata_types::CDataType;
+use crate::column_kernels::{ConvertFn, SelectKernel, kernel_selector};
+use crate::read_arrow::{ExtractError, FieldMeta, get_field_meta};
+
+// Snowflake's maximum VARCHAR length, reported when the server omits charLength
+const MAX_TEXT_LENGTH: sql::ULen = 16_777_216;
+// Snowflake's maximum BINARY length, reported when the server omits byteLength
+const MAX_BINARY_LENGTH: sql::ULen = 8_388_608;
+const DOUBLE_PRECISION: sql::ULen = 15;
+// Most fractional seconds digits of TIME and TIMESTAMP columns, the default without a scale
+const DEFAULT_FRACTION_DIGITS: sql::SmallInt = 9;
+// Lengths of "yyyy-mm-dd", "hh:mm:ss" and "yyyy-mm-dd hh:mm:ss"
+const DATE_LENGTH: sql::ULen = 10;
+const TIME_LENGTH: sql::ULen = 8;
+const TIMESTAMP_LENGTH: sql::ULen = 19;
+
+pub struct ColumnDescriptor {
+    pub name: String,
+    pub nullable: bool,
+    pub data_type: DataType,
+    pub logical_type: String,
+    pub sql_type: sql::SqlDataType,
+    pub column_size: sql::ULen,
+    pub decimal_digits: sql::SmallInt,
+    pub display_size: sql::ULen,
+    field_meta: Result<FieldMeta, ExtractError>,
+    select_kernel: Option<SelectKernel>,
+}
+
+impl ColumnDescriptor {
+    pub fn new(field: &Field) -> Self {
+        let metadata = field.metadata();
+        let logical_type = metadata
+            .get("logicalType")
+            .cloned()
+            .unwrap_or_else(|| "NONE".to_string());
+        let field_meta = get_field_meta(field);
+        let (sql_type, column_size, decimal_digits, display_size) =
+            match (logical_type.as_str(), &field_meta) {
+                ("FIXED", Ok(FieldMeta::Fixed { scale, precision })) => (
+                    sql::SqlDataType::DECIMAL,
+                    *precision as sql::ULen,
+                    *scale as sql::SmallInt,
+                    // sign and decimal point
+                    *precision as sql::ULen + 2,
+                ),
+                // Semi-structured values are returned as JSON text
+                ("TEXT" | "VARIANT" | "OBJECT" | "ARRAY", _) => {
+                    let length = metadata_value(field, "charLength").unwrap_or(MAX_TEXT_LENGTH);
+                    (sql::SqlDataType::VARCHAR, length, 0, length)
+                }
+                ("REAL", _) => (sql::SqlDataType::DOUBLE, DOUBLE_PRECISION, 0, 24),
+                ("BOOLEAN", _) => (sql::SqlDataType::EXT_BIT, 1, 0, 1),
+                ("DATE", _) => (sql::SqlDataType::DATE, DATE_LENGTH, 0, DATE_LENGTH),
+                ("TIME", _) => {
+                    let digits = fraction_digits(field);
+                    let length = with_fraction(TIME_LENGTH, digits);
+                    (sql::SqlDataType::TIME, length, digits, length)
+                }
+                ("TIMESTAMP_NTZ" | "TIMESTAMP_LTZ" | "TIMESTAMP_TZ", _) => {
+                    let digits = fraction_digits(field);
+                    let length = with_fraction(TIMESTAMP_LENGTH, digits);
+                    (sql::SqlDataType::TIMESTAMP, length, digits, length)
+                }
+                ("BINARY", _) => {
+                    let length = metadata_value(field, "byteLength").unwrap_or(MAX_BINARY_LENGTH);
+                    // two hexadecimal digits per byte
+                    (sql::SqlDataType::EXT_VAR_BINARY, length, 0, length * 2)
+                }
+                _ => (sql::SqlDataType::UNKNOWN_TYPE, 0, 0, 0),
+            };
+        Self {
+            name: field.name().clone(),
+            nullable: field.is_nullable(),
+            data_type: field.data_type().clone(),
+            logical_type,
+            sql_type,
+            column_size,
+            decimal_digits,
+            display_size,
+            field_meta,
+            select_kernel: kernel_selector(field.data_type()),
+        }
+    }
+
+    pub fn field_meta(&self) -> Result<&FieldMeta, ExtractError> {
+        self.field_meta.as_ref().map_err(Clone::clone)
+    }
+
+    /// Conversion kernel from this column into `target_type`
+    pub fn kernel(&self, target_type: CDataType) -> Result<ConvertFn, ExtractError> {
+        let select_kernel = self
+            .select_kernel
+            .ok_or_else(|| ExtractError::UnsupportedArrowType(self.data_type.clone()))?;
+        select_kernel(target_type)
+    }
+}
+
+fn metadata_value<T: std::str::FromStr>(field: &Field, key: &str) -> Option<T> {
+    field.metadata().get(key)?.parse().ok()
+}
+
+/// Fractional seconds digits of a TIME or TIMESTAMP column, from its scale
+fn fraction_digits(field: &Field) -> sql::SmallInt {
+    metadata_value(field, "scale")
+        .map(|digits: sql::SmallInt| digits.clamp(0, DEFAULT_FRACTION_DIGITS))
+        .unwrap_or(DEFAULT_FRACTION_DIGITS)
+}
+
+/// Length of a time value followed by a decimal point and `digits` fractional digits
+fn with_fraction(length: sql::ULen, digits: sql::SmallInt) -> sql::ULen {
+    match digits {
+        0 => length,
+        digits => length + 1 + digits as sql::ULen,
+    }
+}
+
+pub fn describe_columns(schema: &Schema) -> Vec<ColumnDescriptor> {
+    schema
+        .fields()
+        .iter()
+        .map(|field| ColumnDescriptor::new(field))
+        .collect()
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use std::collections::HashMap;
+
+    fn field(name: &str, data_type: DataType, metadata: &[(&str, &str)]) -> Field {
+        Field::new(name, data_type, true).with_metadata(
+            metadata
+                .iter()
+                .map(|(k, v)| (k.to_string(), v.to_string()))
+                .collect::<HashMap<_, _>>(),
+        )
+    }
+
+    #[test]
+    fn describes_fixed_column() {
+        let descriptor = ColumnDescriptor::new(&field(
+            "AMOUNT",
+            DataType::Int64,
+            &[
+                ("logicalType", "FIXED"),
+                ("scale", "2"),
+                ("precision", "10"),
+            ],
+        ));
+        assert_eq!(descriptor.name, "AMOUNT");
+        assert_eq!(descriptor.sql_type, sql::SqlDataType::DECIMAL);
+        assert_eq!(descriptor.column_size, 10);
+        assert_eq!(descriptor.decimal_digits, 2);
+        assert!(matches!(
+            descriptor.field_meta(),
+            Ok(FieldMeta::Fixed {
+                scale: 2,
+                precision: 10
+            })
+        ));
+        assert!(descriptor.kernel(CDataType::SLong).is_ok());
+    }
+
+    #[test]
+    fn describes_text_column() {
+        let descriptor = ColumnDescriptor::new(&field(
+            "NAME",
+            DataType::Utf8,
+            &[("logicalType", "TEXT"), ("charLength", "42")],
+        ));
+        assert_eq!(descriptor.sql_type, sql::SqlDataType::VARCHAR);
+        assert_eq!(descriptor.column_size, 42);
+    }
+
+    #[test]
+    fn describes_date_and_time_columns() {
+        let date = ColumnDescriptor::new(&field("D", DataType::Date32, &[("logicalType", "DATE")]));
+        assert_eq!(date.sql_type, sql::SqlDataType::DATE);
+        assert_eq!(date.column_size, 10);
+
+        let time = ColumnDescriptor::new(&field(
+            "T",
+            DataType::Int64,
+            &[("logicalType", "TIME"), ("scale", "3")],
+        ));
+        assert_eq!(time.sql_type, sql::SqlDataType::TIME);
+        assert_eq!(time.column_size, 12);
+        assert_eq!(time.decimal_digits, 3);
+
+        for logical_type in ["TIMESTAMP_NTZ", "TIMESTAMP_LTZ", "TIMESTAMP_TZ"] {
+            let timestamp = ColumnDescriptor::new(&field(
+                "TS",
+                DataType::Int64,
+                &[("logicalType", logical_type), ("scale", "0")],
+            ));
+            assert_eq!(timestamp.sql_type, sql::SqlDataType::TIMESTAMP);
+            assert_eq!(timestamp.column_size, 19);
+            assert_eq!(timestamp.decimal_digits, 0);
+        }
+
+        let timestamp = ColumnDescriptor::new(&field(
+            "TS",
+            DataType::Int64,
+            &[("logicalType", "TIMESTAMP_NTZ")],
+        ));
+        assert_eq!(timestamp.column_size, 29);
+        assert_eq!(timestamp.decimal_digits, 9);
+    }
+
+    #[test]
+    fn describes_binary_and_semi_structured_columns() {
+        let binary = ColumnDescriptor::new(&field(
+            "B",
+            DataType::Binary,
+            &[("logicalType", "BINARY"), ("byteLength", "16")],
+        ));
+        assert_eq!(binary.sql_type, sql::SqlDataType::EXT_VAR_BINARY);
+        assert_eq!(binary.column_size, 16);
+        assert_eq!(binary.display_size, 32);
+
+        for logical_type in ["VARIANT", "OBJECT", "ARRAY"] {
+            let descriptor = ColumnDescriptor::new(&field(
+                "V",
+                DataType::Utf8,
+                &[("logicalType", logical_type)],
+            ));
+            assert_eq!(descriptor.sql_type, sql::SqlDataType::VARCHAR);
+            assert_eq!(descriptor.column_size, MAX_TEXT_LENGTH);
+        }
+    }
+
+    #[test]
+    fn invalid_metadata_fails_only_on_conversion() {
+        let descriptor = ColumnDescriptor::new(&field(
+            "BROKEN",
+            DataType::Int64,
+            &[("logicalType", "FIXED"), ("scale", "x"), ("precision", "1")],
+        ));
+        assert_eq!(descriptor.sql_type, sql::SqlDataType::UNKNOWN_TYPE);
+        assert!(descriptor.field_meta().is_err());
+    }
+
+    #[test]
+    fn unsupported_arrow_type_has_no_kernel() {
+        let descriptor = ColumnDescriptor::new(&field("FLAG", DataType::Boolean, &[]));
+        assert!(matches!(
+            descriptor.kernel(CDataType::Char),
+            Err(ExtractError::UnsupportedArrowType(DataType::Boolean))
+        ));
+    }
+}
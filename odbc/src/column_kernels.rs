@@ -0,0 +1,611 @@
+//! Column-wise conversion of Arrow arrays into buffers bound with SQLBindCol.
+//!
+//! A conversion kernel is selected once per bound column from its Arrow type
+//! and target C type. Filling a rowset then runs one typed loop per column,
+//! without re-dispatching on the Arrow type or downcasting for every cell.
+
+use std::ops::Range;
+
+use arrow::array::{Array, ArrowPrimitiveType, PrimitiveArray, RecordBatch, StringArray};
+use arrow::datatypes::{DataType, Decimal128Type, Int8Type, Int16Type, Int32Type, Int64Type};
+use odbc_sys as sql;
+
+use crate::api::ColumnBinding;
+use crate::cdata_types::{CDataType, Double, Real, SBigInt, UBigInt};
+use crate::column_descriptors::ColumnDescriptor;
+use crate::decimal::{DecimalFloat, decimals_to_float};
+use crate::read_arrow::{Buffer, ExtractError, FieldMeta, WriteValue, check_decimal_scale};
+
+/// Bound buffers of one column and the distance between consecutive rows.
+pub struct ColumnTarget {
+    value_ptr: *mut u8,
+    value_stride: usize,
+    indicator_ptr: *mut u8,
+    indicator_stride: usize,
+    buffer_length: sql::Len,
+    fixed_length: Option<usize>,
+}
+
+impl ColumnTarget {
+    fn new(binding: &ColumnBinding, row_bind_type: usize) -> Self {
+        let fixed_length = fixed_length(binding.target_type);
+        let element_size = fixed_length.unwrap_or(binding.buffer_length.max(0) as usize);
+        let (value_stride, indicator_stride) = match row_bind_type {
+            0 => (element_size, std::mem::size_of::<sql::Len>()),
+            row_size => (row_size, row_size),
+        };
+        Self {
+            value_ptr: binding.target_value_ptr as *mut u8,
+            value_stride,
+            indicator_ptr: binding.str_len_or_ind_ptr as *mut u8,
+            indicator_stride,
+            buffer_length: binding.buffer_length,
+            fixed_length,
+        }
+    }
+
+    fn value_ptr<T>(&self, slot: usize) -> *mut T {
+        unsafe { self.value_ptr.add(slot * self.value_stride) as *mut T }
+    }
+
+    fn indicator_ptr(&self, slot: usize) -> *mut sql::Len {
+        if self.indicator_ptr.is_null() {
+            return std::ptr::null_mut();
+        }
+        unsafe { self.indicator_ptr.add(slot * self.indicator_stride) as *mut sql::Len }
+    }
+
+    fn write_null(&self, slot: usize) {
+        let indicator = self.indicator_ptr(slot);
+        if !indicator.is_null() {
+            unsafe { std::ptr::write(indicator, sql::NULL_DATA) };
+        }
+    }
+
+    fn write_fixed_length(&self, slot: usize) {
+        let indicator = self.indicator_ptr(slot);
+        if let Some(length) = self.fixed_length
+            && !indicator.is_null()
+        {
+            unsafe { std::ptr::write(indicator, length as sql::Len) };
+        }
+    }
+
+    fn char_buffer(&self, slot: usize) -> Buffer<sql::Char> {
+        Buffer::new(
+            self.value_ptr::<sql::Char>(slot),
+            self.buffer_length.max(0) as usize,
+            self.indicator_ptr(slot),
+        )
+    }
+}
+
+/// Size of fixed-length C types, `None` for buffers sized by `buffer_length`
+fn fixed_length(target_type: CDataType) -> Option<usize> {
+    match target_type {
+        CDataType::UBigInt | CDataType::SBigInt => Some(std::mem::size_of::<SBigInt>()),
+        CDataType::Long | CDataType::SLong | CDataType::ULong => {
+            Some(std::mem::size_of::<sql::Integer>())
+        }
+        CDataType::Short | CDataType::SShort | CDataType::UShort => {
+            Some(std::mem::size_of::<sql::SmallInt>())
+        }
+        CDataType::TinyInt | CDataType::STinyInt | CDataType::UTinyInt => {
+            Some(std::mem::size_of::<sql::SChar>())
+        }
+        CDataType::Float => Some(std::mem::size_of::<Real>()),
+        CDataType::Double => Some(std::mem::size_of::<Double>()),
+        _ => None,
+    }
+}
+
+/// Failure of a kernel after converting the first `rows_converted` rows of
+/// its range.
+#[derive(Debug)]
+pub struct KernelError {
+    pub rows_converted: usize,
+    pub source: ExtractError,
+}
+
+impl From<ExtractError> for KernelError {
+    fn from(source: ExtractError) -> Self {
+        Self {
+            rows_converted: 0,
+            source,
+        }
+    }
+}
+
+pub type ConvertFn =
+    fn(&ColumnTarget, &dyn Array, &FieldMeta, Range<usize>, usize) -> Result<(), KernelError>;
+
+fn downcast<A: Array + 'static>(array: &dyn Array) -> Result<&A, ExtractError> {
+    array
+        .as_any()
+        .downcast_ref::<A>()
+        .ok_or(ExtractError::DowncastError)
+}
+
+/// Scale of a FIXED column: the Decimal128 scale when the array has one,
+/// otherwise the scale from the field metadata.
+fn fixed_scale(array: &dyn Array, meta: &FieldMeta) -> Result<u32, ExtractError> {
+    let scale = match (array.data_type(), meta) {
+        (DataType::Decimal128(_, scale), _) => *scale as u32,
+        (_, FieldMeta::Fixed { scale, .. }) => *scale,
+        (data_type, meta) => {
+            return Err(ExtractError::UnsupportedFieldMeta(
+                meta.clone(),
+                data_type.clone(),
+            ));
+        }
+    };
+    check_decimal_scale(scale)?;
+    Ok(scale)
+}
+
+/// C integer types that FIXED values are narrowed into once their fractional
+/// digits are dropped.
+trait IntegerTarget: Copy {
+    fn from_whole(whole: i128) -> Self;
+}
+
+macro_rules! integer_target {
+    ($($c_type:ty),*) => {
+        $(
+            impl IntegerTarget for $c_type {
+                fn from_whole(whole: i128) -> Self {
+                    whole as $c_type
+                }
+            }
+        )*
+    };
+}
+
+integer_target!(
+    SBigInt,
+    UBigInt,
+    sql::Integer,
+    sql::UInteger,
+    sql::SmallInt,
+    sql::USmallInt,
+    sql::SChar,
+    sql::Char
+);
+
+fn convert_fixed_to_integer<P, C>(
+    target: &ColumnTarget,
+    array: &dyn Array,
+    meta: &FieldMeta,
+    rows: Range<usize>,
+    first_slot: usize,
+) -> Result<(), KernelError>
+where
+    P: ArrowPrimitiveType,
+    P::Native: Into<i128>,
+    C: IntegerTarget,
+{
+    let array = downcast::<PrimitiveArray<P>>(array)?;
+    let divisor = 10_i128.pow(fixed_scale(array, meta)?);
+    let values = array.values();
+    let has_nulls = array.null_count() > 0;
+    for (slot, row) in (first_slot..).zip(rows) {
+        if has_nulls && array.is_null(row) {
+            target.write_null(slot);
+            continue;
+        }
+        target.write_fixed_length(slot);
+        let value: i128 = values[row].into();
+        unsafe { std::ptr::write(target.value_ptr::<C>(slot), C::from_whole(value / divisor)) };
+    }
+    Ok(())
+}
+
+fn convert_fixed_to_char<P>(
+    target: &ColumnTarget,
+    array: &dyn Array,
+    meta: &FieldMeta,
+    rows: Range<usize>,
+    first_slot: usize,
+) -> Result<(), KernelError>
+where
+    P: ArrowPrimitiveType,
+    P::Native: Into<i128>,
+{
+    let array = downcast::<PrimitiveArray<P>>(array)?;
+    let scale = fixed_scale(array, meta)?;
+    let values = array.values();
+    let has_nulls = array.null_count() > 0;
+    for (slot, row) in (first_slot..).zip(rows) {
+        if has_nulls && array.is_null(row) {
+            target.write_null(slot);
+            continue;
+        }
+        target
+            .char_buffer(slot)
+            .write_decimal_unchecked(values[row].into(), scale);
+    }
+    Ok(())
+}
+
+// Rows converted per step of the float kernels, small enough for the stack
+const FLOAT_KERNEL_STEP: usize = 256;
+
+/// Converts FIXED mantissas to floating point a slice at a time.
+fn convert_fixed_to_float<P, F>(
+    target: &ColumnTarget,
+    array: &dyn Array,
+    meta: &FieldMeta,
+    rows: Range<usize>,
+    first_slot: usize,
+) -> Result<(), KernelError>
+where
+    P: ArrowPrimitiveType,
+    P::Native: Into<i128>,
+    F: DecimalFloat,
+{
+    let array = downcast::<PrimitiveArray<P>>(array)?;
+    let scale = fixed_scale(array, meta)?;
+    let has_nulls = array.null_count() > 0;
+    let mut converted = [F::default(); FLOAT_KERNEL_STEP];
+    let mut slot = first_slot;
+    for start in rows.clone().step_by(FLOAT_KERNEL_STEP) {
+        let end = (start + FLOAT_KERNEL_STEP).min(rows.end);
+        let converted = &mut converted[..end - start];
+        decimals_to_float(&array.values()[start..end], scale, converted);
+        for (row, &value) in (start..end).zip(converted.iter()) {
+            if has_nulls && array.is_null(row) {
+                target.write_null(slot);
+            } else {
+                target.write_fixed_length(slot);
+                unsafe { std::ptr::write(target.value_ptr::<F>(slot), value) };
+            }
+            slot += 1;
+        }
+    }
+    Ok(())
+}
+
+fn convert_utf8_to_char(
+    target: &ColumnTarget,
+    array: &dyn Array,
+    _meta: &FieldMeta,
+    rows: Range<usize>,
+    first_slot: usize,
+) -> Result<(), KernelError> {
+    let array = downcast::<StringArray>(array)?;
+    let has_nulls = array.null_count() > 0;
+    for (slot, row) in (first_slot..).zip(rows) {
+        if has_nulls && array.is_null(row) {
+            target.write_null(slot);
+            continue;
+        }
+        target.char_buffer(slot).write(array.value(row));
+    }
+    Ok(())
+}
+
+fn select_for_fixed<P>(target_type: CDataType) -> Result<ConvertFn, ExtractError>
+where
+    P: ArrowPrimitiveType,
+    P::Native: Into<i128>,
+{
+    let convert: ConvertFn = match target_type {
+        CDataType::Char => convert_fixed_to_char::<P>,
+        CDataType::UBigInt => convert_fixed_to_integer::<P, UBigInt>,
+        CDataType::SBigInt => convert_fixed_to_integer::<P, SBigInt>,
+        CDataType::Long | CDataType::SLong => convert_fixed_to_integer::<P, sql::Integer>,
+        CDataType::ULong => convert_fixed_to_integer::<P, sql::UInteger>,
+        CDataType::SShort | CDataType::Short => convert_fixed_to_integer::<P, sql::SmallInt>,
+        CDataType::UShort => convert_fixed_to_integer::<P, sql::USmallInt>,
+        CDataType::STinyInt | CDataType::TinyInt => convert_fixed_to_integer::<P, sql::SChar>,
+        CDataType::UTinyInt => convert_fixed_to_integer::<P, sql::Char>,
+        CDataType::Float => convert_fixed_to_float::<P, Real>,
+        CDataType::Double => convert_fixed_to_float::<P, Double>,
+        _ => return Err(ExtractError::UnsupportedTargetType(target_type)),
+    };
+    Ok(convert)
+}
+
+fn select_for_utf8(target_type: CDataType) -> Result<ConvertFn, ExtractError> {
+    match target_type {
+        CDataType::Char => Ok(convert_utf8_to_char),
+        _ => Err(ExtractError::UnsupportedTargetType(target_type)),
+    }
+}
+
+/// Kernel selection for one Arrow type, leaving only the target C type to pick
+pub type SelectKernel = fn(CDataType) -> Result<ConvertFn, ExtractError>;
+
+pub fn kernel_selector(data_type: &DataType) -> Option<SelectKernel> {
+    let select: SelectKernel = match data_type {
+        DataType::Int8 => select_for_fixed::<Int8Type>,
+        DataType::Int16 => select_for_fixed::<Int16Type>,
+        DataType::Int32 => select_for_fixed::<Int32Type>,
+        DataType::Int64 => select_for_fixed::<Int64Type>,
+        DataType::Decimal128(_, _) => select_for_fixed::<Decimal128Type>,
+        DataType::Utf8 => select_for_utf8,
+        _ => return None,
+    };
+    Some(select)
+}
+
+/// A result column bound with SQLBindCol together with its conversion kernel.
+pub struct BoundColumn {
+    column_idx: usize,
+    binding: ColumnBinding,
+    field_meta: FieldMeta,
+    convert: ConvertFn,
+}
+
+impl BoundColumn {
+    pub fn new(
+        column_idx: usize,
+        binding: ColumnBinding,
+        descriptor: &ColumnDescriptor,
+    ) -> Result<Self, ExtractError> {
+        Ok(Self {
+            column_idx,
+            convert: descriptor.kernel(binding.target_type)?,
+            field_meta: descriptor.field_meta()?.clone(),
+            binding,
+        })
+    }
+
+    /// Bound column converted by `convert`, for tests that need a kernel
+    /// failing on a chosen row.
+    #[cfg(test)]
+    pub fn with_kernel(column_idx: usize, binding: ColumnBinding, convert: ConvertFn) -> Self {
+        Self {
+            column_idx,
+            binding,
+            field_meta: FieldMeta::None,
+            convert,
+        }
+    }
+
+    /// Converts `rows` of the batch into consecutive rowset slots starting at `first_slot`.
+    pub fn convert(
+        &self,
+        record_batch: &RecordBatch,
+        rows: Range<usize>,
+        first_slot: usize,
+        row_bind_type: usize,
+    ) -> Result<(), KernelError> {
+        let target = ColumnTarget::new(&self.binding, row_bind_type);
+        (self.convert)(
+            &target,
+            record_batch.column(self.column_idx),
+            &self.field_meta,
+            rows,
+            first_slot,
+        )
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use arrow::array::{Decimal128Array, Int32Array, Int64Array};
+    use arrow::datatypes::{Field, Schema};
+    use std::collections::HashMap;
+    use std::sync::Arc;
+
+    fn fixed_field(name: &str, data_type: DataType, scale: u32) -> Field {
+        Field::new(name, data_type, true).with_metadata(HashMap::from([
+            ("logicalType".to_string(), "FIXED".to_string()),
+            ("scale".to_string(), scale.to_string()),
+            ("precision".to_string(), "38".to_string()),
+        ]))
+    }
+
+    fn batch(field: Field, array: Arc<dyn Array>) -> RecordBatch {
+        RecordBatch::try_new(Arc::new(Schema::new(vec![field])), vec![array]).unwrap()
+    }
+
+    fn binding(
+        target_type: CDataType,
+        target_value_ptr: sql::Pointer,
+        buffer_length: sql::Len,
+        str_len_or_ind_ptr: *mut sql::Len,
+    ) -> ColumnBinding {
+        ColumnBinding {
+            target_type,
+            target_value_ptr,
+            buffer_length,
+            str_len_or_ind_ptr,
+        }
+    }
+
+    #[test]
+    fn converts_int64_slice_into_long_array() {
+        let field = fixed_field("ID", DataType::Int64, 0);
+        let batch = batch(
+            field.clone(),
+            Arc::new(Int64Array::from(vec![Some(10), None, Some(30), Some(40)])),
+        );
+        let mut values = [0 as sql::Integer; 4];
+        let mut indicators = [0 as sql::Len; 4];
+        let column = BoundColumn::new(
+            0,
+            binding(
+                CDataType::SLong,
+                values.as_mut_ptr() as sql::Pointer,
+                0,
+                indicators.as_mut_ptr(),
+            ),
+            &ColumnDescriptor::new(&field),
+        )
+        .unwrap();
+
+        column.convert(&batch, 1..4, 1, 0).unwrap();
+
+        assert_eq!(values, [0, 0, 30, 40]);
+        assert_eq!(indicators, [0, sql::NULL_DATA, 4, 4]);
+    }
+
+    #[test]
+    fn converts_decimal_into_double_array() {
+        let field = fixed_field("AMOUNT", DataType::Decimal128(38, 2), 2);
+        let array = Decimal128Array::from(vec![12345, -12345])
+            .with_precision_and_scale(38, 2)
+            .unwrap();
+        let batch = batch(field.clone(), Arc::new(array));
+        let mut values = [0 as Double; 2];
+        let column = BoundColumn::new(
+            0,
+            binding(
+                CDataType::Double,
+                values.as_mut_ptr() as sql::Pointer,
+                0,
+                std::ptr::null_mut(),
+            ),
+            &ColumnDescriptor::new(&field),
+        )
+        .unwrap();
+
+        column.convert(&batch, 0..2, 0, 0).unwrap();
+
+        assert_eq!(values, [123.45, -123.45]);
+    }
+
+    #[test]
+    fn converts_fixed_into_float_array_across_kernel_steps() {
+        let field = fixed_field("PRICE", DataType::Int32, 1);
+        let rows = FLOAT_KERNEL_STEP * 2 + 10;
+        let array = Int32Array::from_iter((0..rows as i32).map(|v| (v % 7 != 0).then_some(v)));
+        let batch = batch(field.clone(), Arc::new(array));
+        let mut values = vec![0 as Real; rows];
+        let mut indicators = vec![0 as sql::Len; rows];
+        let column = BoundColumn::new(
+            0,
+            binding(
+                CDataType::Float,
+                values.as_mut_ptr() as sql::Pointer,
+                0,
+                indicators.as_mut_ptr(),
+            ),
+            &ColumnDescriptor::new(&field),
+        )
+        .unwrap();
+
+        column.convert(&batch, 0..rows, 0, 0).unwrap();
+
+        for row in 0..rows {
+            if row % 7 == 0 {
+                assert_eq!(indicators[row], sql::NULL_DATA);
+            } else {
+                assert_eq!(indicators[row], 4);
+                assert_eq!(values[row], row as Real / 10.0);
+            }
+        }
+    }
+
+    #[test]
+    fn converts_scaled_fixed_into_integer_and_char_arrays() {
+        let field = fixed_field("AMOUNT", DataType::Int64, 2);
+        let batch = batch(
+            field.clone(),
+            Arc::new(Int64Array::from(vec![12345, -12345])),
+        );
+        let descriptor = ColumnDescriptor::new(&field);
+        let mut integers = [0 as SBigInt; 2];
+        let mut text = [0u8; 16];
+        let mut indicators = [0 as sql::Len; 2];
+        let integer_column = BoundColumn::new(
+            0,
+            binding(
+                CDataType::SBigInt,
+                integers.as_mut_ptr() as sql::Pointer,
+                0,
+                std::ptr::null_mut(),
+            ),
+            &descriptor,
+        )
+        .unwrap();
+        let char_column = BoundColumn::new(
+            0,
+            binding(
+                CDataType::Char,
+                text.as_mut_ptr() as sql::Pointer,
+                8,
+                indicators.as_mut_ptr(),
+            ),
+            &descriptor,
+        )
+        .unwrap();
+
+        integer_column.convert(&batch, 0..2, 0, 0).unwrap();
+        char_column.convert(&batch, 0..2, 0, 0).unwrap();
+
+        assert_eq!(integers, [123, -123]);
+        assert_eq!(&text[..6], b"123.45");
+        assert_eq!(&text[8..15], b"-123.45");
+        assert_eq!(indicators, [6, 7]);
+    }
+
+    #[test]
+    fn converts_utf8_into_row_wise_char_buffers() {
+        #[repr(C)]
+        struct Row {
+            text: [u8; 8],
+            indicator: sql::Len,
+        }
+        let field = Field::new("NAME", DataType::Utf8, true).with_metadata(HashMap::from([(
+            "logicalType".to_string(),
+            "TEXT".to_string(),
+        )]));
+        let batch = batch(
+            field.clone(),
+            Arc::new(StringArray::from(vec!["ab", "cde"])),
+        );
+        let mut rows = [
+            Row {
+                text: [0; 8],
+                indicator: 0,
+            },
+            Row {
+                text: [0; 8],
+                indicator: 0,
+            },
+        ];
+        let column = BoundColumn::new(
+            0,
+            binding(
+                CDataType::Char,
+                rows[0].text.as_mut_ptr() as sql::Pointer,
+                8,
+                &mut rows[0].indicator,
+            ),
+            &ColumnDescriptor::new(&field),
+        )
+        .unwrap();
+
+        column
+            .convert(&batch, 0..2, 0, std::mem::size_of::<Row>())
+            .unwrap();
+
+        assert_eq!(&rows[0].text[..2], b"ab");
+        assert_eq!(rows[0].indicator, 2);
+        assert_eq!(&rows[1].text[..3], b"cde");
+        assert_eq!(rows[1].indicator, 3);
+    }
+
+    #[test]
+    fn rejects_unsupported_target_type_at_bind_time() {
+        let field = fixed_field("ID", DataType::Int64, 0);
+        let result = BoundColumn::new(
+            0,
+            binding(
+                CDataType::Binary,
+                std::ptr::null_mut(),
+                0,
+                std::ptr::null_mut(),
+            ),
+            &ColumnDescriptor::new(&field),
+        );
+        assert!(matches!(
+            result,
+            Err(ExtractError::UnsupportedTargetType(CDataType::Binary))
+        ));
+    }
+}
@@ -0,0 +1,367 @@
+//! Conversions of scaled FIXED values (an integer mantissa and a decimal scale).
+
+/// Floating-point type that a scaled decimal can be converted to.
+pub trait DecimalFloat: Copy + Default + 'static {
+    /// Powers of ten that are exactly representable in the type.
+    const POW10: &'static [Self];
+    /// Largest mantissa magnitude that converts to the type without rounding.
+    const MAX_EXACT_MANTISSA: u128;
+
+    fn from_mantissa(value: i128) -> Self;
+    fn div(self, divisor: Self) -> Self;
+    fn parse(digits: &str) -> Self;
+}
+
+impl DecimalFloat for f64 {
+    const POW10: &'static [Self] = &[
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16,
+        1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+    ];
+    const MAX_EXACT_MANTISSA: u128 = 1 << f64::MANTISSA_DIGITS;
+
+    fn from_mantissa(value: i128) -> Self {
+        value as f64
+    }
+    fn div(self, divisor: Self) -> Self {
+        self / divisor
+    }
+    fn parse(digits: &str) -> Self {
+        digits.parse().unwrap_or(f64::NAN)
+    }
+}
+
+impl DecimalFloat for f32 {
+    const POW10: &'static [Self] = &[1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10];
+    const MAX_EXACT_MANTISSA: u128 = 1 << f32::MANTISSA_DIGITS;
+
+    fn from_mantissa(value: i128) -> Self {
+        value as f32
+    }
+    fn div(self, divisor: Self) -> Self {
+        self / divisor
+    }
+    fn parse(digits: &str) -> Self {
+        digits.parse().unwrap_or(f32::NAN)
+    }
+}
+
+/// Correctly rounded value of `value * 10^-scale`, the same result as parsing
+/// the decimal's text representation.
+///
+/// When both the mantissa and the power of ten are exact in `F` a single IEEE
+/// division is already correctly rounded. Other values are written as
+/// `<mantissa>e-<scale>` into a stack buffer and handed to the standard parser.
+pub fn decimal_to_float<F: DecimalFloat>(value: i128, scale: u32) -> F {
+    if scale == 0 {
+        return F::from_mantissa(value);
+    }
+    match F::POW10.get(scale as usize) {
+        Some(&divisor) if value.unsigned_abs() <= F::MAX_EXACT_MANTISSA => {
+            F::from_mantissa(value).div(divisor)
+        }
+        _ => parse_scientific(value, scale),
+    }
+}
+
+/// Converts a column slice of mantissas sharing one scale into `out`.
+///
+/// The divisor is looked up once, and a slice whose mantissas are all exact in
+/// `F` is converted in a branch-free loop the compiler can vectorize.
+pub fn decimals_to_float<V: Copy + Into<i128>, F: DecimalFloat>(
+    values: &[V],
+    scale: u32,
+    out: &mut [F],
+) {
+    debug_assert_eq!(values.len(), out.len());
+    let divisor = match F::POW10.get(scale as usize) {
+        Some(&divisor) => divisor,
+        None => {
+            for (out, &value) in out.iter_mut().zip(values) {
+                *out = parse_scientific(value.into(), scale);
+            }
+            return;
+        }
+    };
+    let all_exact = values
+        .iter()
+        .all(|&value| value.into().unsigned_abs() <= F::MAX_EXACT_MANTISSA);
+    if all_exact {
+        for (out, &value) in out.iter_mut().zip(values) {
+            *out = F::from_mantissa(value.into()).div(divisor);
+        }
+    } else {
+        for (out, &value) in out.iter_mut().zip(values) {
+            *out = decimal_to_float(value.into(), scale);
+        }
+    }
+}
+
+// Sign, 39 digits of an i128, "e-" and the 10 digits of a u32 scale
+const SCIENTIFIC_BUFFER_LEN: usize = 52;
+
+fn parse_scientific<F: DecimalFloat>(value: i128, scale: u32) -> F {
+    let mut buffer = [0u8; SCIENTIFIC_BUFFER_LEN];
+    let mut start = write_digits_backwards(&mut buffer, scale as u128);
+    start -= 2;
+    buffer[start..start + 2].copy_from_slice(b"e-");
+    start = write_digits_backwards(&mut buffer[..start], value.unsigned_abs());
+    if value < 0 {
+        start -= 1;
+        buffer[start] = b'-';
+    }
+    // Only ASCII digits, signs and 'e' were written
+    F::parse(std::str::from_utf8(&buffer[start..]).unwrap_or_default())
+}
+
+/// Writes the decimal digits of `value` at the end of `buffer` and returns the
+/// index of the first digit.
+fn write_digits_backwards(buffer: &mut [u8], mut value: u128) -> usize {
+    let mut start = buffer.len();
+    loop {
+        start -= 1;
+        buffer[start] = b'0' + (value % 10) as u8;
+        value /= 10;
+        if value == 0 {
+            return start;
+        }
+    }
+}
+
+/// Largest scale the text formatter accepts, the number of digits of an i128.
+pub const MAX_DECIMAL_SCALE: u32 = 38;
+/// Longest text of an i128 mantissa with a scale up to `MAX_DECIMAL_SCALE`.
+pub const MAX_DECIMAL_TEXT_LEN: usize = 41;
+
+const POW10_U128: [u128; MAX_DECIMAL_SCALE as usize + 1] = {
+    let mut table = [1u128; MAX_DECIMAL_SCALE as usize + 1];
+    let mut i = 1;
+    while i < table.len() {
+        table[i] = table[i - 1] * 10;
+        i += 1;
+    }
+    table
+};
+
+const DIGIT_PAIRS: &[u8; 200] = b"\
+    0001020304050607080910111213141516171819\
+    2021222324252627282930313233343536373839\
+    4041424344454647484950515253545556575859\
+    6061626364656667686970717273747576777879\
+    8081828384858687888990919293949596979899";
+
+// Digits of the largest power of ten below u64::MAX
+const U64_BLOCK_DIGITS: usize = 19;
+
+/// Length of the text `write_decimal_text` produces for the value.
+pub fn decimal_text_len(value: i128, scale: u32) -> usize {
+    debug_assert!(scale <= MAX_DECIMAL_SCALE);
+    let digits = value.unsigned_abs().checked_ilog10().unwrap_or(0) as usize + 1;
+    let sign = (value < 0) as usize;
+    match scale as usize {
+        0 => sign + digits,
+        scale => sign + digits.saturating_sub(scale).max(1) + 1 + scale,
+    }
+}
+
+/// Writes `value * 10^-scale` as `[-]<whole>[.<fraction>]` with exactly `scale`
+/// fraction digits into `out`, which must be `decimal_text_len` bytes long.
+pub fn write_decimal_text(value: i128, scale: u32, out: &mut [u8]) {
+    debug_assert_eq!(out.len(), decimal_text_len(value, scale));
+    let mut whole = value.unsigned_abs();
+    let mut end = out.len();
+    if scale > 0 {
+        let divisor = POW10_U128[scale as usize];
+        // Split in 64-bit arithmetic when possible, u128 division is much slower
+        let (integer, fraction) = match u64::try_from(whole) {
+            Ok(narrow) if (scale as usize) <= U64_BLOCK_DIGITS => {
+                let divisor = divisor as u64;
+                ((narrow / divisor) as u128, (narrow % divisor) as u128)
+            }
+            _ => (whole / divisor, whole % divisor),
+        };
+        write_padded_backwards(&mut out[..end], fraction, scale as usize);
+        whole = integer;
+        end -= scale as usize + 1;
+        out[end] = b'.';
+    }
+    let start = write_u128_backwards(&mut out[..end], whole);
+    if value < 0 {
+        out[start - 1] = b'-';
+    }
+}
+
+/// Writes the digits of `value` at the end of `buffer` and returns the index
+/// of the first one.
+fn write_u128_backwards(buffer: &mut [u8], mut value: u128) -> usize {
+    let mut end = buffer.len();
+    while value > u64::MAX as u128 {
+        let block = POW10_U128[U64_BLOCK_DIGITS];
+        write_padded_backwards(&mut buffer[..end], value % block, U64_BLOCK_DIGITS);
+        value /= block;
+        end -= U64_BLOCK_DIGITS;
+    }
+    write_u64_backwards(&mut buffer[..end], value as u64)
+}
+
+fn write_u64_backwards(buffer: &mut [u8], mut value: u64) -> usize {
+    let mut start = buffer.len();
+    while value >= 100 {
+        let pair = (value % 100) as usize * 2;
+        value /= 100;
+        start -= 2;
+        buffer[start..start + 2].copy_from_slice(&DIGIT_PAIRS[pair..pair + 2]);
+    }
+    if value >= 10 {
+        let pair = value as usize * 2;
+        start -= 2;
+        buffer[start..start + 2].copy_from_slice(&DIGIT_PAIRS[pair..pair + 2]);
+    } else {
+        start -= 1;
+        buffer[start] = b'0' + value as u8;
+    }
+    start
+}
+
+/// Writes `value` left-padded with zeros into the last `width` bytes of `buffer`.
+fn write_padded_backwards(buffer: &mut [u8], value: u128, width: usize) {
+    let end = buffer.len();
+    let start = write_u128_backwards(buffer, value);
+    buffer[end - width..start].fill(b'0');
+}
+
+/// The formatting used before `write_decimal_text`, kept as the reference the
+/// tests and the decimal_text bench compare against.
+#[cfg(any(test, feature = "bench-internals"))]
+pub fn decimal_to_string(value: i128, scale: u32) -> String {
+    if scale == 0 {
+        return value.to_string();
+    }
+
+    let scale_dec = 10_i128.pow(scale);
+    let whole = value / scale_dec;
+    let decimal = value % scale_dec;
+    format!(
+        "{}.{:0width$}",
+        whole,
+        decimal.abs(),
+        width = scale as usize
+    )
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use rand::rngs::StdRng;
+    use rand::{Rng, SeedableRng};
+
+    const PROPERTY_CASES: usize = 100_000;
+
+    fn decimal_text(value: i128, scale: u32) -> String {
+        let mut out = vec![0u8; decimal_text_len(value, scale)];
+        write_decimal_text(value, scale, &mut out);
+        String::from_utf8(out).unwrap()
+    }
+
+    // decimal_to_string drops the sign of values between -1 and 0
+    fn string_path_is_exact(value: i128, scale: u32) -> bool {
+        value >= 0 || value <= -10_i128.pow(scale)
+    }
+
+    fn random_mantissa(rng: &mut StdRng) -> i128 {
+        // Spread magnitudes evenly over 1 to 38 digits
+        let digits = rng.random_range(1..=38);
+        let magnitude = rng.random_range(0..10_i128.pow(digits));
+        if rng.random_bool(0.5) {
+            -magnitude
+        } else {
+            magnitude
+        }
+    }
+
+    #[test]
+    fn converts_simple_decimals() {
+        assert_eq!(decimal_to_float::<f64>(12345, 2), 123.45);
+        assert_eq!(decimal_to_float::<f64>(-12345, 2), -123.45);
+        assert_eq!(decimal_to_float::<f64>(-5, 2), -0.05);
+        assert_eq!(decimal_to_float::<f64>(42, 0), 42.0);
+        assert_eq!(decimal_to_float::<f32>(12345, 3), 12.345);
+        assert_eq!(
+            decimal_to_float::<f64>(i128::MAX, 37),
+            decimal_to_string(i128::MAX, 37).parse::<f64>().unwrap()
+        );
+    }
+
+    #[test]
+    fn direct_conversion_matches_string_path() {
+        let mut rng = StdRng::seed_from_u64(0x5eed);
+        for _ in 0..PROPERTY_CASES {
+            let value = random_mantissa(&mut rng);
+            let scale = rng.random_range(0..=37);
+            if !string_path_is_exact(value, scale) {
+                continue;
+            }
+            let text = decimal_to_string(value, scale);
+            assert_eq!(
+                decimal_to_float::<f64>(value, scale).to_bits(),
+                text.parse::<f64>().unwrap().to_bits(),
+                "f64 of {text}"
+            );
+            assert_eq!(
+                decimal_to_float::<f32>(value, scale).to_bits(),
+                text.parse::<f32>().unwrap().to_bits(),
+                "f32 of {text}"
+            );
+        }
+    }
+
+    #[test]
+    fn batch_conversion_matches_scalar_conversion() {
+        let mut rng = StdRng::seed_from_u64(0xba7c4);
+        for _ in 0..PROPERTY_CASES / 100 {
+            let scale = rng.random_range(0..=37);
+            let narrow: Vec<i64> = (0..100)
+                .map(|_| rng.random_range(-(1 << 53)..=(1 << 53)))
+                .collect();
+            let wide: Vec<i128> = (0..100).map(|_| random_mantissa(&mut rng)).collect();
+
+            let mut out = vec![0f64; 100];
+            decimals_to_float(&narrow, scale, &mut out);
+            for (&value, converted) in narrow.iter().zip(&out) {
+                assert_eq!(*converted, decimal_to_float::<f64>(value as i128, scale));
+            }
+            decimals_to_float(&wide, scale, &mut out);
+            for (&value, converted) in wide.iter().zip(&out) {
+                assert_eq!(*converted, decimal_to_float::<f64>(value, scale));
+            }
+        }
+    }
+
+    #[test]
+    fn formats_edge_values() {
+        assert_eq!(decimal_text(0, 0), "0");
+        assert_eq!(decimal_text(-5, 2), "-0.05");
+        assert_eq!(decimal_text(5, 3), "0.005");
+        assert_eq!(decimal_text(i128::MIN, 0), i128::MIN.to_string());
+        assert_eq!(
+            decimal_text(i128::MIN, 38),
+            "-1.70141183460469231731687303715884105728"
+        );
+        assert_eq!(decimal_text(i128::MAX, 38).len(), MAX_DECIMAL_TEXT_LEN - 1);
+        assert_eq!(decimal_text(-1, 38).len(), MAX_DECIMAL_TEXT_LEN);
+    }
+
+    #[test]
+    fn text_matches_previous_formatting() {
+        let mut rng = StdRng::seed_from_u64(0x7e47);
+        for _ in 0..PROPERTY_CASES {
+            let value = random_mantissa(&mut rng);
+            let scale = rng.random_range(0..=MAX_DECIMAL_SCALE);
+            let expected = decimal_to_string(value, scale);
+            if string_path_is_exact(value, scale) {
+                assert_eq!(decimal_text(value, scale), expected);
+            } else {
+                assert_eq!(decimal_text(value, scale), format!("-{expected}"));
+            }
+        }
+    }
+}
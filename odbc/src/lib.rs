@@ -1,9 +1,21 @@
 mod api;
 pub mod c_api;
 mod cdata_types;
+mod column_descriptors;
+mod column_kernels;
+mod decimal;
 mod read_arrow;
 mod write_arrow;
 
+/// Internals measured by the benches, built only with `bench-internals`.
+#[cfg(feature = "bench-internals")]
+#[doc(hidden)]
+pub mod bench_internals {
+    pub use crate::decimal::{
+        MAX_DECIMAL_TEXT_LEN, decimal_text_len, decimal_to_string, write_decimal_text,
+    };
+}
+
 extern crate sf_core;
 extern crate tracing;
 extern crate tracing_subscriber;
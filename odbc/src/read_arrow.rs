@@ -1,17 +1,14 @@
-use arrow::{
-    array::{Array, ArrowPrimitiveType, GenericByteArray, PrimitiveArray},
-    datatypes::{
-        ByteArrayType, DataType, Decimal128Type, Field, Int8Type, Int16Type, Int32Type, Int64Type,
-        Utf8Type,
-    },
-};
+use arrow::datatypes::{DataType, Field};
 use odbc_sys as sql;
 
-use crate::cdata_types::{CDataType, Double, SBigInt, UBigInt};
+use crate::cdata_types::CDataType;
+use crate::decimal::{
+    MAX_DECIMAL_SCALE, MAX_DECIMAL_TEXT_LEN, decimal_text_len, write_decimal_text,
+};
 use std::fmt::Display;
 
 #[allow(dead_code)]
-#[derive(Debug)]
+#[derive(Debug, Clone)]
 pub enum ExtractError {
     UnsupportedArrowType(DataType),
     UnsupportedTargetType(CDataType),
@@ -29,28 +26,6 @@ impl Display for ExtractError {
     }
 }
 
-fn get_value<T: ArrowPrimitiveType>(
-    array: &dyn Array,
-    row_idx: usize,
-) -> Result<T::Native, ExtractError> {
-    Ok(array
-        .as_any()
-        .downcast_ref::<PrimitiveArray<T>>()
-        .ok_or(ExtractError::DowncastError)?
-        .value(row_idx))
-}
-
-fn get_byte_array_value<T: ByteArrayType>(
-    array: &dyn Array,
-    row_idx: usize,
-) -> Result<&T::Native, ExtractError> {
-    Ok(array
-        .as_any()
-        .downcast_ref::<GenericByteArray<T>>()
-        .unwrap()
-        .value(row_idx))
-}
-
 #[derive(Debug, Clone)]
 #[allow(dead_code)]
 pub enum FieldMeta {
@@ -59,7 +34,7 @@ pub enum FieldMeta {
     None,
 }
 
-fn get_field_meta(field: &Field) -> Result<FieldMeta, ExtractError> {
+pub fn get_field_meta(field: &Field) -> Result<FieldMeta, ExtractError> {
     let metadata = field.metadata();
     let default_value = "NONE".to_string();
     let logical_type = metadata.get("logicalType").unwrap_or(&default_value);
@@ -102,142 +77,10 @@ fn get_field_meta(field: &Field) -> Result<FieldMeta, ExtractError> {
     }
 }
 
-pub trait ReadArrowValue<T>: Sized {
-    fn read(self, array: &dyn Array, field: &Field, row_idx: usize) -> Result<(), ExtractError> {
-        match array.data_type() {
-            DataType::Int16 => self.read_int16(
-                &get_field_meta(field)?,
-                get_value::<Int16Type>(array, row_idx)?,
-            ),
-            DataType::Int32 => self.read_int32(
-                &get_field_meta(field)?,
-                get_value::<Int32Type>(array, row_idx)?,
-            ),
-            DataType::Int8 => self.read_int8(
-                &get_field_meta(field)?,
-                get_value::<Int8Type>(array, row_idx)?,
-            ),
-            DataType::Int64 => self.read_int64(
-                &get_field_meta(field)?,
-                get_value::<Int64Type>(array, row_idx)?,
-            ),
-            DataType::Utf8 => self.read_utf8(
-                &get_field_meta(field)?,
-                get_byte_array_value::<Utf8Type>(array, row_idx)?,
-            ),
-            DataType::Decimal128(precision, scale) => self.read_decimal128(
-                &get_field_meta(field)?,
-                get_value::<Decimal128Type>(array, row_idx)?,
-                *precision,
-                *scale,
-            ),
-            _ => Err(ExtractError::UnsupportedArrowType(
-                array.data_type().clone(),
-            )),
-        }
-    }
-    fn read_int8(self, _field: &FieldMeta, _value: i8) -> Result<(), ExtractError> {
-        Err(ExtractError::UnsupportedArrowType(DataType::Int8))
-    }
-    fn read_int16(self, _field: &FieldMeta, _value: i16) -> Result<(), ExtractError> {
-        Err(ExtractError::UnsupportedArrowType(DataType::Int16))
-    }
-    fn read_int32(self, _field: &FieldMeta, _value: i32) -> Result<(), ExtractError> {
-        Err(ExtractError::UnsupportedArrowType(DataType::Int32))
-    }
-    fn read_int64(self, _field: &FieldMeta, _value: i64) -> Result<(), ExtractError> {
-        Err(ExtractError::UnsupportedArrowType(DataType::Int64))
-    }
-    fn read_utf8(self, _field: &FieldMeta, _value: &str) -> Result<(), ExtractError> {
-        Err(ExtractError::UnsupportedArrowType(DataType::Utf8))
-    }
-
-    fn read_decimal128(
-        self,
-        _field: &FieldMeta,
-        _value: i128,
-        precision: u8,
-        scale: i8,
-    ) -> Result<(), ExtractError> {
-        Err(ExtractError::UnsupportedArrowType(DataType::Decimal128(
-            precision, scale,
-        )))
-    }
-}
-
-impl<V: WriteValue<UBigInt>> ReadArrowValue<UBigInt> for V {
-    fn read_int8(self, field: &FieldMeta, value: i8) -> Result<(), ExtractError> {
-        read_u64(self, field, value as u64)
-    }
-    fn read_int16(self, field: &FieldMeta, value: i16) -> Result<(), ExtractError> {
-        read_u64(self, field, value as u64)
-    }
-    fn read_int32(self, field: &FieldMeta, value: i32) -> Result<(), ExtractError> {
-        read_u64(self, field, value as u64)
-    }
-    fn read_int64(self, field: &FieldMeta, value: i64) -> Result<(), ExtractError> {
-        read_u64(self, field, value as u64)
-    }
-    fn read_decimal128(
-        self,
-        _field: &FieldMeta,
-        value: i128,
-        precision: u8,
-        scale: i8,
-    ) -> Result<(), ExtractError> {
-        read_u128(self, value as u128, precision, scale)
-    }
-}
-
 pub trait WriteValue<T> {
     fn write(&self, value: T);
 }
 
-pub struct Contramap<V, T, U>
-where
-    V: WriteValue<T>,
-{
-    pub value: V,
-    pub f: fn(U) -> T,
-}
-
-impl<V, T, U> Contramap<V, T, U>
-where
-    V: WriteValue<T>,
-{
-    pub fn new(value: V, f: fn(U) -> T) -> Self {
-        Self { value, f }
-    }
-}
-
-impl<V, T, U> WriteValue<U> for Contramap<V, T, U>
-where
-    V: WriteValue<T>,
-{
-    fn write(&self, value: U) {
-        self.value.write((self.f)(value))
-    }
-}
-
-pub struct Value<T> {
-    pub value: *mut T,
-}
-
-impl<T> WriteValue<T> for Value<T> {
-    fn write(&self, value: T) {
-        unsafe { std::ptr::write(self.value, value) };
-    }
-}
-
-impl<T> Value<T> {
-    pub fn new(value: *mut T) -> Self {
-        Self { value }
-    }
-    pub fn contramap<U>(self, f: fn(U) -> T) -> Contramap<Self, T, U> {
-        Contramap::new(self, f)
-    }
-}
-
 pub struct Buffer<T> {
     pub data: *mut T,
     pub len: usize,
@@ -259,216 +102,42 @@ impl WriteValue<&str> for Buffer<sql::Char> {
     }
 }
 
-impl<T> Buffer<T> {
-    pub fn new(data: *mut T, len: usize, str_len_or_ind: *mut sql::Len) -> Self {
-        Self {
-            data,
-            len,
-            str_len_or_ind,
+impl Buffer<sql::Char> {
+    /// Formats the decimal straight into the bound buffer, staging it on the
+    /// stack only when it has to be truncated. The scale must have passed
+    /// `check_decimal_scale`.
+    pub(crate) fn write_decimal_unchecked(&self, value: i128, scale: u32) {
+        let len = decimal_text_len(value, scale);
+        if !self.str_len_or_ind.is_null() {
+            unsafe { std::ptr::write(self.str_len_or_ind, len as sql::Len) };
         }
-    }
-}
-
-fn decimal_to_string(value: i128, scale: u32) -> String {
-    if scale == 0 {
-        return value.to_string();
-    }
-
-    let scale_dec = 10_i128.pow(scale);
-    let whole = value / scale_dec;
-    let decimal = value % scale_dec;
-    format!(
-        "{}.{:0width$}",
-        whole,
-        decimal.abs(),
-        width = scale as usize
-    )
-}
-
-fn drop_decimal_digits_i64(value: i64, scale: u32) -> i64 {
-    if scale == 0 {
-        return value;
-    }
-    let scale_dec = 10_i64.pow(scale);
-    value / scale_dec
-}
-
-fn drop_decimal_digits_u64(value: u64, scale: u32) -> u64 {
-    if scale == 0 {
-        return value;
-    }
-    let scale_dec = 10_u64.pow(scale);
-    value / scale_dec
-}
-
-impl ReadArrowValue<&str> for Buffer<sql::Char> {
-    fn read_utf8(self, _field: &FieldMeta, value: &str) -> Result<(), ExtractError> {
-        self.write(value);
-        Ok(())
-    }
-
-    fn read_int8(self, field: &FieldMeta, value: i8) -> Result<(), ExtractError> {
-        self.read_int64(field, value as i64)
-    }
-
-    fn read_int16(self, field: &FieldMeta, value: i16) -> Result<(), ExtractError> {
-        self.read_int64(field, value as i64)
-    }
-
-    fn read_int32(self, field: &FieldMeta, value: i32) -> Result<(), ExtractError> {
-        self.read_int64(field, value as i64)
-    }
-
-    fn read_int64(self, field: &FieldMeta, value: i64) -> Result<(), ExtractError> {
-        if let FieldMeta::Fixed { scale, .. } = field {
-            self.read_utf8(field, decimal_to_string(value as i128, *scale).as_str())
+        if self.len >= len {
+            let out = unsafe { std::slice::from_raw_parts_mut(self.data, len) };
+            write_decimal_text(value, scale, out);
         } else {
-            Err(ExtractError::UnsupportedFieldMeta(
-                field.clone(),
-                DataType::Int64,
-            ))
+            let mut staged = [0u8; MAX_DECIMAL_TEXT_LEN];
+            write_decimal_text(value, scale, &mut staged[..len]);
+            unsafe { std::ptr::copy_nonoverlapping(staged.as_ptr(), self.data, self.len) };
         }
     }
-
-    fn read_decimal128(
-        self,
-        field: &FieldMeta,
-        value: i128,
-        _precision: u8,
-        scale: i8,
-    ) -> Result<(), ExtractError> {
-        self.read_utf8(field, decimal_to_string(value, scale as u32).as_str())
-    }
 }
 
-fn read_u64<V: WriteValue<UBigInt>>(
-    sink: V,
-    field: &FieldMeta,
-    value: u64,
-) -> Result<(), ExtractError> {
-    if let FieldMeta::Fixed { scale, .. } = field {
-        sink.write(drop_decimal_digits_u64(value, *scale) as UBigInt);
-        Ok(())
-    } else {
-        Err(ExtractError::UnsupportedFieldMeta(
-            field.clone(),
-            DataType::Int64,
-        ))
+pub(crate) fn check_decimal_scale(scale: u32) -> Result<(), ExtractError> {
+    if scale > MAX_DECIMAL_SCALE {
+        return Err(ExtractError::ConversionError(format!(
+            "scale {scale} exceeds {MAX_DECIMAL_SCALE}"
+        )));
     }
-}
-
-fn read_u128<V: WriteValue<UBigInt>>(
-    sink: V,
-    value: u128,
-    _precision: u8,
-    scale: i8,
-) -> Result<(), ExtractError> {
-    let scale_dec = 10_u128.pow(scale as u32);
-    let whole = value / scale_dec;
-    sink.write(whole as UBigInt);
-    Ok(())
-}
-
-fn read_i64<V: WriteValue<SBigInt>>(
-    sink: V,
-    field: &FieldMeta,
-    value: i64,
-) -> Result<(), ExtractError> {
-    if let FieldMeta::Fixed { scale, .. } = field {
-        sink.write(drop_decimal_digits_i64(value, *scale) as SBigInt);
-        Ok(())
-    } else {
-        Err(ExtractError::UnsupportedFieldMeta(
-            field.clone(),
-            DataType::Int64,
-        ))
-    }
-}
-
-fn read_i128<V: WriteValue<SBigInt>>(
-    sink: V,
-    value: i128,
-    _precision: u8,
-    scale: i8,
-) -> Result<(), ExtractError> {
-    let scale_dec = 10_i128.pow(scale as u32);
-    let whole = value / scale_dec;
-    sink.write(whole as SBigInt);
     Ok(())
 }
 
-fn read_f64<V: WriteValue<Double>>(
-    sink: V,
-    field: &FieldMeta,
-    value: i128,
-) -> Result<(), ExtractError> {
-    if let FieldMeta::Fixed { scale, .. } = field {
-        // TODO: Don't parse to string, parse to f64 directly
-        let value = decimal_to_string(value, *scale);
-        sink.write(
-            value
-                .parse::<Double>()
-                .map_err(|_| ExtractError::ConversionError("value not a valid f64".to_string()))?,
-        );
-        Ok(())
-    } else {
-        Err(ExtractError::UnsupportedFieldMeta(
-            field.clone(),
-            DataType::Int64,
-        ))
-    }
-}
-
-impl<V: WriteValue<SBigInt>> ReadArrowValue<SBigInt> for V {
-    fn read_int8(self, _field: &FieldMeta, value: i8) -> Result<(), ExtractError> {
-        read_i64(self, _field, value as i64)
-    }
-    fn read_int16(self, _field: &FieldMeta, value: i16) -> Result<(), ExtractError> {
-        read_i64(self, _field, value as i64)
-    }
-    fn read_int32(self, _field: &FieldMeta, value: i32) -> Result<(), ExtractError> {
-        read_i64(self, _field, value as i64)
-    }
-    fn read_int64(self, field: &FieldMeta, value: i64) -> Result<(), ExtractError> {
-        read_i64(self, field, value)
-    }
-    fn read_decimal128(
-        self,
-        _field: &FieldMeta,
-        value: i128,
-        precision: u8,
-        scale: i8,
-    ) -> Result<(), ExtractError> {
-        read_i128(self, value, precision, scale)
-    }
-}
-
-impl<V: WriteValue<Double>> ReadArrowValue<Double> for V {
-    fn read_int8(self, _field: &FieldMeta, value: i8) -> Result<(), ExtractError> {
-        read_f64(self, _field, value as i128)?;
-        Ok(())
-    }
-    fn read_int16(self, _field: &FieldMeta, value: i16) -> Result<(), ExtractError> {
-        read_f64(self, _field, value as i128)?;
-        Ok(())
-    }
-    fn read_int32(self, _field: &FieldMeta, value: i32) -> Result<(), ExtractError> {
-        read_f64(self, _field, value as i128)?;
-        Ok(())
-    }
-    fn read_int64(self, field: &FieldMeta, value: i64) -> Result<(), ExtractError> {
-        read_f64(self, field, value as i128)?;
-        Ok(())
-    }
-    fn read_decimal128(
-        self,
-        field: &FieldMeta,
-        value: i128,
-        _precision: u8,
-        _scale: i8,
-    ) -> Result<(), ExtractError> {
-        read_f64(self, field, value)?;
-        Ok(())
+impl<T> Buffer<T> {
+    pub fn new(data: *mut T, len: usize, str_len_or_ind: *mut sql::Len) -> Self {
+        Self {
+            data,
+            len,
+            str_len_or_ind,
+        }
     }
 }
 
@@ -476,13 +145,31 @@ impl<V: WriteValue<Double>> ReadArrowValue<Double> for V {
 mod tests {
     use super::*;
 
+    fn format_into_buffer(value: i128, scale: u32, buffer_len: usize) -> (String, sql::Len) {
+        let mut data = vec![0u8; buffer_len];
+        let mut indicator: sql::Len = 0;
+        Buffer::new(data.as_mut_ptr(), buffer_len, &mut indicator)
+            .write_decimal_unchecked(value, scale);
+        let written = (indicator as usize).min(buffer_len);
+        (
+            String::from_utf8(data[..written].to_vec()).unwrap(),
+            indicator,
+        )
+    }
+
     #[test]
     fn test_decimal_to_string() {
-        assert_eq!(decimal_to_string(12345, 2), "123.45");
-        assert_eq!(decimal_to_string(-12345, 2), "-123.45");
-        assert_eq!(decimal_to_string(12345, 3), "12.345");
-        assert_eq!(decimal_to_string(1000, 3), "1.000");
-        assert_eq!(decimal_to_string(0, 2), "0.00");
-        assert_eq!(decimal_to_string(-12304, 2), "-123.04");
+        assert_eq!(format_into_buffer(12345, 2, 64).0, "123.45");
+        assert_eq!(format_into_buffer(-12345, 2, 64).0, "-123.45");
+        assert_eq!(format_into_buffer(12345, 3, 64).0, "12.345");
+        assert_eq!(format_into_buffer(1000, 3, 64).0, "1.000");
+        assert_eq!(format_into_buffer(0, 2, 64).0, "0.00");
+        assert_eq!(format_into_buffer(-12304, 2, 64).0, "-123.04");
+        assert_eq!(format_into_buffer(-5, 2, 64).0, "-0.05");
+    }
+
+    #[test]
+    fn test_decimal_truncated_to_buffer() {
+        assert_eq!(format_into_buffer(-12345, 2, 4), ("-123".to_string(), 7));
     }
 }
@@ -21,6 +21,9 @@ pub enum ArrowBindingError {
     InvalidParameterIndices,
     UnsupportedParameterType(sql::SqlDataType),
     UnsupportedCDataType(CDataType),
+    /// Column-wise character arrays need the element size to find each
+    /// parameter set.
+    InvalidBufferLength(sql::Len),
 }
 
 impl std::error::Error for ArrowBindingError {}
@@ -43,22 +46,102 @@ impl<T> Writer<T> {
     }
 }
 
+/// Bound buffers of one parameter and the distance between consecutive
+/// parameter sets.
+struct ParameterSource<'a> {
+    binding: &'a ParameterBinding,
+    value_stride: usize,
+    indicator_stride: usize,
+}
+
+impl<'a> ParameterSource<'a> {
+    /// `param_bind_type` is `SQL_PARAM_BIND_BY_COLUMN` (0) or the size of the
+    /// application's parameter structure.
+    fn new(binding: &'a ParameterBinding, element_size: usize, param_bind_type: usize) -> Self {
+        let (value_stride, indicator_stride) = match param_bind_type {
+            0 => (element_size, std::mem::size_of::<sql::Len>()),
+            row_size => (row_size, row_size),
+        };
+        Self {
+            binding,
+            value_stride,
+            indicator_stride,
+        }
+    }
+
+    fn value_ptr<T>(&self, row: usize) -> *const T {
+        unsafe {
+            (self.binding.parameter_value_ptr as *const u8).add(row * self.value_stride) as *const T
+        }
+    }
+
+    fn indicator(&self, row: usize) -> Option<sql::Len> {
+        let indicator_ptr = self.binding.str_len_or_ind_ptr as *const u8;
+        if indicator_ptr.is_null() {
+            return None;
+        }
+        Some(unsafe {
+            std::ptr::read_unaligned(
+                indicator_ptr.add(row * self.indicator_stride) as *const sql::Len
+            )
+        })
+    }
+
+    fn is_null(&self, row: usize) -> bool {
+        self.indicator(row) == Some(sql::NULL_DATA)
+    }
+}
+
 trait ArrowWriter {
     fn arrow_type(&self) -> DataType;
-    fn write(&self, binding: &ParameterBinding) -> Result<Arc<dyn Array>, ArrowBindingError> {
+    fn write(
+        &self,
+        binding: &ParameterBinding,
+        rows: usize,
+        param_bind_type: usize,
+    ) -> Result<Arc<dyn Array>, ArrowBindingError> {
         match binding.value_type {
-            CDataType::Long => self.write_long(binding),
-            CDataType::Char => self.write_char(binding),
+            CDataType::Long => self.write_long(
+                &ParameterSource::new(binding, std::mem::size_of::<i32>(), param_bind_type),
+                rows,
+            ),
+            CDataType::Char => {
+                if rows > 1 && param_bind_type == 0 && binding.buffer_length <= 0 {
+                    return Err(ArrowBindingError::InvalidBufferLength(
+                        binding.buffer_length,
+                    ));
+                }
+                self.write_char(
+                    &ParameterSource::new(
+                        binding,
+                        binding.buffer_length.max(0) as usize,
+                        param_bind_type,
+                    ),
+                    rows,
+                )
+            }
             _ => Err(ArrowBindingError::UnsupportedCDataType(binding.value_type)),
         }
     }
 
-    fn write_long(&self, binding: &ParameterBinding) -> Result<Arc<dyn Array>, ArrowBindingError> {
-        Err(ArrowBindingError::UnsupportedCDataType(binding.value_type))
+    fn write_long(
+        &self,
+        source: &ParameterSource,
+        _rows: usize,
+    ) -> Result<Arc<dyn Array>, ArrowBindingError> {
+        Err(ArrowBindingError::UnsupportedCDataType(
+            source.binding.value_type,
+        ))
     }
 
-    fn write_char(&self, binding: &ParameterBinding) -> Result<Arc<dyn Array>, ArrowBindingError> {
-        Err(ArrowBindingError::UnsupportedCDataType(binding.value_type))
+    fn write_char(
+        &self,
+        source: &ParameterSource,
+        _rows: usize,
+    ) -> Result<Arc<dyn Array>, ArrowBindingError> {
+        Err(ArrowBindingError::UnsupportedCDataType(
+            source.binding.value_type,
+        ))
     }
 }
 
@@ -73,10 +156,16 @@ impl ArrowWriter for Writer<Int32Type> {
         DataType::Int32
     }
 
-    fn write_long(&self, binding: &ParameterBinding) -> Result<Arc<dyn Array>, ArrowBindingError> {
-        Ok(Arc::new(Int32Array::from(vec![unsafe {
-            std::ptr::read(binding.parameter_value_ptr as *const i32)
-        }])))
+    fn write_long(
+        &self,
+        source: &ParameterSource,
+        rows: usize,
+    ) -> Result<Arc<dyn Array>, ArrowBindingError> {
+        let values = (0..rows).map(|row| {
+            (!source.is_null(row))
+                .then(|| unsafe { std::ptr::read_unaligned(source.value_ptr::<i32>(row)) })
+        });
+        Ok(Arc::new(values.collect::<Int32Array>()))
     }
 }
 
@@ -85,27 +174,41 @@ impl ArrowWriter for Writer<Utf8Type> {
         DataType::Utf8
     }
 
-    fn write_char(&self, binding: &ParameterBinding) -> Result<Arc<dyn Array>, ArrowBindingError> {
-        let value = if binding.buffer_length == sql::NTS {
-            unsafe {
-                CStr::from_ptr(binding.parameter_value_ptr as *const c_char)
-                    .to_string_lossy()
-                    .to_string()
-            }
-        } else {
-            unsafe {
-                str::from_utf8(slice::from_raw_parts(
-                    binding.parameter_value_ptr as *const u8,
-                    binding.buffer_length as usize,
-                ))
-                .unwrap()
-                .to_string()
-            }
-        };
-        unsafe {
-            std::ptr::write(binding.str_len_or_ind_ptr, value.len() as sql::Len);
-        }
-        Ok(Arc::new(StringArray::from(vec![value])))
+    fn write_char(
+        &self,
+        source: &ParameterSource,
+        rows: usize,
+    ) -> Result<Arc<dyn Array>, ArrowBindingError> {
+        let buffer_length = source.binding.buffer_length;
+        let values = (0..rows).map(|row| {
+            let value_ptr = source.value_ptr::<u8>(row);
+            let bytes = match source.indicator(row) {
+                Some(sql::NULL_DATA) => return None,
+                // Never past the element, a longer length would read into the
+                // next parameter set
+                Some(length) if length >= 0 => {
+                    let length = if buffer_length > 0 {
+                        length.min(buffer_length)
+                    } else {
+                        length
+                    };
+                    unsafe { slice::from_raw_parts(value_ptr, length as usize) }
+                }
+                // Null-terminated, bounded by the element size when it is known
+                _ if buffer_length > 0 => {
+                    let element =
+                        unsafe { slice::from_raw_parts(value_ptr, buffer_length as usize) };
+                    let end = element
+                        .iter()
+                        .position(|b| *b == 0)
+                        .unwrap_or(element.len());
+                    &element[..end]
+                }
+                _ => unsafe { CStr::from_ptr(value_ptr as *const c_char).to_bytes() },
+            };
+            Some(String::from_utf8_lossy(bytes).into_owned())
+        });
+        Ok(Arc::new(values.collect::<StringArray>()))
     }
 }
 
@@ -119,8 +222,12 @@ fn arrow_writer_from_sql_type(
     }
 }
 
+/// Converts the bound parameters into a struct array with one row per
+/// parameter set, `paramset_size` rows in total.
 pub fn odbc_bindings_to_arrow_bindings(
     bindings: &HashMap<u16, ParameterBinding>,
+    paramset_size: usize,
+    param_bind_type: usize,
 ) -> Result<(Box<FFI_ArrowSchema>, Box<FFI_ArrowArray>), ArrowBindingError> {
     let mut schema_fields = Vec::new();
     let mut arrays = Vec::new();
@@ -139,15 +246,15 @@ pub fn odbc_bindings_to_arrow_bindings(
         schema_fields.push(arrow::datatypes::Field::new(
             format!("param_{param_num}"),
             writer.arrow_type(),
-            false,
+            true,
         ));
         arrays.push((
             Arc::new(arrow::datatypes::Field::new(
                 format!("param_{param_num}"),
                 writer.arrow_type(),
-                false,
+                true,
             )),
-            writer.write(binding)?,
+            writer.write(binding, paramset_size, param_bind_type)?,
         ));
     }
     let schema = arrow::datatypes::Schema::new(schema_fields);
@@ -156,3 +263,119 @@ pub fn odbc_bindings_to_arrow_bindings(
     let array = Box::new(arrow::ffi::FFI_ArrowArray::new(&array.into_data()));
     Ok((schema, array))
 }
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn binding(
+        parameter_type: sql::SqlDataType,
+        value_type: CDataType,
+        parameter_value_ptr: *mut u8,
+        buffer_length: sql::Len,
+        str_len_or_ind_ptr: *mut sql::Len,
+    ) -> ParameterBinding {
+        ParameterBinding {
+            parameter_type,
+            value_type,
+            parameter_value_ptr: parameter_value_ptr as sql::Pointer,
+            buffer_length,
+            str_len_or_ind_ptr,
+        }
+    }
+
+    #[test]
+    fn writes_column_wise_integer_array_with_nulls() {
+        let mut values = [1i32, 0, 3];
+        let mut indicators = [0, sql::NULL_DATA, 0];
+        let binding = binding(
+            sql::SqlDataType::INTEGER,
+            CDataType::Long,
+            values.as_mut_ptr() as *mut u8,
+            0,
+            indicators.as_mut_ptr(),
+        );
+        let array = Writer::<Int32Type>::new().write(&binding, 3, 0).unwrap();
+        assert_eq!(
+            array.as_any().downcast_ref::<Int32Array>().unwrap(),
+            &Int32Array::from(vec![Some(1), None, Some(3)])
+        );
+    }
+
+    #[test]
+    fn writes_row_wise_char_array() {
+        #[repr(C)]
+        struct Row {
+            name: [u8; 8],
+            name_len: sql::Len,
+        }
+        let mut rows = [
+            Row {
+                name: *b"alphabet",
+                name_len: 5,
+            },
+            Row {
+                name: *b"beta\0\0\0\0",
+                name_len: sql::NTS,
+            },
+            Row {
+                name: [0; 8],
+                name_len: sql::NULL_DATA,
+            },
+        ];
+        let rows_ptr = rows.as_mut_ptr() as *mut u8;
+        let binding = binding(
+            sql::SqlDataType::VARCHAR,
+            CDataType::Char,
+            rows_ptr,
+            8,
+            unsafe { rows_ptr.add(std::mem::offset_of!(Row, name_len)) as *mut sql::Len },
+        );
+        let array = Writer::<Utf8Type>::new()
+            .write(&binding, 3, std::mem::size_of::<Row>())
+            .unwrap();
+        assert_eq!(
+            array.as_any().downcast_ref::<StringArray>().unwrap(),
+            &StringArray::from(vec![Some("alpha"), Some("beta"), None])
+        );
+    }
+
+    #[test]
+    fn clamps_column_wise_char_lengths_to_the_element() {
+        let mut values = *b"abcdwxyz";
+        let mut indicators = [100, 2];
+        let binding = binding(
+            sql::SqlDataType::VARCHAR,
+            CDataType::Char,
+            values.as_mut_ptr(),
+            4,
+            indicators.as_mut_ptr(),
+        );
+        let array = Writer::<Utf8Type>::new().write(&binding, 2, 0).unwrap();
+        assert_eq!(
+            array.as_any().downcast_ref::<StringArray>().unwrap(),
+            &StringArray::from(vec!["abcd", "wx"])
+        );
+    }
+
+    #[test]
+    fn rejects_column_wise_char_arrays_without_element_size() {
+        let mut values = *b"ab\0cd\0";
+        let binding = binding(
+            sql::SqlDataType::VARCHAR,
+            CDataType::Char,
+            values.as_mut_ptr(),
+            0,
+            std::ptr::null_mut(),
+        );
+        assert!(matches!(
+            Writer::<Utf8Type>::new().write(&binding, 2, 0),
+            Err(ArrowBindingError::InvalidBufferLength(0))
+        ));
+        let single = Writer::<Utf8Type>::new().write(&binding, 1, 0).unwrap();
+        assert_eq!(
+            single.as_any().downcast_ref::<StringArray>().unwrap(),
+            &StringArray::from(vec!["ab"])
+        );
+    }
+}
@@ -166,3 +166,37 @@ TEST_CASE("Test at limits", "[datatype][number]") {
   test_at_limits<SQL_C_UBIGINT>(conn);
   test_string_at_limits(conn);
 }
+
+TEST_CASE("Test decimal column description", "[datatype][number]") {
+  Connection conn;
+  auto random_schema = Schema::use_random_schema(conn);
+  conn.execute("DROP TABLE IF EXISTS test_number_describe");
+  conn.execute("CREATE TABLE test_number_describe (dec20 DECIMAL(20,2))");
+
+  auto stmt = conn.execute("SELECT * FROM test_number_describe");
+
+  SQLSMALLINT num_cols = 0;
+  SQLRETURN ret = SQLNumResultCols(stmt.getHandle(), &num_cols);
+  CHECK_ODBC(ret, stmt);
+  REQUIRE(num_cols == 1);
+
+  SQLCHAR name[64];
+  SQLSMALLINT name_length = 0;
+  SQLSMALLINT data_type = 0;
+  SQLULEN column_size = 0;
+  SQLSMALLINT decimal_digits = 0;
+  SQLSMALLINT nullable = 0;
+  ret = SQLDescribeCol(stmt.getHandle(), 1, name, sizeof(name), &name_length, &data_type,
+                       &column_size, &decimal_digits, &nullable);
+  CHECK_ODBC(ret, stmt);
+  CHECK(std::string(reinterpret_cast<char*>(name), name_length) == "DEC20");
+  CHECK(data_type == SQL_DECIMAL);
+  CHECK(column_size == 20);
+  CHECK(decimal_digits == 2);
+  CHECK(nullable == SQL_NULLABLE);
+
+  SQLLEN scale = 0;
+  ret = SQLColAttribute(stmt.getHandle(), 1, SQL_DESC_SCALE, NULL, 0, NULL, &scale);
+  CHECK_ODBC(ret, stmt);
+  CHECK(scale == 2);
+}
@@ -0,0 +1,53 @@
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "Connection.hpp"
+
+TEST_CASE("should fetch rowsets into column-wise bound arrays", "[block_cursor]") {
+  // Given Snowflake client is logged in
+  Connection conn;
+  auto stmt = conn.createStatement();
+
+  // And a rowset size of 1000 rows with a bound column, rows fetched pointer and row status array
+  const SQLULEN rowset_size = 1000;
+  std::vector<SQLINTEGER> ids(rowset_size);
+  std::vector<SQLLEN> indicators(rowset_size);
+  std::vector<SQLUSMALLINT> row_status(rowset_size);
+  SQLULEN rows_fetched = 0;
+
+  SQLRETURN ret =
+      SQLSetStmtAttr(stmt.getHandle(), SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER)rowset_size, 0);
+  CHECK_ODBC(ret, stmt);
+  ret = SQLSetStmtAttr(stmt.getHandle(), SQL_ATTR_ROWS_FETCHED_PTR, &rows_fetched, 0);
+  CHECK_ODBC(ret, stmt);
+  ret = SQLSetStmtAttr(stmt.getHandle(), SQL_ATTR_ROW_STATUS_PTR, row_status.data(), 0);
+  CHECK_ODBC(ret, stmt);
+  ret = SQLBindCol(stmt.getHandle(), 1, SQL_C_LONG, ids.data(), sizeof(SQLINTEGER),
+                   indicators.data());
+  CHECK_ODBC(ret, stmt);
+
+  // When a query returning 2500 sequential rows is executed
+  const auto sql = "SELECT seq4() as id FROM TABLE(GENERATOR(ROWCOUNT => 2500)) v ORDER BY id";
+  ret = SQLExecDirect(stmt.getHandle(), (SQLCHAR*)sql, SQL_NTS);
+  CHECK_ODBC(ret, stmt);
+
+  // Then the rows arrive in rowsets of 1000, 1000 and 500 rows
+  std::vector<SQLULEN> rowset_sizes;
+  SQLINTEGER expected_value = 0;
+  while ((ret = SQLFetch(stmt.getHandle())) != SQL_NO_DATA) {
+    CHECK_ODBC(ret, stmt);
+    rowset_sizes.push_back(rows_fetched);
+    for (SQLULEN i = 0; i < rowset_size; i++) {
+      if (i < rows_fetched) {
+        REQUIRE(row_status[i] == SQL_ROW_SUCCESS);
+        REQUIRE(indicators[i] == sizeof(SQLINTEGER));
+        REQUIRE(ids[i] == expected_value++);
+      } else {
+        REQUIRE(row_status[i] == SQL_ROW_NOROW);
+      }
+    }
+  }
+  REQUIRE(rowset_sizes == std::vector<SQLULEN>{1000, 1000, 500});
+  REQUIRE(expected_value == 2500);
+}
@@ -0,0 +1,138 @@
+#include <string>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "Connection.hpp"
+#include "get_diag_rec.hpp"
+
+TEST_CASE("should count parameters of a prepared statement", "[prepared_statement]") {
+  // Given Snowflake client is logged in
+  Connection conn;
+  auto stmt = conn.createStatement();
+
+  // When a query with two parameter markers is prepared
+  SQLRETURN ret = SQLPrepare(stmt.getHandle(), (SQLCHAR*)"SELECT ? AS a, ? AS b", SQL_NTS);
+  CHECK_ODBC(ret, stmt);
+
+  // Then SQLNumParams reports both parameters
+  SQLSMALLINT param_count = -1;
+  ret = SQLNumParams(stmt.getHandle(), &param_count);
+  CHECK_ODBC(ret, stmt);
+  REQUIRE(param_count == 2);
+}
+
+TEST_CASE("should count parameters after direct execution", "[prepared_statement]") {
+  // Given Snowflake client is logged in
+  Connection conn;
+  auto stmt = conn.createStatement();
+
+  // When a query without parameters is executed directly
+  SQLRETURN ret = SQLExecDirect(stmt.getHandle(), (SQLCHAR*)"SELECT 1", SQL_NTS);
+  CHECK_ODBC(ret, stmt);
+
+  // Then SQLNumParams succeeds and reports no parameters
+  SQLSMALLINT param_count = -1;
+  ret = SQLNumParams(stmt.getHandle(), &param_count);
+  CHECK_ODBC(ret, stmt);
+  REQUIRE(param_count == 0);
+}
+
+TEST_CASE("should describe result columns before execution", "[prepared_statement]") {
+  // Given Snowflake client is logged in
+  Connection conn;
+  auto stmt = conn.createStatement();
+
+  // When a query is prepared but not executed
+  SQLRETURN ret =
+      SQLPrepare(stmt.getHandle(), (SQLCHAR*)"SELECT 1::NUMBER(10, 2) AS amount, 'x' AS name", SQL_NTS);
+  CHECK_ODBC(ret, stmt);
+
+  // Then the result columns are already known
+  SQLSMALLINT column_count = 0;
+  ret = SQLNumResultCols(stmt.getHandle(), &column_count);
+  CHECK_ODBC(ret, stmt);
+  REQUIRE(column_count == 2);
+
+  // And SQLDescribeCol reports their names, types and sizes
+  SQLCHAR name[64];
+  SQLSMALLINT name_length = 0;
+  SQLSMALLINT data_type = 0;
+  SQLULEN column_size = 0;
+  SQLSMALLINT decimal_digits = 0;
+  SQLSMALLINT nullable = 0;
+  ret = SQLDescribeCol(stmt.getHandle(), 1, name, sizeof(name), &name_length, &data_type,
+                       &column_size, &decimal_digits, &nullable);
+  CHECK_ODBC(ret, stmt);
+  REQUIRE(std::string((char*)name, name_length) == "AMOUNT");
+  REQUIRE(data_type == SQL_DECIMAL);
+  REQUIRE(column_size == 10);
+  REQUIRE(decimal_digits == 2);
+
+  ret = SQLDescribeCol(stmt.getHandle(), 2, name, sizeof(name), &name_length, &data_type,
+                       &column_size, &decimal_digits, &nullable);
+  CHECK_ODBC(ret, stmt);
+  REQUIRE(std::string((char*)name, name_length) == "NAME");
+  REQUIRE(data_type == SQL_VARCHAR);
+}
+
+TEST_CASE("should describe date and timestamp columns", "[prepared_statement]") {
+  // Given Snowflake client is logged in
+  Connection conn;
+  auto stmt = conn.createStatement();
+
+  // When a query returning a DATE and a TIMESTAMP_NTZ column is prepared
+  const std::string query = "SELECT '2024-01-02'::DATE AS d, '2024-01-02'::TIMESTAMP_NTZ(3) AS ts";
+  SQLRETURN ret = SQLPrepare(stmt.getHandle(), (SQLCHAR*)query.c_str(), SQL_NTS);
+  CHECK_ODBC(ret, stmt);
+
+  // Then SQLDescribeCol reports their ODBC date and time types
+  SQLCHAR name[64];
+  SQLSMALLINT name_length = 0;
+  SQLSMALLINT data_type = 0;
+  SQLULEN column_size = 0;
+  SQLSMALLINT decimal_digits = 0;
+  SQLSMALLINT nullable = 0;
+  ret = SQLDescribeCol(stmt.getHandle(), 1, name, sizeof(name), &name_length, &data_type,
+                       &column_size, &decimal_digits, &nullable);
+  CHECK_ODBC(ret, stmt);
+  REQUIRE(data_type == SQL_TYPE_DATE);
+  REQUIRE(column_size == 10);
+
+  ret = SQLDescribeCol(stmt.getHandle(), 2, name, sizeof(name), &name_length, &data_type,
+                       &column_size, &decimal_digits, &nullable);
+  CHECK_ODBC(ret, stmt);
+  REQUIRE(data_type == SQL_TYPE_TIMESTAMP);
+  REQUIRE(column_size == 23);
+  REQUIRE(decimal_digits == 3);
+}
+
+TEST_CASE("should warn when a column name does not fit the buffer", "[prepared_statement]") {
+  // Given Snowflake client is logged in
+  Connection conn;
+  auto stmt = conn.createStatement();
+
+  // When a column is described into a name buffer shorter than its name
+  SQLRETURN ret = SQLPrepare(stmt.getHandle(), (SQLCHAR*)"SELECT 1::NUMBER(10, 2) AS amount", SQL_NTS);
+  CHECK_ODBC(ret, stmt);
+  SQLCHAR name[4];
+  SQLSMALLINT name_length = 0;
+  SQLSMALLINT data_type = 0;
+  SQLULEN column_size = 0;
+  SQLSMALLINT decimal_digits = 0;
+  SQLSMALLINT nullable = 0;
+  ret = SQLDescribeCol(stmt.getHandle(), 1, name, sizeof(name), &name_length, &data_type,
+                       &column_size, &decimal_digits, &nullable);
+
+  // Then the truncated name comes with a 01004 warning
+  REQUIRE(ret == SQL_SUCCESS_WITH_INFO);
+  REQUIRE(std::string((char*)name) == "AMO");
+  REQUIRE(name_length == 6);
+  auto records = get_diag_rec(stmt);
+  REQUIRE(records.size() == 1);
+  CHECK(records[0].sqlState == "01004");
+
+  // And the other outputs are still written
+  REQUIRE(data_type == SQL_DECIMAL);
+  REQUIRE(column_size == 10);
+  REQUIRE(decimal_digits == 2);
+}
@@ -83,10 +83,15 @@ impl RustGenerator {
             }
 
             // Generate client structs
-            for service in file.service {
+            for service in file.service.clone() {
                 content += &self.generate_client_struct(&service, &package);
             }
 
+            // Generate in-process client structs
+            for service in file.service {
+                content += &self.generate_local_client_struct(&service, &package);
+            }
+
             result.add_file(
                 PathBuf::from(format!(r#"{package}.rs"#)),
                 GeneratedFile::new(content),
@@ -269,6 +274,88 @@ impl<T: Transport> {service_name}Client<T> {{
         content
     }
 
+    /// Generate a client that calls a service implementation directly, without
+    /// encoding messages
+    fn generate_local_client_struct(
+        &self,
+        service: &crate::protobuf::ServiceDescriptorProto,
+        package: &str,
+    ) -> String {
+        let service_name = service.name.as_ref().unwrap_or(&String::new()).clone();
+        let service_error = service
+            .options
+            .as_ref()
+            .unwrap_or(&Default::default())
+            .service_error
+            .clone();
+
+        let mut content = format!(
+            r#"pub struct {service_name}LocalClient<S: {service_name}> {{
+	_marker: ::core::marker::PhantomData<S>,
+}}
+impl<S: {service_name}> {service_name}LocalClient<S> {{
+"#
+        );
+
+        for method in &service.method {
+            content += &self.generate_local_client_method(method, &service_error, package);
+        }
+
+        content += "}\n";
+        content
+    }
+
+    /// Generate an in-process client method implementation
+    fn generate_local_client_method(
+        &self,
+        method: &crate::protobuf::MethodDescriptorProto,
+        service_error: &Option<String>,
+        package: &str,
+    ) -> String {
+        let method_error = method
+            .options
+            .as_ref()
+            .unwrap_or(&Default::default())
+            .method_error
+            .clone()
+            .or_else(|| service_error.clone());
+
+        let input_type = to_rust_message_name(
+            &package.to_string(),
+            &method.input_type.as_ref().unwrap_or(&String::new()).clone(),
+        );
+        let output_type = to_rust_message_name(
+            &package.to_string(),
+            &method
+                .output_type
+                .as_ref()
+                .unwrap_or(&String::new())
+                .clone(),
+        );
+        let name = camel_to_snake_case(method.name.as_ref().unwrap_or(&String::new()));
+
+        match method_error {
+            Some(error) => {
+                format!(
+                    r#"
+    pub fn {name}(input: {input_type}) -> Result<{output_type}, ProtoError<{error}>> {{
+        S::{name}(input).map_err(ProtoError::Application)
+    }}
+"#
+                )
+            }
+            None => {
+                format!(
+                    r#"
+    pub fn {name}(input: {input_type}) -> {output_type} {{
+        S::{name}(input)
+    }}
+"#
+                )
+            }
+        }
+    }
+
     /// Generate a client method implementation
     fn generate_client_method(
         &self,
@@ -25,7 +25,7 @@ _sym_db = _symbol_database.Default()
 from google.protobuf import descriptor_pb2 as google_dot_protobuf_dot_descriptor__pb2
 
 
-DESCRIPTOR = _descriptor_pool.Default().AddSerializedFile(b'\n\x18\x64\x61tabase_driver_v1.proto\x12\x12\x64\x61tabase_driver_v1\x1a google/protobuf/descriptor.proto\")\n\x0b\x45rrorDetail\x12\x0b\n\x03key\x18\x01 \x01(\t\x12\r\n\x05value\x18\x02 \x01(\t\"%\n\x13\x41uthenticationError\x12\x0e\n\x06\x64\x65tail\x18\x01 \x01(\t\"\x0e\n\x0cGenericError\"\x0f\n\rInternalError\"+\n\nLoginError\x12\x0f\n\x07message\x18\x01 \x01(\t\x12\x0c\n\x04\x63ode\x18\x02 \x01(\x05\"%\n\x10MissingParameter\x12\x11\n\tparameter\x18\x01 \x01(\t\"c\n\x15InvalidParameterValue\x12\x11\n\tparameter\x18\x01 \x01(\t\x12\r\n\x05value\x18\x02 \x01(\t\x12\x18\n\x0b\x65xplanation\x18\x03 \x01(\tH\x00\x88\x01\x01\x42\x0e\n\x0c_explanation\"\x9a\x03\n\x0b\x44riverError\x12=\n\nauth_error\x18\x01 \x01(\x0b\x32\'.database_driver_v1.AuthenticationErrorH\x00\x12\x39\n\rgeneric_error\x18\x02 \x01(\x0b\x32 .database_driver_v1.GenericErrorH\x00\x12;\n\x0einternal_error\x18\x03 \x01(\x0b\x32!.database_driver_v1.InternalErrorH\x00\x12\x41\n\x11missing_parameter\x18\x04 \x01(\x0b\x32$.database_driver_v1.MissingParameterH\x00\x12L\n\x17invalid_parameter_value\x18\x05 \x01(\x0b\x32).database_driver_v1.InvalidParameterValueH\x00\x12\x35\n\x0blogin_error\x18\x06 \x01(\x0b\x32\x1e.database_driver_v1.LoginErrorH\x00\x42\x0c\n\nerror_type\"\x97\x01\n\x0f\x44riverException\x12\x0f\n\x07message\x18\x01 \x01(\t\x12\x33\n\x0bstatus_code\x18\x02 \x01(\x0e\x32\x1e.database_driver_v1.StatusCode\x12.\n\x05\x65rror\x18\x03 \x01(\x0b\x32\x1f.database_driver_v1.DriverError\x12\x0e\n\x06report\x18\x04 \x01(\t\"_\n\rExecuteResult\x12\x37\n\x06stream\x18\x01 \x01(\x0b\x32\'.database_driver_v1.ArrowArrayStreamPtr\x12\x15\n\rrows_affected\x18\x02 \x01(\x03\"N\n\x11PartitionedResult\x12\x0e\n\x06schema\x18\x01 \x01(\x03\x12\x12\n\npartitions\x18\x02 \x03(\x0c\x12\x15\n\rrows_affected\x18\x03 \x01(\x03\"+\n\x0e\x44\x61tabaseHandle\x12\n\n\x02id\x18\x01 \x01(\x03\x12\r\n\x05magic\x18\x02 \x01(\x03\"-\n\x10\x43onnectionHandle\x12\n\n\x02id\x18\x01 \x01(\x03\x12\r\n\x05magic\x18\x02 \x01(\x03\",\n\x0fStatementHandle\x12\n\n\x02id\x18\x01 \x01(\x03\x12\r\n\x05magic\x18\x02 \x01(\x03\"$\n\x13\x41rrowArrayStreamPtr\x12\r\n\x05value\x18\x01 \x01(\x0c\"\x1f\n\x0e\x41rrowSchemaPtr\x12\r\n\x05value\x18\x01 \x01(\x0c\"\x1e\n\rArrowArrayPtr\x12\r\n\x05value\x18\x01 \x01(\x0c\"\x14\n\x12\x44\x61tabaseNewRequest\"L\n\x13\x44\x61tabaseNewResponse\x12\x35\n\tdb_handle\x18\x01 \x01(\x0b\x32\".database_driver_v1.DatabaseHandle\"s\n\x1e\x44\x61tabaseSetOptionStringRequest\x12\x35\n\tdb_handle\x18\x01 \x01(\x0b\x32\".database_driver_v1.DatabaseHandle\x12\x0b\n\x03key\x18\x02 \x01(\t\x12\r\n\x05value\x18\x03 \x01(\t\"!\n\x1f\x44\x61tabaseSetOptionStringResponse\"r\n\x1d\x44\x61tabaseSetOptionBytesRequest\x12\x35\n\tdb_handle\x18\x01 \x01(\x0b\x32\".database_driver_v1.DatabaseHandle\x12\x0b\n\x03key\x18\x02 \x01(\t\x12\r\n\x05value\x18\x03 \x01(\x0c\" \n\x1e\x44\x61tabaseSetOptionBytesResponse\"p\n\x1b\x44\x61tabaseSetOptionIntRequest\x12\x35\n\tdb_handle\x18\x01 \x01(\x0b\x32\".database_driver_v1.DatabaseHandle\x12\x0b\n\x03key\x18\x02 \x01(\t\x12\r\n\x05value\x18\x03 \x01(\x03\"\x1e\n\x1c\x44\x61tabaseSetOptionIntResponse\"s\n\x1e\x44\x61tabaseSetOptionDoubleRequest\x12\x35\n\tdb_handle\x18\x01 \x01(\x0b\x32\".database_driver_v1.DatabaseHandle\x12\x0b\n\x03key\x18\x02 \x01(\t\x12\r\n\x05value\x18\x03 \x01(\x01\"!\n\x1f\x44\x61tabaseSetOptionDoubleResponse\"L\n\x13\x44\x61tabaseInitRequest\x12\x35\n\tdb_handle\x18\x01 \x01(\x0b\x32\".database_driver_v1.DatabaseHandle\"\x16\n\x14\x44\x61tabaseInitResponse\"O\n\x16\x44\x61tabaseReleaseRequest\x12\x35\n\tdb_handle\x18\x01 \x01(\x0b\x32\".database_driver_v1.DatabaseHandle\"\x19\n\x17\x44\x61tabaseReleaseResponse\"\x16\n\x14\x43onnectionNewRequest\"R\n\x15\x43onnectionNewResponse\x12\x39\n\x0b\x63onn_handle\x18\x01 \x01(\x0b\x32$.database_driver_v1.ConnectionHandle\"y\n ConnectionSetOptionStringRequest\x12\x39\n\x0b\x63onn_handle\x18\x01 \x01(\x0b\x32$.database_driver_v1.ConnectionHandle\x12\x0b\n\x03key\x18\x02 \x01(\t\x12\r\n\x05value\x18\x03 \x01(\t\"#\n!ConnectionSetOptionStringResponse\"x\n\x1f\x43onnectionSetOptionBytesRequest\x12\x39\n\x0b\x63onn_handle\x18\x01 \x01(\x0b\x32$.database_driver_v1.ConnectionHandle\x12\x0b\n\x03key\x18\x02 \x01(\t\x12\r\n\x05value\x18\x03 \x01(\x0c\"\"\n ConnectionSetOptionBytesResponse\"v\n\x1d\x43onnectionSetOptionIntRequest\x12\x39\n\x0b\x63onn_handle\x18\x01 \x01(\x0b\x32$.database_driver_v1.ConnectionHandle\x12\x0b\n\x03key\x18\x02 \x01(\t\x12\r\n\x05value\x18\x03 \x01(\x03\" \n\x1e\x43onnectionSetOptionIntResponse\"y\n ConnectionSetOptionDoubleRequest\x12\x39\n\x0b\x63onn_handle\x18\x01 \x01(\x0b\x32$.database_driver_v1.ConnectionHandle\x12\x0b\n\x03key\x18\x02 \x01(\t\x12\r\n\x05value\x18\x03 \x01(\x01\"#\n!ConnectionSetOptionDoubleResponse\"\x89\x01\n\x15\x43onnectionInitRequest\x12\x39\n\x0b\x63onn_handle\x18\x01 \x01(\x0b\x32$.database_driver_v1.ConnectionHandle\x12\x35\n\tdb_handle\x18\x02 \x01(\x0b\x32\".database_driver_v1.DatabaseHandle\"\x18\n\x16\x43onnectionInitResponse\"U\n\x18\x43onnectionReleaseRequest\x12\x39\n\x0b\x63onn_handle\x18\x01 \x01(\x0b\x32$.database_driver_v1.ConnectionHandle\"\x1b\n\x19\x43onnectionReleaseResponse\"\x87\x01\n\x18\x43onnectionGetInfoRequest\x12\x39\n\x0b\x63onn_handle\x18\x01 \x01(\x0b\x32$.database_driver_v1.ConnectionHandle\x12\x30\n\ninfo_codes\x18\x02 \x03(\x0e\x32\x1c.database_driver_v1.InfoCode\".\n\x19\x43onnectionGetInfoResponse\x12\x11\n\tinfo_data\x18\x01 \x01(\x0c\"\x95\x02\n\x1b\x43onnectionGetObjectsRequest\x12\x39\n\x0b\x63onn_handle\x18\x01 \x01(\x0b\x32$.database_driver_v1.ConnectionHandle\x12\r\n\x05\x64\x65pth\x18\x02 \x01(\x05\x12\x14\n\x07\x63\x61talog\x18\x03 \x01(\tH\x00\x88\x01\x01\x12\x16\n\tdb_schema\x18\x04 \x01(\tH\x01\x88\x01\x01\x12\x17\n\ntable_name\x18\x05 \x01(\tH\x02\x88\x01\x01\x12\x12\n\ntable_type\x18\x06 \x03(\t\x12\x18\n\x0b\x63olumn_name\x18\x07 \x01(\tH\x03\x88\x01\x01\x42\n\n\x08_catalogB\x0c\n\n_db_schemaB\r\n\x0b_table_nameB\x0e\n\x0c_column_name\"4\n\x1c\x43onnectionGetObjectsResponse\x12\x14\n\x0cobjects_data\x18\x01 \x01(\x0c\"\xb8\x01\n\x1f\x43onnectionGetTableSchemaRequest\x12\x39\n\x0b\x63onn_handle\x18\x01 \x01(\x0b\x32$.database_driver_v1.ConnectionHandle\x12\x14\n\x07\x63\x61talog\x18\x02 \x01(\tH\x00\x88\x01\x01\x12\x16\n\tdb_schema\x18\x03 \x01(\tH\x01\x88\x01\x01\x12\x12\n\ntable_name\x18\x04 \x01(\tB\n\n\x08_catalogB\x0c\n\n_db_schema\"7\n ConnectionGetTableSchemaResponse\x12\x13\n\x0bschema_data\x18\x01 \x01(\x0c\"[\n\x1e\x43onnectionGetTableTypesRequest\x12\x39\n\x0b\x63onn_handle\x18\x01 \x01(\x0b\x32$.database_driver_v1.ConnectionHandle\";\n\x1f\x43onnectionGetTableTypesResponse\x12\x18\n\x10table_types_data\x18\x01 \x01(\x0c\"T\n\x17\x43onnectionCommitRequest\x12\x39\n\x0b\x63onn_handle\x18\x01 \x01(\x0b\x32$.database_driver_v1.ConnectionHandle\"\x1a\n\x18\x43onnectionCommitResponse\"V\n\x19\x43onnectionRollbackRequest\x12\x39\n\x0b\x63onn_handle\x18\x01 \x01(\x0b\x32$.database_driver_v1.ConnectionHandle\"\x1c\n\x1a\x43onnectionRollbackResponse\"P\n\x13StatementNewRequest\x12\x39\n\x0b\x63onn_handle\x18\x01 \x01(\x0b\x32$.database_driver_v1.ConnectionHandle\"P\n\x14StatementNewResponse\x12\x38\n\x0bstmt_handle\x18\x01 \x01(\x0b\x32#.database_driver_v1.StatementHandle\"S\n\x17StatementReleaseRequest\x12\x38\n\x0bstmt_handle\x18\x01 \x01(\x0b\x32#.database_driver_v1.StatementHandle\"\x1a\n\x18StatementReleaseResponse\"f\n\x1bStatementSetSqlQueryRequest\x12\x38\n\x0bstmt_handle\x18\x01 \x01(\x0b\x32#.database_driver_v1.StatementHandle\x12\r\n\x05query\x18\x02 \x01(\t\"\x1e\n\x1cStatementSetSqlQueryResponse\"j\n StatementSetSubstraitPlanRequest\x12\x38\n\x0bstmt_handle\x18\x01 \x01(\x0b\x32#.database_driver_v1.StatementHandle\x12\x0c\n\x04plan\x18\x02 \x01(\x0c\"#\n!StatementSetSubstraitPlanResponse\"S\n\x17StatementPrepareRequest\x12\x38\n\x0bstmt_handle\x18\x01 \x01(\x0b\x32#.database_driver_v1.StatementHandle\"\x1a\n\x18StatementPrepareResponse\"w\n\x1fStatementSetOptionStringRequest\x12\x38\n\x0bstmt_handle\x18\x01 \x01(\x0b\x32#.database_driver_v1.StatementHandle\x12\x0b\n\x03key\x18\x02 \x01(\t\x12\r\n\x05value\x18\x03 \x01(\t\"\"\n StatementSetOptionStringResponse\"v\n\x1eStatementSetOptionBytesRequest\x12\x38\n\x0bstmt_handle\x18\x01 \x01(\x0b\x32#.database_driver_v1.StatementHandle\x12\x0b\n\x03key\x18\x02 \x01(\t\x12\r\n\x05value\x18\x03 \x01(\x0c\"!\n\x1fStatementSetOptionBytesResponse\"t\n\x1cStatementSetOptionIntRequest\x12\x38\n\x0bstmt_handle\x18\x01 \x01(\x0b\x32#.database_driver_v1.StatementHandle\x12\x0b\n\x03key\x18\x02 \x01(\t\x12\r\n\x05value\x18\x03 \x01(\x03\"\x1f\n\x1dStatementSetOptionIntResponse\"w\n\x1fStatementSetOptionDoubleRequest\x12\x38\n\x0bstmt_handle\x18\x01 \x01(\x0b\x32#.database_driver_v1.StatementHandle\x12\x0b\n\x03key\x18\x02 \x01(\t\x12\r\n\x05value\x18\x03 \x01(\x01\"\"\n StatementSetOptionDoubleResponse\"^\n\"StatementGetParameterSchemaRequest\x12\x38\n\x0bstmt_handle\x18\x01 \x01(\x0b\x32#.database_driver_v1.StatementHandle\"Y\n#StatementGetParameterSchemaResponse\x12\x32\n\x06schema\x18\x01 \x01(\x0b\x32\".database_driver_v1.ArrowSchemaPtr\"\xb6\x01\n\x14StatementBindRequest\x12\x38\n\x0bstmt_handle\x18\x01 \x01(\x0b\x32#.database_driver_v1.StatementHandle\x12\x32\n\x06schema\x18\x02 \x01(\x0b\x32\".database_driver_v1.ArrowSchemaPtr\x12\x30\n\x05\x61rray\x18\x03 \x01(\x0b\x32!.database_driver_v1.ArrowArrayPtr\"\x17\n\x15StatementBindResponse\"f\n\x1aStatementBindStreamRequest\x12\x38\n\x0bstmt_handle\x18\x01 \x01(\x0b\x32#.database_driver_v1.StatementHandle\x12\x0e\n\x06stream\x18\x02 \x01(\x0c\"\x1d\n\x1bStatementBindStreamResponse\"X\n\x1cStatementExecuteQueryRequest\x12\x38\n\x0bstmt_handle\x18\x01 \x01(\x0b\x32#.database_driver_v1.StatementHandle\"R\n\x1dStatementExecuteQueryResponse\x12\x31\n\x06result\x18\x01 \x01(\x0b\x32!.database_driver_v1.ExecuteResult\"]\n!StatementExecutePartitionsRequest\x12\x38\n\x0bstmt_handle\x18\x01 \x01(\x0b\x32#.database_driver_v1.StatementHandle\"[\n\"StatementExecutePartitionsResponse\x12\x35\n\x06result\x18\x01 \x01(\x0b\x32%.database_driver_v1.PartitionedResult\"w\n\x1dStatementReadPartitionRequest\x12\x38\n\x0bstmt_handle\x18\x01 \x01(\x0b\x32#.database_driver_v1.StatementHandle\x12\x1c\n\x14partition_descriptor\x18\x02 \x01(\x0c\":\n\x1eStatementReadPartitionResponse\x12\x18\n\x10partition_stream\x18\x01 \x01(\x03*\xb4\x04\n\nStatusCode\x12\x1b\n\x17STATUS_CODE_UNSPECIFIED\x10\x00\x12\x12\n\x0eSTATUS_CODE_OK\x10\x01\x12$\n STATUS_CODE_AUTHENTICATION_ERROR\x10\x02\x12\x1f\n\x1bSTATUS_CODE_NOT_IMPLEMENTED\x10\x03\x12\x19\n\x15STATUS_CODE_NOT_FOUND\x10\x04\x12\x1e\n\x1aSTATUS_CODE_ALREADY_EXISTS\x10\x05\x12 \n\x1cSTATUS_CODE_INVALID_ARGUMENT\x10\x06\x12\x1d\n\x19STATUS_CODE_INVALID_STATE\x10\x07\x12\x1c\n\x18STATUS_CODE_INVALID_DATA\x10\x08\x12\x12\n\x0eSTATUS_CODE_IO\x10\t\x12\x19\n\x15STATUS_CODE_CANCELLED\x10\n\x12\x1f\n\x1bSTATUS_CODE_UNAUTHENTICATED\x10\x0b\x12\x1c\n\x18STATUS_CODE_UNAUTHORIZED\x10\x0c\x12\x1d\n\x19STATUS_CODE_GENERIC_ERROR\x10\r\x12\x1e\n\x1aSTATUS_CODE_INTERNAL_ERROR\x10\x0e\x12!\n\x1dSTATUS_CODE_MISSING_PARAMETER\x10\x0f\x12\'\n#STATUS_CODE_INVALID_PARAMETER_VALUE\x10\x10\x12\x1b\n\x17STATUS_CODE_LOGIN_ERROR\x10\x11*\x98\x03\n\x08InfoCode\x12\x19\n\x15INFO_CODE_UNSPECIFIED\x10\x00\x12\x19\n\x15INFO_CODE_VENDOR_NAME\x10\x01\x12\x1c\n\x18INFO_CODE_VENDOR_VERSION\x10\x02\x12\"\n\x1eINFO_CODE_VENDOR_ARROW_VERSION\x10\x03\x12\x18\n\x14INFO_CODE_VENDOR_SQL\x10\x65\x12\x1e\n\x1aINFO_CODE_VENDOR_SUBSTRAIT\x10\x66\x12*\n&INFO_CODE_VENDOR_SUBSTRAIT_MIN_VERSION\x10g\x12*\n&INFO_CODE_VENDOR_SUBSTRAIT_MAX_VERSION\x10h\x12\x1a\n\x15INFO_CODE_DRIVER_NAME\x10\xc9\x01\x12\x1d\n\x18INFO_CODE_DRIVER_VERSION\x10\xca\x01\x12#\n\x1eINFO_CODE_DRIVER_ARROW_VERSION\x10\xcb\x01\x12\"\n\x1dINFO_CODE_DRIVER_ADBC_VERSION\x10\xcc\x01\x32\xef!\n\x0e\x44\x61tabaseDriver\x12^\n\x0b\x44\x61tabaseNew\x12&.database_driver_v1.DatabaseNewRequest\x1a\'.database_driver_v1.DatabaseNewResponse\x12\x82\x01\n\x17\x44\x61tabaseSetOptionString\x12\x32.database_driver_v1.DatabaseSetOptionStringRequest\x1a\x33.database_driver_v1.DatabaseSetOptionStringResponse\x12\x7f\n\x16\x44\x61tabaseSetOptionBytes\x12\x31.database_driver_v1.DatabaseSetOptionBytesRequest\x1a\x32.database_driver_v1.DatabaseSetOptionBytesResponse\x12y\n\x14\x44\x61tabaseSetOptionInt\x12/.database_driver_v1.DatabaseSetOptionIntRequest\x1a\x30.database_driver_v1.DatabaseSetOptionIntResponse\x12\x82\x01\n\x17\x44\x61tabaseSetOptionDouble\x12\x32.database_driver_v1.DatabaseSetOptionDoubleRequest\x1a\x33.database_driver_v1.DatabaseSetOptionDoubleResponse\x12\x61\n\x0c\x44\x61tabaseInit\x12\'.database_driver_v1.DatabaseInitRequest\x1a(.database_driver_v1.DatabaseInitResponse\x12j\n\x0f\x44\x61tabaseRelease\x12*.database_driver_v1.DatabaseReleaseRequest\x1a+.database_driver_v1.DatabaseReleaseResponse\x12\x64\n\rConnectionNew\x12(.database_driver_v1.ConnectionNewRequest\x1a).database_driver_v1.ConnectionNewResponse\x12\x88\x01\n\x19\x43onnectionSetOptionString\x12\x34.database_driver_v1.ConnectionSetOptionStringRequest\x1a\x35.database_driver_v1.ConnectionSetOptionStringResponse\x12\x85\x01\n\x18\x43onnectionSetOptionBytes\x12\x33.database_driver_v1.ConnectionSetOptionBytesRequest\x1a\x34.database_driver_v1.ConnectionSetOptionBytesResponse\x12\x7f\n\x16\x43onnectionSetOptionInt\x12\x31.database_driver_v1.ConnectionSetOptionIntRequest\x1a\x32.database_driver_v1.ConnectionSetOptionIntResponse\x12\x88\x01\n\x19\x43onnectionSetOptionDouble\x12\x34.database_driver_v1.ConnectionSetOptionDoubleRequest\x1a\x35.database_driver_v1.ConnectionSetOptionDoubleResponse\x12g\n\x0e\x43onnectionInit\x12).database_driver_v1.ConnectionInitRequest\x1a*.database_driver_v1.ConnectionInitResponse\x12p\n\x11\x43onnectionRelease\x12,.database_driver_v1.ConnectionReleaseRequest\x1a-.database_driver_v1.ConnectionReleaseResponse\x12p\n\x11\x43onnectionGetInfo\x12,.database_driver_v1.ConnectionGetInfoRequest\x1a-.database_driver_v1.ConnectionGetInfoResponse\x12y\n\x14\x43onnectionGetObjects\x12/.database_driver_v1.ConnectionGetObjectsRequest\x1a\x30.database_driver_v1.ConnectionGetObjectsResponse\x12\x85\x01\n\x18\x43onnectionGetTableSchema\x12\x33.database_driver_v1.ConnectionGetTableSchemaRequest\x1a\x34.database_driver_v1.ConnectionGetTableSchemaResponse\x12\x82\x01\n\x17\x43onnectionGetTableTypes\x12\x32.database_driver_v1.ConnectionGetTableTypesRequest\x1a\x33.database_driver_v1.ConnectionGetTableTypesResponse\x12m\n\x10\x43onnectionCommit\x12+.database_driver_v1.ConnectionCommitRequest\x1a,.database_driver_v1.ConnectionCommitResponse\x12s\n\x12\x43onnectionRollback\x12-.database_driver_v1.ConnectionRollbackRequest\x1a..database_driver_v1.ConnectionRollbackResponse\x12\x61\n\x0cStatementNew\x12\'.database_driver_v1.StatementNewRequest\x1a(.database_driver_v1.StatementNewResponse\x12m\n\x10StatementRelease\x12+.database_driver_v1.StatementReleaseRequest\x1a,.database_driver_v1.StatementReleaseResponse\x12y\n\x14StatementSetSqlQuery\x12/.database_driver_v1.StatementSetSqlQueryRequest\x1a\x30.database_driver_v1.StatementSetSqlQueryResponse\x12\x88\x01\n\x19StatementSetSubstraitPlan\x12\x34.database_driver_v1.StatementSetSubstraitPlanRequest\x1a\x35.database_driver_v1.StatementSetSubstraitPlanResponse\x12m\n\x10StatementPrepare\x12+.database_driver_v1.StatementPrepareRequest\x1a,.database_driver_v1.StatementPrepareResponse\x12\x85\x01\n\x18StatementSetOptionString\x12\x33.database_driver_v1.StatementSetOptionStringRequest\x1a\x34.database_driver_v1.StatementSetOptionStringResponse\x12\x82\x01\n\x17StatementSetOptionBytes\x12\x32.database_driver_v1.StatementSetOptionBytesRequest\x1a\x33.database_driver_v1.StatementSetOptionBytesResponse\x12|\n\x15StatementSetOptionInt\x12\x30.database_driver_v1.StatementSetOptionIntRequest\x1a\x31.database_driver_v1.StatementSetOptionIntResponse\x12\x85\x01\n\x18StatementSetOptionDouble\x12\x33.database_driver_v1.StatementSetOptionDoubleRequest\x1a\x34.database_driver_v1.StatementSetOptionDoubleResponse\x12\x8e\x01\n\x1bStatementGetParameterSchema\x12\x36.database_driver_v1.StatementGetParameterSchemaRequest\x1a\x37.database_driver_v1.StatementGetParameterSchemaResponse\x12\x64\n\rStatementBind\x12(.database_driver_v1.StatementBindRequest\x1a).database_driver_v1.StatementBindResponse\x12v\n\x13StatementBindStream\x12..database_driver_v1.StatementBindStreamRequest\x1a/.database_driver_v1.StatementBindStreamResponse\x12|\n\x15StatementExecuteQuery\x12\x30.database_driver_v1.StatementExecuteQueryRequest\x1a\x31.database_driver_v1.StatementExecuteQueryResponse\x12\x8b\x01\n\x1aStatementExecutePartitions\x12\x35.database_driver_v1.StatementExecutePartitionsRequest\x1a\x36.database_driver_v1.StatementExecutePartitionsResponse\x12\x7f\n\x16StatementReadPartition\x12\x31.database_driver_v1.StatementReadPartitionRequest\x1a\x32.database_driver_v1.StatementReadPartitionResponse\x1a\x14\xc2\xa9\xc9\x01\x0f\x44riverException:;\n\rservice_error\x12\x1f.google.protobuf.ServiceOptions\x18\x98\x95\x19 \x01(\t\x88\x01\x01:9\n\x0cmethod_error\x12\x1e.google.protobuf.MethodOptions\x18\x98\x95\x19 \x01(\t\x88\x01\x01\x42$\n\"com.snowflake.unicore.protobuf_genb\x06proto3')
+DESCRIPTOR = _descriptor_pool.Default().AddSerializedFile(b'\n\x18\x64\x61tabase_driver_v1.proto\x12\x12\x64\x61tabase_driver_v1\x1a google/protobuf/descriptor.proto\")\n\x0b\x45rrorDetail\x12\x0b\n\x03key\x18\x01 \x01(\t\x12\r\n\x05value\x18\x02 \x01(\t\"%\n\x13\x41uthenticationError\x12\x0e\n\x06\x64\x65tail\x18\x01 \x01(\t\"\x0e\n\x0cGenericError\"\x0f\n\rInternalError\"+\n\nLoginError\x12\x0f\n\x07message\x18\x01 \x01(\t\x12\x0c\n\x04\x63ode\x18\x02 \x01(\x05\"%\n\x10MissingParameter\x12\x11\n\tparameter\x18\x01 \x01(\t\"c\n\x15InvalidParameterValue\x12\x11\n\tparameter\x18\x01 \x01(\t\x12\r\n\x05value\x18\x02 \x01(\t\x12\x18\n\x0b\x65xplanation\x18\x03 \x01(\tH\x00\x88\x01\x01\x42\x0e\n\x0c_explanation\"\x9a\x03\n\x0b\x44riverError\x12=\n\nauth_error\x18\x01 \x01(\x0b\x32\'.database_driver_v1.AuthenticationErrorH\x00\x12\x39\n\rgeneric_error\x18\x02 \x01(\x0b\x32 .database_driver_v1.GenericErrorH\x00\x12;\n\x0einternal_error\x18\x03 \x01(\x0b\x32!.database_driver_v1.InternalErrorH\x00\x12\x41\n\x11missing_parameter\x18\x04 \x01(\x0b\x32$.database_driver_v1.MissingParameterH\x00\x12L\n\x17invalid_parameter_value\x18\x05 \x01(\x0b\x32).database_driver_v1.InvalidParameterValueH\x00\x12\x35\n\x0blogin_error\x18\x06 \x01(\x0b\x32\x1e.database_driver_v1.LoginErrorH\x00\x42\x0c\n\nerror_type\"\x97\x01\n\x0f\x44riverException\x12\x0f\n\x07message\x18\x01 \x01(\t\x12\x33\n\x0bstatus_code\x18\x02 \x01(\x0e\x32\x1e.database_driver_v1.StatusCode\x12.\n\x05\x65rror\x18\x03 \x01(\x0b\x32\x1f.database_driver_v1.DriverError\x12\x0e\n\x06report\x18\x04 \x01(\t\"_\n\rExecuteResult\x12\x37\n\x06stream\x18\x01 \x01(\x0b\x32\'.database_driver_v1.ArrowArrayStreamPtr\x12\x15\n\rrows_affected\x18\x02 \x01(\x03\"N\n\x11PartitionedResult\x12\x0e\n\x06schema\x18\x01 \x01(\x03\x12\x12\n\npartitions\x18\x02 \x03(\x0c\x12\x15\n\rrows_affected\x18\x03 \x01(\x03\"+\n\x0e\x44\x61tabaseHandle\x12\n\n\x02id\x18\x01 \x01(\x03\x12\r\n\x05magic\x18\x02 \x01(\x03\"-\n\x10\x43onnectionHandle\x12\n\n\x02id\x18\x01 \x01(\x03\x12\r\n\x05magic\x18\x02 \x01(\x03\",\n\x0fStatementHandle\x12\n\n\x02id\x18\x01 \x01(\x03\x12\r\n\x05magic\x18\x02 \x01(\x03\"$\n\x13\x41rrowArrayStreamPtr\x12\r\n\x05value\x18\x01 \x01(\x0c\"\x1f\n\x0e\x41rrowSchemaPtr\x12\r\n\x05value\x18\x01 \x01(\x0c\"\x1e\n\rArrowArrayPtr\x12\r\n\x05value\x18\x01 \x01(\x0c\"r\n\x0bOptionValue\x12\x16\n\x0cstring_value\x18\x01 \x01(\tH\x00\x12\x15\n\x0b\x62ytes_value\x18\x02 \x01(\x0cH\x00\x12\x13\n\tint_value\x18\x03 \x01(\x03H\x00\x12\x16\n\x0c\x64ouble_value\x18\x04 \x01(\x01H\x00\x42\x07\n\x05value\"\x14\n\x12\x44\x61tabaseNewRequest\"L\n\x13\x44\x61tabaseNewResponse\x12\x35\n\tdb_handle\x18\x01 \x01(\x0b\x32\".database_driver_v1.DatabaseHandle\"s\n\x1e\x44\x61tabaseSetOptionStringRequest\x12\x35\n\tdb_handle\x18\x01 \x01(\x0b\x32\".database_driver_v1.DatabaseHandle\x12\x0b\n\x03key\x18\x02 \x01(\t\x12\r\n\x05value\x18\x03 \x01(\t\"!\n\x1f\x44\x61tabaseSetOptionStringResponse\"r\n\x1d\x44\x61tabaseSetOptionBytesRequest\x12\x35\n\tdb_handle\x18\x01 \x01(\x0b\x32\".database_driver_v1.DatabaseHandle\x12\x0b\n\x03key\x18\x02 \x01(\t\x12\r\n\x05value\x18\x03 \x01(\x0c\" \n\x1e\x44\x61tabaseSetOptionBytesResponse\"p\n\x1b\x44\x61tabaseSetOptionIntRequest\x12\x35\n\tdb_handle\x18\x01 \x01(\x0b\x32\".database_driver_v1.DatabaseHandle\x12\x0b\n\x03key\x18\x02 \x01(\t\x12\r\n\x05value\x18\x03 \x01(\x03\"\x1e\n\x1c\x44\x61tabaseSetOptionIntResponse\"s\n\x1e\x44\x61tabaseSetOptionDoubleRequest\x12\x35\n\tdb_handle\x18\x01 \x01(\x0b\x32\".database_driver_v1.DatabaseHandle\x12\x0b\n\x03key\x18\x02 \x01(\t\x12\r\n\x05value\x18\x03 \x01(\x01\"!\n\x1f\x44\x61tabaseSetOptionDoubleResponse\"L\n\x13\x44\x61tabaseInitRequest\x12\x35\n\tdb_handle\x18\x01 \x01(\x0b\x32\".database_driver_v1.DatabaseHandle\"\x16\n\x14\x44\x61tabaseInitResponse\"O\n\x16\x44\x61tabaseReleaseRequest\x12\x35\n\tdb_handle\x18\x01 \x01(\x0b\x32\".database_driver_v1.DatabaseHandle\"\x19\n\x17\x44\x61tabaseReleaseResponse\"\x16\n\x14\x43onnectionNewRequest\"R\n\x15\x43onnectionNewResponse\x12\x39\n\x0b\x63onn_handle\x18\x01 \x01(\x0b\x32$.database_driver_v1.ConnectionHandle\"y\n ConnectionSetOptionStringRequest\x12\x39\n\x0b\x63onn_handle\x18\x01 \x01(\x0b\x32$.database_driver_v1.ConnectionHandle\x12\x0b\n\x03key\x18\x02 \x01(\t\x12\r\n\x05value\x18\x03 \x01(\t\"#\n!ConnectionSetOptionStringResponse\"x\n\x1f\x43onnectionSetOptionBytesRequest\x12\x39\n\x0b\x63onn_handle\x18\x01 \x01(\x0b\x32$.database_driver_v1.ConnectionHandle\x12\x0b\n\x03key\x18\x02 \x01(\t\x12\r\n\x05value\x18\x03 \x01(\x0c\"\"\n ConnectionSetOptionBytesResponse\"v\n\x1d\x43onnectionSetOptionIntRequest\x12\x39\n\x0b\x63onn_handle\x18\x01 \x01(\x0b\x32$.database_driver_v1.ConnectionHandle\x12\x0b\n\x03key\x18\x02 \x01(\t\x12\r\n\x05value\x18\x03 \x01(\x03\" \n\x1e\x43onnectionSetOptionIntResponse\"y\n ConnectionSetOptionDoubleRequest\x12\x39\n\x0b\x63onn_handle\x18\x01 \x01(\x0b\x32$.database_driver_v1.ConnectionHandle\x12\x0b\n\x03key\x18\x02 \x01(\t\x12\r\n\x05value\x18\x03 \x01(\x01\"#\n!ConnectionSetOptionDoubleResponse\"\xf8\x01\n\x1b\x43onnectionSetOptionsRequest\x12\x39\n\x0b\x63onn_handle\x18\x01 \x01(\x0b\x32$.database_driver_v1.ConnectionHandle\x12M\n\x07options\x18\x02 \x03(\x0b\x32<.database_driver_v1.ConnectionSetOptionsRequest.OptionsEntry\x1aO\n\x0cOptionsEntry\x12\x0b\n\x03key\x18\x01 \x01(\t\x12.\n\x05value\x18\x02 \x01(\x0b\x32\x1f.database_driver_v1.OptionValue:\x02\x38\x01\"\x1e\n\x1c\x43onnectionSetOptionsResponse\"\x89\x01\n\x15\x43onnectionInitRequest\x12\x39\n\x0b\x63onn_handle\x18\x01 \x01(\x0b\x32$.database_driver_v1.ConnectionHandle\x12\x35\n\tdb_handle\x18\x02 \x01(\x0b\x32\".database_driver_v1.DatabaseHandle\"\x18\n\x16\x43onnectionInitResponse\"U\n\x18\x43onnectionReleaseRequest\x12\x39\n\x0b\x63onn_handle\x18\x01 \x01(\x0b\x32$.database_driver_v1.ConnectionHandle\"\x1b\n\x19\x43onnectionReleaseResponse\"\x87\x01\n\x18\x43onnectionGetInfoRequest\x12\x39\n\x0b\x63onn_handle\x18\x01 \x01(\x0b\x32$.database_driver_v1.ConnectionHandle\x12\x30\n\ninfo_codes\x18\x02 \x03(\x0e\x32\x1c.database_driver_v1.InfoCode\".\n\x19\x43onnectionGetInfoResponse\x12\x11\n\tinfo_data\x18\x01 \x01(\x0c\"\x95\x02\n\x1b\x43onnectionGetObjectsRequest\x12\x39\n\x0b\x63onn_handle\x18\x01 \x01(\x0b\x32$.database_driver_v1.ConnectionHandle\x12\r\n\x05\x64\x65pth\x18\x02 \x01(\x05\x12\x14\n\x07\x63\x61talog\x18\x03 \x01(\tH\x00\x88\x01\x01\x12\x16\n\tdb_schema\x18\x04 \x01(\tH\x01\x88\x01\x01\x12\x17\n\ntable_name\x18\x05 \x01(\tH\x02\x88\x01\x01\x12\x12\n\ntable_type\x18\x06 \x03(\t\x12\x18\n\x0b\x63olumn_name\x18\x07 \x01(\tH\x03\x88\x01\x01\x42\n\n\x08_catalogB\x0c\n\n_db_schemaB\r\n\x0b_table_nameB\x0e\n\x0c_column_name\"4\n\x1c\x43onnectionGetObjectsResponse\x12\x14\n\x0cobjects_data\x18\x01 \x01(\x0c\"\xb8\x01\n\x1f\x43onnectionGetTableSchemaRequest\x12\x39\n\x0b\x63onn_handle\x18\x01 \x01(\x0b\x32$.database_driver_v1.ConnectionHandle\x12\x14\n\x07\x63\x61talog\x18\x02 \x01(\tH\x00\x88\x01\x01\x12\x16\n\tdb_schema\x18\x03 \x01(\tH\x01\x88\x01\x01\x12\x12\n\ntable_name\x18\x04 \x01(\tB\n\n\x08_catalogB\x0c\n\n_db_schema\"7\n ConnectionGetTableSchemaResponse\x12\x13\n\x0bschema_data\x18\x01 \x01(\x0c\"[\n\x1e\x43onnectionGetTableTypesRequest\x12\x39\n\x0b\x63onn_handle\x18\x01 \x01(\x0b\x32$.database_driver_v1.ConnectionHandle\";\n\x1f\x43onnectionGetTableTypesResponse\x12\x18\n\x10table_types_data\x18\x01 \x01(\x0c\"T\n\x17\x43onnectionCommitRequest\x12\x39\n\x0b\x63onn_handle\x18\x01 \x01(\x0b\x32$.database_driver_v1.ConnectionHandle\"\x1a\n\x18\x43onnectionCommitResponse\"V\n\x19\x43onnectionRollbackRequest\x12\x39\n\x0b\x63onn_handle\x18\x01 \x01(\x0b\x32$.database_driver_v1.ConnectionHandle\"\x1c\n\x1a\x43onnectionRollbackResponse\"P\n\x13StatementNewRequest\x12\x39\n\x0b\x63onn_handle\x18\x01 \x01(\x0b\x32$.database_driver_v1.ConnectionHandle\"P\n\x14StatementNewResponse\x12\x38\n\x0bstmt_handle\x18\x01 \x01(\x0b\x32#.database_driver_v1.StatementHandle\"S\n\x17StatementReleaseRequest\x12\x38\n\x0bstmt_handle\x18\x01 \x01(\x0b\x32#.database_driver_v1.StatementHandle\"\x1a\n\x18StatementReleaseResponse\"f\n\x1bStatementSetSqlQueryRequest\x12\x38\n\x0bstmt_handle\x18\x01 \x01(\x0b\x32#.database_driver_v1.StatementHandle\x12\r\n\x05query\x18\x02 \x01(\t\"\x1e\n\x1cStatementSetSqlQueryResponse\"j\n StatementSetSubstraitPlanRequest\x12\x38\n\x0bstmt_handle\x18\x01 \x01(\x0b\x32#.database_driver_v1.StatementHandle\x12\x0c\n\x04plan\x18\x02 \x01(\x0c\"#\n!StatementSetSubstraitPlanResponse\"S\n\x17StatementPrepareRequest\x12\x38\n\x0bstmt_handle\x18\x01 \x01(\x0b\x32#.database_driver_v1.StatementHandle\"\x93\x01\n\x18StatementPrepareResponse\x12\x39\n\rresult_schema\x18\x01 \x01(\x0b\x32\".database_driver_v1.ArrowSchemaPtr\x12<\n\x10parameter_schema\x18\x02 \x01(\x0b\x32\".database_driver_v1.ArrowSchemaPtr\"w\n\x1fStatementSetOptionStringRequest\x12\x38\n\x0bstmt_handle\x18\x01 \x01(\x0b\x32#.database_driver_v1.StatementHandle\x12\x0b\n\x03key\x18\x02 \x01(\t\x12\r\n\x05value\x18\x03 \x01(\t\"\"\n StatementSetOptionStringResponse\"v\n\x1eStatementSetOptionBytesRequest\x12\x38\n\x0bstmt_handle\x18\x01 \x01(\x0b\x32#.database_driver_v1.StatementHandle\x12\x0b\n\x03key\x18\x02 \x01(\t\x12\r\n\x05value\x18\x03 \x01(\x0c\"!\n\x1fStatementSetOptionBytesResponse\"t\n\x1cStatementSetOptionIntRequest\x12\x38\n\x0bstmt_handle\x18\x01 \x01(\x0b\x32#.database_driver_v1.StatementHandle\x12\x0b\n\x03key\x18\x02 \x01(\t\x12\r\n\x05value\x18\x03 \x01(\x03\"\x1f\n\x1dStatementSetOptionIntResponse\"w\n\x1fStatementSetOptionDoubleRequest\x12\x38\n\x0bstmt_handle\x18\x01 \x01(\x0b\x32#.database_driver_v1.StatementHandle\x12\x0b\n\x03key\x18\x02 \x01(\t\x12\r\n\x05value\x18\x03 \x01(\x01\"\"\n StatementSetOptionDoubleResponse\"\xf5\x01\n\x1aStatementSetOptionsRequest\x12\x38\n\x0bstmt_handle\x18\x01 \x01(\x0b\x32#.database_driver_v1.StatementHandle\x12L\n\x07options\x18\x02 \x03(\x0b\x32;.database_driver_v1.StatementSetOptionsRequest.OptionsEntry\x1aO\n\x0cOptionsEntry\x12\x0b\n\x03key\x18\x01 \x01(\t\x12.\n\x05value\x18\x02 \x01(\x0b\x32\x1f.database_driver_v1.OptionValue:\x02\x38\x01\"\x1d\n\x1bStatementSetOptionsResponse\"^\n\"StatementGetParameterSchemaRequest\x12\x38\n\x0bstmt_handle\x18\x01 \x01(\x0b\x32#.database_driver_v1.StatementHandle\"Y\n#StatementGetParameterSchemaResponse\x12\x32\n\x06schema\x18\x01 \x01(\x0b\x32\".database_driver_v1.ArrowSchemaPtr\"\xb6\x01\n\x14StatementBindRequest\x12\x38\n\x0bstmt_handle\x18\x01 \x01(\x0b\x32#.database_driver_v1.StatementHandle\x12\x32\n\x06schema\x18\x02 \x01(\x0b\x32\".database_driver_v1.ArrowSchemaPtr\x12\x30\n\x05\x61rray\x18\x03 \x01(\x0b\x32!.database_driver_v1.ArrowArrayPtr\"\x17\n\x15StatementBindResponse\"f\n\x1aStatementBindStreamRequest\x12\x38\n\x0bstmt_handle\x18\x01 \x01(\x0b\x32#.database_driver_v1.StatementHandle\x12\x0e\n\x06stream\x18\x02 \x01(\x0c\"\x1d\n\x1bStatementBindStreamResponse\"X\n\x1cStatementExecuteQueryRequest\x12\x38\n\x0bstmt_handle\x18\x01 \x01(\x0b\x32#.database_driver_v1.StatementHandle\"R\n\x1dStatementExecuteQueryResponse\x12\x31\n\x06result\x18\x01 \x01(\x0b\x32!.database_driver_v1.ExecuteResult\"]\n!StatementExecutePartitionsRequest\x12\x38\n\x0bstmt_handle\x18\x01 \x01(\x0b\x32#.database_driver_v1.StatementHandle\"[\n\"StatementExecutePartitionsResponse\x12\x35\n\x06result\x18\x01 \x01(\x0b\x32%.database_driver_v1.PartitionedResult\"w\n\x1dStatementReadPartitionRequest\x12\x38\n\x0bstmt_handle\x18\x01 \x01(\x0b\x32#.database_driver_v1.StatementHandle\x12\x1c\n\x14partition_descriptor\x18\x02 \x01(\x0c\":\n\x1eStatementReadPartitionResponse\x12\x18\n\x10partition_stream\x18\x01 \x01(\x03*\xb4\x04\n\nStatusCode\x12\x1b\n\x17STATUS_CODE_UNSPECIFIED\x10\x00\x12\x12\n\x0eSTATUS_CODE_OK\x10\x01\x12$\n STATUS_CODE_AUTHENTICATION_ERROR\x10\x02\x12\x1f\n\x1bSTATUS_CODE_NOT_IMPLEMENTED\x10\x03\x12\x19\n\x15STATUS_CODE_NOT_FOUND\x10\x04\x12\x1e\n\x1aSTATUS_CODE_ALREADY_EXISTS\x10\x05\x12 \n\x1cSTATUS_CODE_INVALID_ARGUMENT\x10\x06\x12\x1d\n\x19STATUS_CODE_INVALID_STATE\x10\x07\x12\x1c\n\x18STATUS_CODE_INVALID_DATA\x10\x08\x12\x12\n\x0eSTATUS_CODE_IO\x10\t\x12\x19\n\x15STATUS_CODE_CANCELLED\x10\n\x12\x1f\n\x1bSTATUS_CODE_UNAUTHENTICATED\x10\x0b\x12\x1c\n\x18STATUS_CODE_UNAUTHORIZED\x10\x0c\x12\x1d\n\x19STATUS_CODE_GENERIC_ERROR\x10\r\x12\x1e\n\x1aSTATUS_CODE_INTERNAL_ERROR\x10\x0e\x12!\n\x1dSTATUS_CODE_MISSING_PARAMETER\x10\x0f\x12\'\n#STATUS_CODE_INVALID_PARAMETER_VALUE\x10\x10\x12\x1b\n\x17STATUS_CODE_LOGIN_ERROR\x10\x11*\x98\x03\n\x08InfoCode\x12\x19\n\x15INFO_CODE_UNSPECIFIED\x10\x00\x12\x19\n\x15INFO_CODE_VENDOR_NAME\x10\x01\x12\x1c\n\x18INFO_CODE_VENDOR_VERSION\x10\x02\x12\"\n\x1eINFO_CODE_VENDOR_ARROW_VERSION\x10\x03\x12\x18\n\x14INFO_CODE_VENDOR_SQL\x10\x65\x12\x1e\n\x1aINFO_CODE_VENDOR_SUBSTRAIT\x10\x66\x12*\n&INFO_CODE_VENDOR_SUBSTRAIT_MIN_VERSION\x10g\x12*\n&INFO_CODE_VENDOR_SUBSTRAIT_MAX_VERSION\x10h\x12\x1a\n\x15INFO_CODE_DRIVER_NAME\x10\xc9\x01\x12\x1d\n\x18INFO_CODE_DRIVER_VERSION\x10\xca\x01\x12#\n\x1eINFO_CODE_DRIVER_ARROW_VERSION\x10\xcb\x01\x12\"\n\x1dINFO_CODE_DRIVER_ADBC_VERSION\x10\xcc\x01\x32\xe2#\n\x0e\x44\x61tabaseDriver\x12^\n\x0b\x44\x61tabaseNew\x12&.database_driver_v1.DatabaseNewRequest\x1a\'.database_driver_v1.DatabaseNewResponse\x12\x82\x01\n\x17\x44\x61tabaseSetOptionString\x12\x32.database_driver_v1.DatabaseSetOptionStringRequest\x1a\x33.database_driver_v1.DatabaseSetOptionStringResponse\x12\x7f\n\x16\x44\x61tabaseSetOptionBytes\x12\x31.database_driver_v1.DatabaseSetOptionBytesRequest\x1a\x32.database_driver_v1.DatabaseSetOptionBytesResponse\x12y\n\x14\x44\x61tabaseSetOptionInt\x12/.database_driver_v1.DatabaseSetOptionIntRequest\x1a\x30.database_driver_v1.DatabaseSetOptionIntResponse\x12\x82\x01\n\x17\x44\x61tabaseSetOptionDouble\x12\x32.database_driver_v1.DatabaseSetOptionDoubleRequest\x1a\x33.database_driver_v1.DatabaseSetOptionDoubleResponse\x12\x61\n\x0c\x44\x61tabaseInit\x12\'.database_driver_v1.DatabaseInitRequest\x1a(.database_driver_v1.DatabaseInitResponse\x12j\n\x0f\x44\x61tabaseRelease\x12*.database_driver_v1.DatabaseReleaseRequest\x1a+.database_driver_v1.DatabaseReleaseResponse\x12\x64\n\rConnectionNew\x12(.database_driver_v1.ConnectionNewRequest\x1a).database_driver_v1.ConnectionNewResponse\x12\x88\x01\n\x19\x43onnectionSetOptionString\x12\x34.database_driver_v1.ConnectionSetOptionStringRequest\x1a\x35.database_driver_v1.ConnectionSetOptionStringResponse\x12\x85\x01\n\x18\x43onnectionSetOptionBytes\x12\x33.database_driver_v1.ConnectionSetOptionBytesRequest\x1a\x34.database_driver_v1.ConnectionSetOptionBytesResponse\x12\x7f\n\x16\x43onnectionSetOptionInt\x12\x31.database_driver_v1.ConnectionSetOptionIntRequest\x1a\x32.database_driver_v1.ConnectionSetOptionIntResponse\x12\x88\x01\n\x19\x43onnectionSetOptionDouble\x12\x34.database_driver_v1.ConnectionSetOptionDoubleRequest\x1a\x35.database_driver_v1.ConnectionSetOptionDoubleResponse\x12y\n\x14\x43onnectionSetOptions\x12/.database_driver_v1.ConnectionSetOptionsRequest\x1a\x30.database_driver_v1.ConnectionSetOptionsResponse\x12g\n\x0e\x43onnectionInit\x12).database_driver_v1.ConnectionInitRequest\x1a*.database_driver_v1.ConnectionInitResponse\x12p\n\x11\x43onnectionRelease\x12,.database_driver_v1.ConnectionReleaseRequest\x1a-.database_driver_v1.ConnectionReleaseResponse\x12p\n\x11\x43onnectionGetInfo\x12,.database_driver_v1.ConnectionGetInfoRequest\x1a-.database_driver_v1.ConnectionGetInfoResponse\x12y\n\x14\x43onnectionGetObjects\x12/.database_driver_v1.ConnectionGetObjectsRequest\x1a\x30.database_driver_v1.ConnectionGetObjectsResponse\x12\x85\x01\n\x18\x43onnectionGetTableSchema\x12\x33.database_driver_v1.ConnectionGetTableSchemaRequest\x1a\x34.database_driver_v1.ConnectionGetTableSchemaResponse\x12\x82\x01\n\x17\x43onnectionGetTableTypes\x12\x32.database_driver_v1.ConnectionGetTableTypesRequest\x1a\x33.database_driver_v1.ConnectionGetTableTypesResponse\x12m\n\x10\x43onnectionCommit\x12+.database_driver_v1.ConnectionCommitRequest\x1a,.database_driver_v1.ConnectionCommitResponse\x12s\n\x12\x43onnectionRollback\x12-.database_driver_v1.ConnectionRollbackRequest\x1a..database_driver_v1.ConnectionRollbackResponse\x12\x61\n\x0cStatementNew\x12\'.database_driver_v1.StatementNewRequest\x1a(.database_driver_v1.StatementNewResponse\x12m\n\x10StatementRelease\x12+.database_driver_v1.StatementReleaseRequest\x1a,.database_driver_v1.StatementReleaseResponse\x12y\n\x14StatementSetSqlQuery\x12/.database_driver_v1.StatementSetSqlQueryRequest\x1a\x30.database_driver_v1.StatementSetSqlQueryResponse\x12\x88\x01\n\x19StatementSetSubstraitPlan\x12\x34.database_driver_v1.StatementSetSubstraitPlanRequest\x1a\x35.database_driver_v1.StatementSetSubstraitPlanResponse\x12m\n\x10StatementPrepare\x12+.database_driver_v1.StatementPrepareRequest\x1a,.database_driver_v1.StatementPrepareResponse\x12\x85\x01\n\x18StatementSetOptionString\x12\x33.database_driver_v1.StatementSetOptionStringRequest\x1a\x34.database_driver_v1.StatementSetOptionStringResponse\x12\x82\x01\n\x17StatementSetOptionBytes\x12\x32.database_driver_v1.StatementSetOptionBytesRequest\x1a\x33.database_driver_v1.StatementSetOptionBytesResponse\x12|\n\x15StatementSetOptionInt\x12\x30.database_driver_v1.StatementSetOptionIntRequest\x1a\x31.database_driver_v1.StatementSetOptionIntResponse\x12\x85\x01\n\x18StatementSetOptionDouble\x12\x33.database_driver_v1.StatementSetOptionDoubleRequest\x1a\x34.database_driver_v1.StatementSetOptionDoubleResponse\x12v\n\x13StatementSetOptions\x12..database_driver_v1.StatementSetOptionsRequest\x1a/.database_driver_v1.StatementSetOptionsResponse\x12\x8e\x01\n\x1bStatementGetParameterSchema\x12\x36.database_driver_v1.StatementGetParameterSchemaRequest\x1a\x37.database_driver_v1.StatementGetParameterSchemaResponse\x12\x64\n\rStatementBind\x12(.database_driver_v1.StatementBindRequest\x1a).database_driver_v1.StatementBindResponse\x12v\n\x13StatementBindStream\x12..database_driver_v1.StatementBindStreamRequest\x1a/.database_driver_v1.StatementBindStreamResponse\x12|\n\x15StatementExecuteQuery\x12\x30.database_driver_v1.StatementExecuteQueryRequest\x1a\x31.database_driver_v1.StatementExecuteQueryResponse\x12\x8b\x01\n\x1aStatementExecutePartitions\x12\x35.database_driver_v1.StatementExecutePartitionsRequest\x1a\x36.database_driver_v1.StatementExecutePartitionsResponse\x12\x7f\n\x16StatementReadPartition\x12\x31.database_driver_v1.StatementReadPartitionRequest\x1a\x32.database_driver_v1.StatementReadPartitionResponse\x1a\x14\xc2\xa9\xc9\x01\x0f\x44riverException:;\n\rservice_error\x12\x1f.google.protobuf.ServiceOptions\x18\x98\x95\x19 \x01(\t\x88\x01\x01:9\n\x0cmethod_error\x12\x1e.google.protobuf.MethodOptions\x18\x98\x95\x19 \x01(\t\x88\x01\x01\x42$\n\"com.snowflake.unicore.protobuf_genb\x06proto3')
 
 _globals = globals()
 _builder.BuildMessageAndEnumDescriptors(DESCRIPTOR, _globals)
@@ -33,12 +33,16 @@ _builder.BuildTopDescriptorsAndMessages(DESCRIPTOR, 'database_driver_v1_pb2', _g
 if not _descriptor._USE_C_DESCRIPTORS:
   _globals['DESCRIPTOR']._loaded_options = None
   _globals['DESCRIPTOR']._serialized_options = b'\n\"com.snowflake.unicore.protobuf_gen'
+  _globals['_CONNECTIONSETOPTIONSREQUEST_OPTIONSENTRY']._loaded_options = None
+  _globals['_CONNECTIONSETOPTIONSREQUEST_OPTIONSENTRY']._serialized_options = b'8\001'
+  _globals['_STATEMENTSETOPTIONSREQUEST_OPTIONSENTRY']._loaded_options = None
+  _globals['_STATEMENTSETOPTIONSREQUEST_OPTIONSENTRY']._serialized_options = b'8\001'
   _globals['_DATABASEDRIVER']._loaded_options = None
   _globals['_DATABASEDRIVER']._serialized_options = b'\302\251\311\001\017DriverException'
-  _globals['_STATUSCODE']._serialized_start=6816
-  _globals['_STATUSCODE']._serialized_end=7380
-  _globals['_INFOCODE']._serialized_start=7383
-  _globals['_INFOCODE']._serialized_end=7791
+  _globals['_STATUSCODE']._serialized_start=7616
+  _globals['_STATUSCODE']._serialized_end=8180
+  _globals['_INFOCODE']._serialized_start=8183
+  _globals['_INFOCODE']._serialized_end=8591
   _globals['_ERRORDETAIL']._serialized_start=82
   _globals['_ERRORDETAIL']._serialized_end=123
   _globals['_AUTHENTICATIONERROR']._serialized_start=125
@@ -73,146 +77,160 @@ if not _descriptor._USE_C_DESCRIPTORS:
   _globals['_ARROWSCHEMAPTR']._serialized_end=1333
   _globals['_ARROWARRAYPTR']._serialized_start=1335
   _globals['_ARROWARRAYPTR']._serialized_end=1365
-  _globals['_DATABASENEWREQUEST']._serialized_start=1367
-  _globals['_DATABASENEWREQUEST']._serialized_end=1387
-  _globals['_DATABASENEWRESPONSE']._serialized_start=1389
-  _globals['_DATABASENEWRESPONSE']._serialized_end=1465
-  _globals['_DATABASESETOPTIONSTRINGREQUEST']._serialized_start=1467
-  _globals['_DATABASESETOPTIONSTRINGREQUEST']._serialized_end=1582
-  _globals['_DATABASESETOPTIONSTRINGRESPONSE']._serialized_start=1584
-  _globals['_DATABASESETOPTIONSTRINGRESPONSE']._serialized_end=1617
-  _globals['_DATABASESETOPTIONBYTESREQUEST']._serialized_start=1619
-  _globals['_DATABASESETOPTIONBYTESREQUEST']._serialized_end=1733
-  _globals['_DATABASESETOPTIONBYTESRESPONSE']._serialized_start=1735
-  _globals['_DATABASESETOPTIONBYTESRESPONSE']._serialized_end=1767
-  _globals['_DATABASESETOPTIONINTREQUEST']._serialized_start=1769
-  _globals['_DATABASESETOPTIONINTREQUEST']._serialized_end=1881
-  _globals['_DATABASESETOPTIONINTRESPONSE']._serialized_start=1883
-  _globals['_DATABASESETOPTIONINTRESPONSE']._serialized_end=1913
-  _globals['_DATABASESETOPTIONDOUBLEREQUEST']._serialized_start=1915
-  _globals['_DATABASESETOPTIONDOUBLEREQUEST']._serialized_end=2030
-  _globals['_DATABASESETOPTIONDOUBLERESPONSE']._serialized_start=2032
-  _globals['_DATABASESETOPTIONDOUBLERESPONSE']._serialized_end=2065
-  _globals['_DATABASEINITREQUEST']._serialized_start=2067
-  _globals['_DATABASEINITREQUEST']._serialized_end=2143
-  _globals['_DATABASEINITRESPONSE']._serialized_start=2145
-  _globals['_DATABASEINITRESPONSE']._serialized_end=2167
-  _globals['_DATABASERELEASEREQUEST']._serialized_start=2169
-  _globals['_DATABASERELEASEREQUEST']._serialized_end=2248
-  _globals['_DATABASERELEASERESPONSE']._serialized_start=2250
-  _globals['_DATABASERELEASERESPONSE']._serialized_end=2275
-  _globals['_CONNECTIONNEWREQUEST']._serialized_start=2277
-  _globals['_CONNECTIONNEWREQUEST']._serialized_end=2299
-  _globals['_CONNECTIONNEWRESPONSE']._serialized_start=2301
-  _globals['_CONNECTIONNEWRESPONSE']._serialized_end=2383
-  _globals['_CONNECTIONSETOPTIONSTRINGREQUEST']._serialized_start=2385
-  _globals['_CONNECTIONSETOPTIONSTRINGREQUEST']._serialized_end=2506
-  _globals['_CONNECTIONSETOPTIONSTRINGRESPONSE']._serialized_start=2508
-  _globals['_CONNECTIONSETOPTIONSTRINGRESPONSE']._serialized_end=2543
-  _globals['_CONNECTIONSETOPTIONBYTESREQUEST']._serialized_start=2545
-  _globals['_CONNECTIONSETOPTIONBYTESREQUEST']._serialized_end=2665
-  _globals['_CONNECTIONSETOPTIONBYTESRESPONSE']._serialized_start=2667
-  _globals['_CONNECTIONSETOPTIONBYTESRESPONSE']._serialized_end=2701
-  _globals['_CONNECTIONSETOPTIONINTREQUEST']._serialized_start=2703
-  _globals['_CONNECTIONSETOPTIONINTREQUEST']._serialized_end=2821
-  _globals['_CONNECTIONSETOPTIONINTRESPONSE']._serialized_start=2823
-  _globals['_CONNECTIONSETOPTIONINTRESPONSE']._serialized_end=2855
-  _globals['_CONNECTIONSETOPTIONDOUBLEREQUEST']._serialized_start=2857
-  _globals['_CONNECTIONSETOPTIONDOUBLEREQUEST']._serialized_end=2978
-  _globals['_CONNECTIONSETOPTIONDOUBLERESPONSE']._serialized_start=2980
-  _globals['_CONNECTIONSETOPTIONDOUBLERESPONSE']._serialized_end=3015
-  _globals['_CONNECTIONINITREQUEST']._serialized_start=3018
-  _globals['_CONNECTIONINITREQUEST']._serialized_end=3155
-  _globals['_CONNECTIONINITRESPONSE']._serialized_start=3157
-  _globals['_CONNECTIONINITRESPONSE']._serialized_end=3181
-  _globals['_CONNECTIONRELEASEREQUEST']._serialized_start=3183
-  _globals['_CONNECTIONRELEASEREQUEST']._serialized_end=3268
-  _globals['_CONNECTIONRELEASERESPONSE']._serialized_start=3270
-  _globals['_CONNECTIONRELEASERESPONSE']._serialized_end=3297
-  _globals['_CONNECTIONGETINFOREQUEST']._serialized_start=3300
-  _globals['_CONNECTIONGETINFOREQUEST']._serialized_end=3435
-  _globals['_CONNECTIONGETINFORESPONSE']._serialized_start=3437
-  _globals['_CONNECTIONGETINFORESPONSE']._serialized_end=3483
-  _globals['_CONNECTIONGETOBJECTSREQUEST']._serialized_start=3486
-  _globals['_CONNECTIONGETOBJECTSREQUEST']._serialized_end=3763
-  _globals['_CONNECTIONGETOBJECTSRESPONSE']._serialized_start=3765
-  _globals['_CONNECTIONGETOBJECTSRESPONSE']._serialized_end=3817
-  _globals['_CONNECTIONGETTABLESCHEMAREQUEST']._serialized_start=3820
-  _globals['_CONNECTIONGETTABLESCHEMAREQUEST']._serialized_end=4004
-  _globals['_CONNECTIONGETTABLESCHEMARESPONSE']._serialized_start=4006
-  _globals['_CONNECTIONGETTABLESCHEMARESPONSE']._serialized_end=4061
-  _globals['_CONNECTIONGETTABLETYPESREQUEST']._serialized_start=4063
-  _globals['_CONNECTIONGETTABLETYPESREQUEST']._serialized_end=4154
-  _globals['_CONNECTIONGETTABLETYPESRESPONSE']._serialized_start=4156
-  _globals['_CONNECTIONGETTABLETYPESRESPONSE']._serialized_end=4215
-  _globals['_CONNECTIONCOMMITREQUEST']._serialized_start=4217
-  _globals['_CONNECTIONCOMMITREQUEST']._serialized_end=4301
-  _globals['_CONNECTIONCOMMITRESPONSE']._serialized_start=4303
-  _globals['_CONNECTIONCOMMITRESPONSE']._serialized_end=4329
-  _globals['_CONNECTIONROLLBACKREQUEST']._serialized_start=4331
-  _globals['_CONNECTIONROLLBACKREQUEST']._serialized_end=4417
-  _globals['_CONNECTIONROLLBACKRESPONSE']._serialized_start=4419
-  _globals['_CONNECTIONROLLBACKRESPONSE']._serialized_end=4447
-  _globals['_STATEMENTNEWREQUEST']._serialized_start=4449
-  _globals['_STATEMENTNEWREQUEST']._serialized_end=4529
-  _globals['_STATEMENTNEWRESPONSE']._serialized_start=4531
-  _globals['_STATEMENTNEWRESPONSE']._serialized_end=4611
-  _globals['_STATEMENTRELEASEREQUEST']._serialized_start=4613
-  _globals['_STATEMENTRELEASEREQUEST']._serialized_end=4696
-  _globals['_STATEMENTRELEASERESPONSE']._serialized_start=4698
-  _globals['_STATEMENTRELEASERESPONSE']._serialized_end=4724
-  _globals['_STATEMENTSETSQLQUERYREQUEST']._serialized_start=4726
-  _globals['_STATEMENTSETSQLQUERYREQUEST']._serialized_end=4828
-  _globals['_STATEMENTSETSQLQUERYRESPONSE']._serialized_start=4830
-  _globals['_STATEMENTSETSQLQUERYRESPONSE']._serialized_end=4860
-  _globals['_STATEMENTSETSUBSTRAITPLANREQUEST']._serialized_start=4862
-  _globals['_STATEMENTSETSUBSTRAITPLANREQUEST']._serialized_end=4968
-  _globals['_STATEMENTSETSUBSTRAITPLANRESPONSE']._serialized_start=4970
-  _globals['_STATEMENTSETSUBSTRAITPLANRESPONSE']._serialized_end=5005
-  _globals['_STATEMENTPREPAREREQUEST']._serialized_start=5007
-  _globals['_STATEMENTPREPAREREQUEST']._serialized_end=5090
-  _globals['_STATEMENTPREPARERESPONSE']._serialized_start=5092
-  _globals['_STATEMENTPREPARERESPONSE']._serialized_end=5118
-  _globals['_STATEMENTSETOPTIONSTRINGREQUEST']._serialized_start=5120
-  _globals['_STATEMENTSETOPTIONSTRINGREQUEST']._serialized_end=5239
-  _globals['_STATEMENTSETOPTIONSTRINGRESPONSE']._serialized_start=5241
-  _globals['_STATEMENTSETOPTIONSTRINGRESPONSE']._serialized_end=5275
-  _globals['_STATEMENTSETOPTIONBYTESREQUEST']._serialized_start=5277
-  _globals['_STATEMENTSETOPTIONBYTESREQUEST']._serialized_end=5395
-  _globals['_STATEMENTSETOPTIONBYTESRESPONSE']._serialized_start=5397
-  _globals['_STATEMENTSETOPTIONBYTESRESPONSE']._serialized_end=5430
-  _globals['_STATEMENTSETOPTIONINTREQUEST']._serialized_start=5432
-  _globals['_STATEMENTSETOPTIONINTREQUEST']._serialized_end=5548
-  _globals['_STATEMENTSETOPTIONINTRESPONSE']._serialized_start=5550
-  _globals['_STATEMENTSETOPTIONINTRESPONSE']._serialized_end=5581
-  _globals['_STATEMENTSETOPTIONDOUBLEREQUEST']._serialized_start=5583
-  _globals['_STATEMENTSETOPTIONDOUBLEREQUEST']._serialized_end=5702
-  _globals['_STATEMENTSETOPTIONDOUBLERESPONSE']._serialized_start=5704
-  _globals['_STATEMENTSETOPTIONDOUBLERESPONSE']._serialized_end=5738
-  _globals['_STATEMENTGETPARAMETERSCHEMAREQUEST']._serialized_start=5740
-  _globals['_STATEMENTGETPARAMETERSCHEMAREQUEST']._serialized_end=5834
-  _globals['_STATEMENTGETPARAMETERSCHEMARESPONSE']._serialized_start=5836
-  _globals['_STATEMENTGETPARAMETERSCHEMARESPONSE']._serialized_end=5925
-  _globals['_STATEMENTBINDREQUEST']._serialized_start=5928
-  _globals['_STATEMENTBINDREQUEST']._serialized_end=6110
-  _globals['_STATEMENTBINDRESPONSE']._serialized_start=6112
-  _globals['_STATEMENTBINDRESPONSE']._serialized_end=6135
-  _globals['_STATEMENTBINDSTREAMREQUEST']._serialized_start=6137
-  _globals['_STATEMENTBINDSTREAMREQUEST']._serialized_end=6239
-  _globals['_STATEMENTBINDSTREAMRESPONSE']._serialized_start=6241
-  _globals['_STATEMENTBINDSTREAMRESPONSE']._serialized_end=6270
-  _globals['_STATEMENTEXECUTEQUERYREQUEST']._serialized_start=6272
-  _globals['_STATEMENTEXECUTEQUERYREQUEST']._serialized_end=6360
-  _globals['_STATEMENTEXECUTEQUERYRESPONSE']._serialized_start=6362
-  _globals['_STATEMENTEXECUTEQUERYRESPONSE']._serialized_end=6444
-  _globals['_STATEMENTEXECUTEPARTITIONSREQUEST']._serialized_start=6446
-  _globals['_STATEMENTEXECUTEPARTITIONSREQUEST']._serialized_end=6539
-  _globals['_STATEMENTEXECUTEPARTITIONSRESPONSE']._serialized_start=6541
-  _globals['_STATEMENTEXECUTEPARTITIONSRESPONSE']._serialized_end=6632
-  _globals['_STATEMENTREADPARTITIONREQUEST']._serialized_start=6634
-  _globals['_STATEMENTREADPARTITIONREQUEST']._serialized_end=6753
-  _globals['_STATEMENTREADPARTITIONRESPONSE']._serialized_start=6755
-  _globals['_STATEMENTREADPARTITIONRESPONSE']._serialized_end=6813
-  _globals['_DATABASEDRIVER']._serialized_start=7794
-  _globals['_DATABASEDRIVER']._serialized_end=12129
+  _globals['_OPTIONVALUE']._serialized_start=1367
+  _globals['_OPTIONVALUE']._serialized_end=1481
+  _globals['_DATABASENEWREQUEST']._serialized_start=1483
+  _globals['_DATABASENEWREQUEST']._serialized_end=1503
+  _globals['_DATABASENEWRESPONSE']._serialized_start=1505
+  _globals['_DATABASENEWRESPONSE']._serialized_end=1581
+  _globals['_DATABASESETOPTIONSTRINGREQUEST']._serialized_start=1583
+  _globals['_DATABASESETOPTIONSTRINGREQUEST']._serialized_end=1698
+  _globals['_DATABASESETOPTIONSTRINGRESPONSE']._serialized_start=1700
+  _globals['_DATABASESETOPTIONSTRINGRESPONSE']._serialized_end=1733
+  _globals['_DATABASESETOPTIONBYTESREQUEST']._serialized_start=1735
+  _globals['_DATABASESETOPTIONBYTESREQUEST']._serialized_end=1849
+  _globals['_DATABASESETOPTIONBYTESRESPONSE']._serialized_start=1851
+  _globals['_DATABASESETOPTIONBYTESRESPONSE']._serialized_end=1883
+  _globals['_DATABASESETOPTIONINTREQUEST']._serialized_start=1885
+  _globals['_DATABASESETOPTIONINTREQUEST']._serialized_end=1997
+  _globals['_DATABASESETOPTIONINTRESPONSE']._serialized_start=1999
+  _globals['_DATABASESETOPTIONINTRESPONSE']._serialized_end=2029
+  _globals['_DATABASESETOPTIONDOUBLEREQUEST']._serialized_start=2031
+  _globals['_DATABASESETOPTIONDOUBLEREQUEST']._serialized_end=2146
+  _globals['_DATABASESETOPTIONDOUBLERESPONSE']._serialized_start=2148
+  _globals['_DATABASESETOPTIONDOUBLERESPONSE']._serialized_end=2181
+  _globals['_DATABASEINITREQUEST']._serialized_start=2183
+  _globals['_DATABASEINITREQUEST']._serialized_end=2259
+  _globals['_DATABASEINITRESPONSE']._serialized_start=2261
+  _globals['_DATABASEINITRESPONSE']._serialized_end=2283
+  _globals['_DATABASERELEASEREQUEST']._serialized_start=2285
+  _globals['_DATABASERELEASEREQUEST']._serialized_end=2364
+  _globals['_DATABASERELEASERESPONSE']._serialized_start=2366
+  _globals['_DATABASERELEASERESPONSE']._serialized_end=2391
+  _globals['_CONNECTIONNEWREQUEST']._serialized_start=2393
+  _globals['_CONNECTIONNEWREQUEST']._serialized_end=2415
+  _globals['_CONNECTIONNEWRESPONSE']._serialized_start=2417
+  _globals['_CONNECTIONNEWRESPONSE']._serialized_end=2499
+  _globals['_CONNECTIONSETOPTIONSTRINGREQUEST']._serialized_start=2501
+  _globals['_CONNECTIONSETOPTIONSTRINGREQUEST']._serialized_end=2622
+  _globals['_CONNECTIONSETOPTIONSTRINGRESPONSE']._serialized_start=2624
+  _globals['_CONNECTIONSETOPTIONSTRINGRESPONSE']._serialized_end=2659
+  _globals['_CONNECTIONSETOPTIONBYTESREQUEST']._serialized_start=2661
+  _globals['_CONNECTIONSETOPTIONBYTESREQUEST']._serialized_end=2781
+  _globals['_CONNECTIONSETOPTIONBYTESRESPONSE']._serialized_start=2783
+  _globals['_CONNECTIONSETOPTIONBYTESRESPONSE']._serialized_end=2817
+  _globals['_CONNECTIONSETOPTIONINTREQUEST']._serialized_start=2819
+  _globals['_CONNECTIONSETOPTIONINTREQUEST']._serialized_end=2937
+  _globals['_CONNECTIONSETOPTIONINTRESPONSE']._serialized_start=2939
+  _globals['_CONNECTIONSETOPTIONINTRESPONSE']._serialized_end=2971
+  _globals['_CONNECTIONSETOPTIONDOUBLEREQUEST']._serialized_start=2973
+  _globals['_CONNECTIONSETOPTIONDOUBLEREQUEST']._serialized_end=3094
+  _globals['_CONNECTIONSETOPTIONDOUBLERESPONSE']._serialized_start=3096
+  _globals['_CONNECTIONSETOPTIONDOUBLERESPONSE']._serialized_end=3131
+  _globals['_CONNECTIONSETOPTIONSREQUEST']._serialized_start=3134
+  _globals['_CONNECTIONSETOPTIONSREQUEST']._serialized_end=3382
+  _globals['_CONNECTIONSETOPTIONSREQUEST_OPTIONSENTRY']._serialized_start=3303
+  _globals['_CONNECTIONSETOPTIONSREQUEST_OPTIONSENTRY']._serialized_end=3382
+  _globals['_CONNECTIONSETOPTIONSRESPONSE']._serialized_start=3384
+  _globals['_CONNECTIONSETOPTIONSRESPONSE']._serialized_end=3414
+  _globals['_CONNECTIONINITREQUEST']._serialized_start=3417
+  _globals['_CONNECTIONINITREQUEST']._serialized_end=3554
+  _globals['_CONNECTIONINITRESPONSE']._serialized_start=3556
+  _globals['_CONNECTIONINITRESPONSE']._serialized_end=3580
+  _globals['_CONNECTIONRELEASEREQUEST']._serialized_start=3582
+  _globals['_CONNECTIONRELEASEREQUEST']._serialized_end=3667
+  _globals['_CONNECTIONRELEASERESPONSE']._serialized_start=3669
+  _globals['_CONNECTIONRELEASERESPONSE']._serialized_end=3696
+  _globals['_CONNECTIONGETINFOREQUEST']._serialized_start=3699
+  _globals['_CONNECTIONGETINFOREQUEST']._serialized_end=3834
+  _globals['_CONNECTIONGETINFORESPONSE']._serialized_start=3836
+  _globals['_CONNECTIONGETINFORESPONSE']._serialized_end=3882
+  _globals['_CONNECTIONGETOBJECTSREQUEST']._serialized_start=3885
+  _globals['_CONNECTIONGETOBJECTSREQUEST']._serialized_end=4162
+  _globals['_CONNECTIONGETOBJECTSRESPONSE']._serialized_start=4164
+  _globals['_CONNECTIONGETOBJECTSRESPONSE']._serialized_end=4216
+  _globals['_CONNECTIONGETTABLESCHEMAREQUEST']._serialized_start=4219
+  _globals['_CONNECTIONGETTABLESCHEMAREQUEST']._serialized_end=4403
+  _globals['_CONNECTIONGETTABLESCHEMARESPONSE']._serialized_start=4405
+  _globals['_CONNECTIONGETTABLESCHEMARESPONSE']._serialized_end=4460
+  _globals['_CONNECTIONGETTABLETYPESREQUEST']._serialized_start=4462
+  _globals['_CONNECTIONGETTABLETYPESREQUEST']._serialized_end=4553
+  _globals['_CONNECTIONGETTABLETYPESRESPONSE']._serialized_start=4555
+  _globals['_CONNECTIONGETTABLETYPESRESPONSE']._serialized_end=4614
+  _globals['_CONNECTIONCOMMITREQUEST']._serialized_start=4616
+  _globals['_CONNECTIONCOMMITREQUEST']._serialized_end=4700
+  _globals['_CONNECTIONCOMMITRESPONSE']._serialized_start=4702
+  _globals['_CONNECTIONCOMMITRESPONSE']._serialized_end=4728
+  _globals['_CONNECTIONROLLBACKREQUEST']._serialized_start=4730
+  _globals['_CONNECTIONROLLBACKREQUEST']._serialized_end=4816
+  _globals['_CONNECTIONROLLBACKRESPONSE']._serialized_start=4818
+  _globals['_CONNECTIONROLLBACKRESPONSE']._serialized_end=4846
+  _globals['_STATEMENTNEWREQUEST']._serialized_start=4848
+  _globals['_STATEMENTNEWREQUEST']._serialized_end=4928
+  _globals['_STATEMENTNEWRESPONSE']._serialized_start=4930
+  _globals['_STATEMENTNEWRESPONSE']._serialized_end=5010
+  _globals['_STATEMENTRELEASEREQUEST']._serialized_start=5012
+  _globals['_STATEMENTRELEASEREQUEST']._serialized_end=5095
+  _globals['_STATEMENTRELEASERESPONSE']._serialized_start=5097
+  _globals['_STATEMENTRELEASERESPONSE']._serialized_end=5123
+  _globals['_STATEMENTSETSQLQUERYREQUEST']._serialized_start=5125
+  _globals['_STATEMENTSETSQLQUERYREQUEST']._serialized_end=5227
+  _globals['_STATEMENTSETSQLQUERYRESPONSE']._serialized_start=5229
+  _globals['_STATEMENTSETSQLQUERYRESPONSE']._serialized_end=5259
+  _globals['_STATEMENTSETSUBSTRAITPLANREQUEST']._serialized_start=5261
+  _globals['_STATEMENTSETSUBSTRAITPLANREQUEST']._serialized_end=5367
+  _globals['_STATEMENTSETSUBSTRAITPLANRESPONSE']._serialized_start=5369
+  _globals['_STATEMENTSETSUBSTRAITPLANRESPONSE']._serialized_end=5404
+  _globals['_STATEMENTPREPAREREQUEST']._serialized_start=5406
+  _globals['_STATEMENTPREPAREREQUEST']._serialized_end=5489
+  _globals['_STATEMENTPREPARERESPONSE']._serialized_start=5492
+  _globals['_STATEMENTPREPARERESPONSE']._serialized_end=5639
+  _globals['_STATEMENTSETOPTIONSTRINGREQUEST']._serialized_start=5641
+  _globals['_STATEMENTSETOPTIONSTRINGREQUEST']._serialized_end=5760
+  _globals['_STATEMENTSETOPTIONSTRINGRESPONSE']._serialized_start=5762
+  _globals['_STATEMENTSETOPTIONSTRINGRESPONSE']._serialized_end=5796
+  _globals['_STATEMENTSETOPTIONBYTESREQUEST']._serialized_start=5798
+  _globals['_STATEMENTSETOPTIONBYTESREQUEST']._serialized_end=5916
+  _globals['_STATEMENTSETOPTIONBYTESRESPONSE']._serialized_start=5918
+  _globals['_STATEMENTSETOPTIONBYTESRESPONSE']._serialized_end=5951
+  _globals['_STATEMENTSETOPTIONINTREQUEST']._serialized_start=5953
+  _globals['_STATEMENTSETOPTIONINTREQUEST']._serialized_end=6069
+  _globals['_STATEMENTSETOPTIONINTRESPONSE']._serialized_start=6071
+  _globals['_STATEMENTSETOPTIONINTRESPONSE']._serialized_end=6102
+  _globals['_STATEMENTSETOPTIONDOUBLEREQUEST']._serialized_start=6104
+  _globals['_STATEMENTSETOPTIONDOUBLEREQUEST']._serialized_end=6223
+  _globals['_STATEMENTSETOPTIONDOUBLERESPONSE']._serialized_start=6225
+  _globals['_STATEMENTSETOPTIONDOUBLERESPONSE']._serialized_end=6259
+  _globals['_STATEMENTSETOPTIONSREQUEST']._serialized_start=6262
+  _globals['_STATEMENTSETOPTIONSREQUEST']._serialized_end=6507
+  _globals['_STATEMENTSETOPTIONSREQUEST_OPTIONSENTRY']._serialized_start=3303
+  _globals['_STATEMENTSETOPTIONSREQUEST_OPTIONSENTRY']._serialized_end=3382
+  _globals['_STATEMENTSETOPTIONSRESPONSE']._serialized_start=6509
+  _globals['_STATEMENTSETOPTIONSRESPONSE']._serialized_end=6538
+  _globals['_STATEMENTGETPARAMETERSCHEMAREQUEST']._serialized_start=6540
+  _globals['_STATEMENTGETPARAMETERSCHEMAREQUEST']._serialized_end=6634
+  _globals['_STATEMENTGETPARAMETERSCHEMARESPONSE']._serialized_start=6636
+  _globals['_STATEMENTGETPARAMETERSCHEMARESPONSE']._serialized_end=6725
+  _globals['_STATEMENTBINDREQUEST']._serialized_start=6728
+  _globals['_STATEMENTBINDREQUEST']._serialized_end=6910
+  _globals['_STATEMENTBINDRESPONSE']._serialized_start=6912
+  _globals['_STATEMENTBINDRESPONSE']._serialized_end=6935
+  _globals['_STATEMENTBINDSTREAMREQUEST']._serialized_start=6937
+  _globals['_STATEMENTBINDSTREAMREQUEST']._serialized_end=7039
+  _globals['_STATEMENTBINDSTREAMRESPONSE']._serialized_start=7041
+  _globals['_STATEMENTBINDSTREAMRESPONSE']._serialized_end=7070
+  _globals['_STATEMENTEXECUTEQUERYREQUEST']._serialized_start=7072
+  _globals['_STATEMENTEXECUTEQUERYREQUEST']._serialized_end=7160
+  _globals['_STATEMENTEXECUTEQUERYRESPONSE']._serialized_start=7162
+  _globals['_STATEMENTEXECUTEQUERYRESPONSE']._serialized_end=7244
+  _globals['_STATEMENTEXECUTEPARTITIONSREQUEST']._serialized_start=7246
+  _globals['_STATEMENTEXECUTEPARTITIONSREQUEST']._serialized_end=7339
+  _globals['_STATEMENTEXECUTEPARTITIONSRESPONSE']._serialized_start=7341
+  _globals['_STATEMENTEXECUTEPARTITIONSRESPONSE']._serialized_end=7432
+  _globals['_STATEMENTREADPARTITIONREQUEST']._serialized_start=7434
+  _globals['_STATEMENTREADPARTITIONREQUEST']._serialized_end=7553
+  _globals['_STATEMENTREADPARTITIONRESPONSE']._serialized_start=7555
+  _globals['_STATEMENTREADPARTITIONRESPONSE']._serialized_end=7613
+  _globals['_DATABASEDRIVER']._serialized_start=8594
+  _globals['_DATABASEDRIVER']._serialized_end=13172
 # @@protoc_insertion_point(module_scope)
@@ -59,6 +59,10 @@ class DatabaseDriver(ABC):
     def connection_set_option_double(self, request: ConnectionSetOptionDoubleRequest) -> ConnectionSetOptionDoubleResponse:
         pass
 
+    @abstractmethod
+    def connection_set_options(self, request: ConnectionSetOptionsRequest) -> ConnectionSetOptionsResponse:
+        pass
+
     @abstractmethod
     def connection_init(self, request: ConnectionInitRequest) -> ConnectionInitResponse:
         pass
@@ -127,6 +131,10 @@ class DatabaseDriver(ABC):
     def statement_set_option_double(self, request: StatementSetOptionDoubleRequest) -> StatementSetOptionDoubleResponse:
         pass
 
+    @abstractmethod
+    def statement_set_options(self, request: StatementSetOptionsRequest) -> StatementSetOptionsResponse:
+        pass
+
     @abstractmethod
     def statement_get_parameter_schema(self, request: StatementGetParameterSchemaRequest) -> StatementGetParameterSchemaResponse:
         pass
@@ -170,6 +178,7 @@ class DatabaseDriverServer(DatabaseDriver):
                 'connection_set_option_bytes': (self.connection_set_option_bytes, ConnectionSetOptionBytesRequest),
                 'connection_set_option_int': (self.connection_set_option_int, ConnectionSetOptionIntRequest),
                 'connection_set_option_double': (self.connection_set_option_double, ConnectionSetOptionDoubleRequest),
+                'connection_set_options': (self.connection_set_options, ConnectionSetOptionsRequest),
                 'connection_init': (self.connection_init, ConnectionInitRequest),
                 'connection_release': (self.connection_release, ConnectionReleaseRequest),
                 'connection_get_info': (self.connection_get_info, ConnectionGetInfoRequest),
@@ -187,6 +196,7 @@ class DatabaseDriverServer(DatabaseDriver):
                 'statement_set_option_bytes': (self.statement_set_option_bytes, StatementSetOptionBytesRequest),
                 'statement_set_option_int': (self.statement_set_option_int, StatementSetOptionIntRequest),
                 'statement_set_option_double': (self.statement_set_option_double, StatementSetOptionDoubleRequest),
+                'statement_set_options': (self.statement_set_options, StatementSetOptionsRequest),
                 'statement_get_parameter_schema': (self.statement_get_parameter_schema, StatementGetParameterSchemaRequest),
                 'statement_bind': (self.statement_bind, StatementBindRequest),
                 'statement_bind_stream': (self.statement_bind_stream, StatementBindStreamRequest),
@@ -426,6 +436,13 @@ class DatabaseDriverClient:
             response = ConnectionSetOptionDoubleResponse()
             response.ParseFromString(response_bytes)
             return response
+
+    def connection_set_options(self, request: ConnectionSetOptionsRequest) -> ConnectionSetOptionsResponse:
+        (code, response_bytes) = self._transport.handle_message('DatabaseDriver', 'connection_set_options', request.SerializeToString())
+        if code == 0:
+            response = ConnectionSetOptionsResponse()
+            response.ParseFromString(response_bytes)
+            return response
         elif code == 1:
             error = DriverException()
             error.ParseFromString(response_bytes)
@@ -749,6 +766,13 @@ class DatabaseDriverClient:
             response = StatementSetOptionDoubleResponse()
             response.ParseFromString(response_bytes)
             return response
+
+    def statement_set_options(self, request: StatementSetOptionsRequest) -> StatementSetOptionsResponse:
+        (code, response_bytes) = self._transport.handle_message('DatabaseDriver', 'statement_set_options', request.SerializeToString())
+        if code == 0:
+            response = StatementSetOptionsResponse()
+            response.ParseFromString(response_bytes)
+            return response
         elif code == 1:
             error = DriverException()
             error.ParseFromString(response_bytes)
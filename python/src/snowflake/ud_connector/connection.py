@@ -11,9 +11,8 @@ from snowflake.ud_connector._internal.protobuf_gen.database_driver_v1_services i
     DatabaseNewRequest,
     DatabaseInitRequest,
     ConnectionNewRequest,
-    ConnectionSetOptionIntRequest,
-    ConnectionSetOptionStringRequest,
-    ConnectionSetOptionDoubleRequest,
+    ConnectionSetOptionsRequest,
+    OptionValue,
     ConnectionInitRequest
 )
 
@@ -39,16 +38,18 @@ class Connection:
         self.db_handle = self.db_api.database_new(DatabaseNewRequest()).db_handle
         self.db_api.database_init(DatabaseInitRequest(db_handle=self.db_handle))
         self.conn_handle = self.db_api.connection_new(ConnectionNewRequest()).conn_handle
+        options = {}
         for key, value in kwargs.items():
             if isinstance(value, int):
-                self.db_api.connection_set_option_int(ConnectionSetOptionIntRequest(conn_handle=self.conn_handle, key=key, value=value))
+                options[key] = OptionValue(int_value=value)
 
             if isinstance(value, str):
-                self.db_api.connection_set_option_string(ConnectionSetOptionStringRequest(conn_handle=self.conn_handle, key=key, value=value))
+                options[key] = OptionValue(string_value=value)
 
             if isinstance(value, float):
-                self.db_api.connection_set_option_double(ConnectionSetOptionDoubleRequest(conn_handle=self.conn_handle, key=key, value=value))
+                options[key] = OptionValue(double_value=value)
 
+        self.db_api.connection_set_options(ConnectionSetOptionsRequest(conn_handle=self.conn_handle, options=options))
         self.db_api.connection_init(ConnectionInitRequest(conn_handle=self.conn_handle, db_handle=self.db_handle))
         self.kwargs = kwargs
         self._closed = False
@@ -0,0 +1,111 @@
+//! Heap allocations and time spent turning a downloaded gzip chunk into
+//! record batches: copying the body through `StreamReader` versus decoding
+//! the batches in place from `Bytes`.
+
+use std::alloc::{GlobalAlloc, Layout, System};
+use std::io::{self, Read, Write};
+use std::sync::Arc;
+use std::sync::atomic::{AtomicUsize, Ordering};
+
+use arrow::array::{ArrayRef, Int64Array, RecordBatch, StringArray};
+use arrow::datatypes::{DataType, Field, Schema};
+use arrow_ipc::reader::StreamReader;
+use arrow_ipc::writer::StreamWriter;
+use bench_support::{count_arg, report, time};
+use bytes::Bytes;
+use flate2::Compression;
+use flate2::bufread::GzDecoder;
+use flate2::write::GzEncoder;
+use reqwest::header::HeaderValue;
+use sf_core::bench_internals::{ChunkBatches, decode_chunk_body};
+
+struct CountingAllocator;
+
+static ALLOCATIONS: AtomicUsize = AtomicUsize::new(0);
+static ALLOCATED_BYTES: AtomicUsize = AtomicUsize::new(0);
+
+unsafe impl GlobalAlloc for CountingAllocator {
+    unsafe fn alloc(&self, layout: Layout) -> *mut u8 {
+        ALLOCATIONS.fetch_add(1, Ordering::Relaxed);
+        ALLOCATED_BYTES.fetch_add(layout.size(), Ordering::Relaxed);
+        unsafe { System.alloc(layout) }
+    }
+
+    unsafe fn dealloc(&self, ptr: *mut u8, layout: Layout) {
+        unsafe { System.dealloc(ptr, layout) }
+    }
+
+    unsafe fn realloc(&self, ptr: *mut u8, layout: Layout, new_size: usize) -> *mut u8 {
+        ALLOCATIONS.fetch_add(1, Ordering::Relaxed);
+        ALLOCATED_BYTES.fetch_add(new_size, Ordering::Relaxed);
+        unsafe { System.realloc(ptr, layout, new_size) }
+    }
+}
+
+#[global_allocator]
+static GLOBAL: CountingAllocator = CountingAllocator;
+
+const BATCHES_PER_CHUNK: usize = 8;
+const ROWS_PER_BATCH: i64 = 8192;
+
+fn gzip_chunk() -> Vec<u8> {
+    let schema = Arc::new(Schema::new(vec![
+        Field::new("ID", DataType::Int64, false),
+        Field::new("NAME", DataType::Utf8, false),
+    ]));
+    let mut writer = StreamWriter::try_new(Vec::new(), &schema).unwrap();
+    for batch in 0..BATCHES_PER_CHUNK as i64 {
+        let ids = batch * ROWS_PER_BATCH..(batch + 1) * ROWS_PER_BATCH;
+        let names = StringArray::from_iter_values(ids.clone().map(|id| format!("name-{id}")));
+        let columns: Vec<ArrayRef> =
+            vec![Arc::new(Int64Array::from_iter_values(ids)), Arc::new(names)];
+        writer
+            .write(&RecordBatch::try_new(schema.clone(), columns).unwrap())
+            .unwrap();
+    }
+    let mut encoder = GzEncoder::new(Vec::new(), Compression::default());
+    encoder.write_all(&writer.into_inner().unwrap()).unwrap();
+    encoder.finish().unwrap()
+}
+
+fn copying_path(body: &Bytes) -> usize {
+    let body = body.to_vec();
+    let mut decompressed = Vec::new();
+    GzDecoder::new(body.as_slice())
+        .read_to_end(&mut decompressed)
+        .unwrap();
+    let reader = StreamReader::try_new(io::Cursor::new(decompressed), None).unwrap();
+    reader.map(|batch| batch.unwrap().num_rows()).sum()
+}
+
+fn zero_copy_path(body: &Bytes, encoding: &HeaderValue) -> usize {
+    let data = decode_chunk_body(body.clone(), Some(encoding), None).unwrap();
+    ChunkBatches::new(data)
+        .map(|batch| batch.unwrap().num_rows())
+        .sum()
+}
+
+fn bench(name: &str, iterations: u64, decode: impl FnMut() -> usize) {
+    let allocations = ALLOCATIONS.load(Ordering::Relaxed);
+    let bytes = ALLOCATED_BYTES.load(Ordering::Relaxed);
+    let elapsed = time(iterations, decode);
+    let allocations = (ALLOCATIONS.load(Ordering::Relaxed) - allocations) as u64 / iterations;
+    let bytes = (ALLOCATED_BYTES.load(Ordering::Relaxed) - bytes) as f64 / iterations as f64;
+    report(name, iterations, "chunk", elapsed);
+    println!(
+        "{:<28} {allocations:>10} allocs/chunk  {:>10.1} KiB allocated/chunk",
+        "",
+        bytes / 1024.0
+    );
+}
+
+fn main() {
+    let iterations = count_arg(50);
+
+    let body = Bytes::from(gzip_chunk());
+    let encoding = HeaderValue::from_static("gzip");
+    assert_eq!(copying_path(&body), zero_copy_path(&body, &encoding));
+
+    bench("copying", iterations, || copying_path(&body));
+    bench("zero-copy", iterations, || zero_copy_path(&body, &encoding));
+}
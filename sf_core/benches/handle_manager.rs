@@ -0,0 +1,115 @@
+//! Handle churn from many threads at once, each adding a handle, looking it
+//! up a few times and deleting it: one `RwLock<Vec<_>>` table versus the
+//! sharded `HandleManager`.
+
+use std::sync::{Arc, Barrier, RwLock};
+use std::time::{Duration, Instant};
+
+use bench_support::{count_arg, report};
+use sf_core::handle_manager::{Handle, HandleManager};
+
+const LOOKUPS_PER_HANDLE: usize = 8;
+const THREAD_COUNTS: [usize; 4] = [1, 4, 8, 16];
+
+trait Handles: Send + Sync {
+    fn add(&self, value: u64) -> Handle;
+    fn get(&self, handle: Handle) -> Option<Arc<u64>>;
+    fn delete(&self, handle: Handle) -> bool;
+}
+
+impl Handles for HandleManager<u64> {
+    fn add(&self, value: u64) -> Handle {
+        self.add_handle(value)
+    }
+
+    fn get(&self, handle: Handle) -> Option<Arc<u64>> {
+        self.get_obj(handle)
+    }
+
+    fn delete(&self, handle: Handle) -> bool {
+        self.delete_handle(handle)
+    }
+}
+
+/// The previous design: one lock for the whole table and ids that only grow.
+#[derive(Default)]
+struct GlobalLockTable {
+    handles: RwLock<Vec<(u64, Option<Arc<u64>>)>>,
+}
+
+impl Handles for GlobalLockTable {
+    fn add(&self, value: u64) -> Handle {
+        let mut handles = self.handles.write().unwrap();
+        let handle = Handle {
+            id: handles.len() as u64,
+            magic: rand::random(),
+        };
+        handles.push((handle.magic, Some(Arc::new(value))));
+        handle
+    }
+
+    fn get(&self, handle: Handle) -> Option<Arc<u64>> {
+        let handles = self.handles.read().unwrap();
+        match handles.get(handle.id as usize) {
+            Some((magic, Some(value))) if *magic == handle.magic => Some(value.clone()),
+            _ => None,
+        }
+    }
+
+    fn delete(&self, handle: Handle) -> bool {
+        let mut handles = self.handles.write().unwrap();
+        match handles.get_mut(handle.id as usize) {
+            Some((magic, value)) if *magic == handle.magic => value.take().is_some(),
+            _ => false,
+        }
+    }
+}
+
+fn churn(handles: Arc<dyn Handles>, threads: usize, iterations: u64) -> Duration {
+    let barrier = Arc::new(Barrier::new(threads + 1));
+    let workers: Vec<_> = (0..threads)
+        .map(|_| {
+            let handles = handles.clone();
+            let barrier = barrier.clone();
+            std::thread::spawn(move || {
+                barrier.wait();
+                for i in 0..iterations {
+                    let handle = handles.add(i);
+                    for _ in 0..LOOKUPS_PER_HANDLE {
+                        assert_eq!(*handles.get(handle).unwrap(), i);
+                    }
+                    assert!(handles.delete(handle));
+                }
+            })
+        })
+        .collect();
+    barrier.wait();
+    let start = Instant::now();
+    for worker in workers {
+        worker.join().unwrap();
+    }
+    start.elapsed()
+}
+
+fn main() {
+    let iterations = count_arg(100_000);
+
+    for threads in THREAD_COUNTS {
+        for (name, handles) in [
+            (
+                "global lock",
+                Arc::new(GlobalLockTable::default()) as Arc<dyn Handles>,
+            ),
+            ("sharded", Arc::new(HandleManager::<u64>::new())),
+        ] {
+            let elapsed = churn(handles, threads, iterations);
+            let operations = threads as u64 * iterations * (LOOKUPS_PER_HANDLE as u64 + 2);
+            report(
+                &format!("{name}, {threads} threads"),
+                operations,
+                "op",
+                elapsed,
+            );
+        }
+    }
+}
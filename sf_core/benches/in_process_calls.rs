@@ -0,0 +1,59 @@
+//! Per-statement cost of calling sf_core from a driver linked into the same
+//! binary, allocating, configuring and releasing a statement: the protobuf
+//! client versus the typed in-process client.
+
+use bench_support::{count_arg, report, time};
+use sf_core::protobuf_apis::database_driver_v1::{DatabaseDriverClient, DatabaseDriverLocalClient};
+use sf_core::protobuf_gen::database_driver_v1::{
+    ConnectionHandle, ConnectionNewRequest, StatementNewRequest, StatementReleaseRequest,
+    StatementSetOptionStringRequest, StatementSetSqlQueryRequest,
+};
+
+const QUERY: &str = "SELECT c_custkey, c_name, c_acctbal FROM customer WHERE c_nationkey = ?";
+const OPTIONS: [(&str, &str); 3] = [
+    ("chunk_prefetch_depth", "4"),
+    ("chunk_streaming", "false"),
+    ("query_tag", "nightly-extract"),
+];
+
+macro_rules! statement_round_trip {
+    ($client:ty, $conn:expr) => {{
+        let stmt_handle = <$client>::statement_new(StatementNewRequest {
+            conn_handle: Some($conn),
+        })
+        .unwrap()
+        .stmt_handle;
+        <$client>::statement_set_sql_query(StatementSetSqlQueryRequest {
+            stmt_handle,
+            query: QUERY.to_string(),
+        })
+        .unwrap();
+        for (key, value) in OPTIONS {
+            <$client>::statement_set_option_string(StatementSetOptionStringRequest {
+                stmt_handle,
+                key: key.to_string(),
+                value: value.to_string(),
+            })
+            .unwrap();
+        }
+        <$client>::statement_release(StatementReleaseRequest { stmt_handle }).unwrap();
+    }};
+}
+
+fn main() {
+    let iterations = count_arg(100_000);
+
+    let conn: ConnectionHandle = DatabaseDriverLocalClient::connection_new(ConnectionNewRequest {})
+        .unwrap()
+        .conn_handle
+        .unwrap();
+
+    let elapsed = time(iterations, || {
+        statement_round_trip!(DatabaseDriverClient, conn)
+    });
+    report("protobuf", iterations, "statement", elapsed);
+    let elapsed = time(iterations, || {
+        statement_round_trip!(DatabaseDriverLocalClient, conn)
+    });
+    report("in-process", iterations, "statement", elapsed);
+}
@@ -0,0 +1,113 @@
+//! Per-query overhead of getting a blocking API call onto a tokio runtime: a
+//! fresh runtime per call versus the driver-wide one. Each call sends a real
+//! query request through `snowflake_query_with_client` to a local HTTP server
+//! that answers with an empty result, so the numbers include what the request
+//! path pays for the runtime, such as pooled connections that die with it.
+
+use std::collections::HashMap;
+use std::io::{BufRead, BufReader, Read, Write};
+use std::net::{TcpListener, TcpStream};
+
+use bench_support::{count_arg, report, time};
+use sf_core::config::rest_parameters::QueryParameters;
+use sf_core::config::retry::RetryPolicy;
+use sf_core::config::settings::Setting;
+use sf_core::rest::snowflake::{QueryExecutionMode, snowflake_query_with_client};
+
+const EMPTY_RESULT: &str = r#"{"success":true,"data":{"rowset":null,"rowsetBase64":null}}"#;
+
+/// Serves every request on every connection with `EMPTY_RESULT`, keeping
+/// connections open so the client can reuse them.
+fn serve(listener: TcpListener) {
+    for stream in listener.incoming().flatten() {
+        std::thread::spawn(move || {
+            let _ = serve_connection(stream);
+        });
+    }
+}
+
+fn serve_connection(stream: TcpStream) -> std::io::Result<()> {
+    let mut reader = BufReader::new(stream.try_clone()?);
+    let mut writer = stream;
+    loop {
+        let mut content_length = 0;
+        let mut line = String::new();
+        loop {
+            line.clear();
+            if reader.read_line(&mut line)? == 0 {
+                return Ok(());
+            }
+            let header = line.trim_end();
+            if header.is_empty() {
+                break;
+            }
+            if let Some((name, value)) = header.split_once(':')
+                && name.eq_ignore_ascii_case("content-length")
+            {
+                content_length = value.trim().parse().unwrap_or(0);
+            }
+        }
+        reader.read_exact(&mut vec![0; content_length])?;
+        write!(
+            writer,
+            "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nContent-Length: {}\r\n\r\n{EMPTY_RESULT}",
+            EMPTY_RESULT.len()
+        )?;
+    }
+}
+
+/// Sends one query through the same path statement execution uses.
+async fn query(
+    client: &reqwest::Client,
+    query_parameters: &QueryParameters,
+    retry_policy: &RetryPolicy,
+) -> bool {
+    snowflake_query_with_client(
+        client,
+        query_parameters.clone(),
+        "token".to_string(),
+        "SELECT 1".to_string(),
+        None,
+        retry_policy,
+        QueryExecutionMode::Blocking,
+    )
+    .await
+    .is_ok()
+}
+
+fn main() {
+    let iterations = count_arg(200);
+
+    let listener = TcpListener::bind("127.0.0.1:0").unwrap();
+    let server_url = format!("http://{}", listener.local_addr().unwrap());
+    std::thread::spawn(move || serve(listener));
+
+    let settings = HashMap::from([("server_url".to_string(), Setting::String(server_url))]);
+    let query_parameters = QueryParameters::from_settings(&settings).unwrap();
+    let retry_policy = RetryPolicy::default();
+
+    // A client per variant, kept across calls as a connection keeps it.
+    // Connections it pools die with the runtime that opened them, which is
+    // part of the cost being measured, so failures are counted rather than
+    // aborting the run.
+    let client = reqwest::Client::new();
+    let mut failed = 0;
+    let elapsed = time(iterations, || {
+        let rt = tokio::runtime::Runtime::new().unwrap();
+        failed += !rt.block_on(query(&client, &query_parameters, &retry_policy)) as u64;
+    });
+    report("runtime per call", iterations, "query", elapsed);
+
+    let client = reqwest::Client::new();
+    // Warm the shared runtime so its one-time start-up is not attributed to the loop.
+    sf_core::runtime::block_on(query(&client, &query_parameters, &retry_policy)).unwrap();
+    let elapsed = time(iterations, || {
+        failed += !sf_core::runtime::block_on(query(&client, &query_parameters, &retry_policy))
+            .unwrap() as u64;
+    });
+    report("shared runtime", iterations, "query", elapsed);
+
+    if failed > 0 {
+        println!("{failed} queries failed");
+    }
+}
@@ -0,0 +1,57 @@
+//! Cost per file of getting an S3 client for PUT or GET: a new SDK config
+//! and client per file versus one client shared by the whole command.
+//! Nothing is sent to S3, so the connection setup and TLS handshakes a shared
+//! client saves are not included; only config loading and client creation
+//! are measured.
+
+use aws_config::{BehaviorVersion, Region};
+use aws_sdk_s3::Client as S3Client;
+use bench_support::{count_arg, report, time};
+use sf_core::bench_internals::{Credentials, StageInfo, s3_client};
+
+fn stage_info() -> StageInfo {
+    StageInfo {
+        bucket: "sfc-stage".to_string(),
+        key_prefix: "stages/bench/".to_string(),
+        region: "us-west-2".to_string(),
+        creds: Credentials {
+            aws_key_id: "AKIABENCHMARK".to_string(),
+            aws_secret_key: "secret".to_string(),
+            aws_token: "token".to_string(),
+        },
+    }
+}
+
+/// The previous design: a new SDK config and client for every file.
+async fn client_per_file(stage_info: &StageInfo) -> S3Client {
+    let credentials = aws_credential_types::Credentials::new(
+        &stage_info.creds.aws_key_id,
+        &stage_info.creds.aws_secret_key,
+        Some(stage_info.creds.aws_token.clone()),
+        None,
+        "snowflake-upload",
+    );
+    let config = aws_config::defaults(BehaviorVersion::latest())
+        .credentials_provider(credentials)
+        .region(Region::new(stage_info.region.clone()))
+        .load()
+        .await;
+    S3Client::new(&config)
+}
+
+fn main() {
+    let files = count_arg(5_000);
+    let stage_info = stage_info();
+    let rt = tokio::runtime::Runtime::new().unwrap();
+
+    let elapsed = time(files, || rt.block_on(client_per_file(&stage_info)));
+    report("client per file", files, "file", elapsed);
+
+    let elapsed = time(1, || {
+        let client = rt.block_on(s3_client(&stage_info));
+        for _ in 0..files {
+            std::hint::black_box(client.clone());
+        }
+    });
+    report("client per command", files, "file", elapsed);
+}
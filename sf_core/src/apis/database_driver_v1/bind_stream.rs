@@ -0,0 +1,104 @@
+use arrow::array::{RecordBatch, RecordBatchReader};
+use arrow::compute::concat_batches;
+use arrow::error::ArrowError;
+
+use crate::config::ConfigError;
+use crate::config::settings::{Settings, positive_int_setting};
+
+pub const BIND_STREAM_FLUSH_ROWS_OPTION: &str = "bind_stream_flush_rows";
+
+const DEFAULT_BIND_STREAM_FLUSH_ROWS: usize = 100_000;
+
+/// Number of streamed parameter sets sent with each execution of the query.
+pub fn bind_stream_flush_rows(settings: &dyn Settings) -> Result<usize, ConfigError> {
+    Ok(
+        positive_int_setting(settings, BIND_STREAM_FLUSH_ROWS_OPTION)?
+            .unwrap_or(DEFAULT_BIND_STREAM_FLUSH_ROWS),
+    )
+}
+
+/// Regroups a stream of parameter batches into batches of `flush_rows` rows,
+/// the last one possibly shorter. Batches are read from the stream only as
+/// the groups are consumed, so at most one group is held at a time.
+pub struct ParameterGroups<R> {
+    reader: R,
+    flush_rows: usize,
+    // Rest of a batch that did not fit into the previous group
+    pending: Option<RecordBatch>,
+}
+
+impl<R: RecordBatchReader> ParameterGroups<R> {
+    pub fn new(reader: R, flush_rows: usize) -> Self {
+        Self {
+            reader,
+            flush_rows,
+            pending: None,
+        }
+    }
+}
+
+impl<R: RecordBatchReader> Iterator for ParameterGroups<R> {
+    type Item = Result<RecordBatch, ArrowError>;
+
+    fn next(&mut self) -> Option<Self::Item> {
+        let mut parts = Vec::new();
+        let mut rows = 0;
+        while rows < self.flush_rows {
+            let batch = match self.pending.take() {
+                Some(batch) => batch,
+                None => match self.reader.next() {
+                    Some(Ok(batch)) => batch,
+                    Some(Err(e)) => return Some(Err(e)),
+                    None => break,
+                },
+            };
+            let taken = batch.num_rows().min(self.flush_rows - rows);
+            if taken < batch.num_rows() {
+                self.pending = Some(batch.slice(taken, batch.num_rows() - taken));
+            }
+            rows += taken;
+            parts.push(batch.slice(0, taken));
+        }
+        if rows == 0 {
+            return None;
+        }
+        Some(concat_batches(&self.reader.schema(), &parts))
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use arrow::array::{Array, Int32Array, RecordBatchIterator};
+    use arrow::datatypes::{DataType, Field, Schema};
+    use std::sync::Arc;
+
+    #[test]
+    fn regroups_batches_into_flush_sized_groups() {
+        let schema = Arc::new(Schema::new(vec![Field::new(
+            "param_1",
+            DataType::Int32,
+            true,
+        )]));
+        let batch = |values: Vec<i32>| {
+            RecordBatch::try_new(schema.clone(), vec![Arc::new(Int32Array::from(values))])
+        };
+        let reader = RecordBatchIterator::new(
+            vec![
+                batch(vec![1, 2, 3]),
+                batch(vec![]),
+                batch(vec![4, 5, 6, 7, 8]),
+            ],
+            schema.clone(),
+        );
+
+        let groups = ParameterGroups::new(reader, 3)
+            .map(|group| {
+                let group = group.unwrap();
+                let column = group.column(0).as_any().downcast_ref::<Int32Array>();
+                column.unwrap().values().to_vec()
+            })
+            .collect::<Vec<_>>();
+        assert_eq!(groups, vec![vec![1, 2, 3], vec![4, 5, 6], vec![7, 8]]);
+    }
+}
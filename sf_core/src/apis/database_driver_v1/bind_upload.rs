@@ -0,0 +1,247 @@
+use std::io::{BufWriter, Write};
+
+use arrow::array::{Array, Int32Array, RecordBatch, StringArray};
+use arrow::datatypes::DataType;
+use snafu::{Location, ResultExt, Snafu};
+
+use crate::config::ConfigError;
+use crate::config::rest_parameters::QueryParameters;
+use crate::config::retry::RetryPolicy;
+use crate::config::settings::{Settings, positive_int_setting};
+use crate::file_manager::{FileManagerError, MultipartConfig, upload_files};
+use crate::rest::snowflake::query_response::QueryResponseError;
+use crate::rest::snowflake::{QueryExecutionMode, RestError, snowflake_query_with_client};
+
+pub const STAGE_BINDING_THRESHOLD_OPTION: &str = "stage_binding_threshold";
+
+// Server default of CLIENT_STAGE_ARRAY_BINDING_THRESHOLD
+const DEFAULT_STAGE_BINDING_THRESHOLD: usize = 65_280;
+const BIND_STAGE: &str = "SYSTEM$BIND";
+const CREATE_BIND_STAGE: &str = "CREATE TEMPORARY STAGE IF NOT EXISTS SYSTEM$BIND \
+    file_format=(type=csv field_optionally_enclosed_by='\"')";
+
+/// Number of bound values, rows times columns, above which parameter sets are
+/// uploaded to a stage instead of being sent in the query request.
+pub fn stage_binding_threshold(settings: &dyn Settings) -> Result<usize, ConfigError> {
+    Ok(
+        positive_int_setting(settings, STAGE_BINDING_THRESHOLD_OPTION)?
+            .unwrap_or(DEFAULT_STAGE_BINDING_THRESHOLD),
+    )
+}
+
+pub fn should_stage(bindings: &RecordBatch, threshold: usize) -> bool {
+    bindings.num_rows() > 1 && bindings.num_rows() * bindings.num_columns() > threshold
+}
+
+/// Writes the parameter sets as CSV to a new location in the session's
+/// temporary bind stage and returns that location for the query's `bindStage`.
+/// The stage is created first unless `stage_created` says the session
+/// already has it.
+pub async fn upload_bindings(
+    client: &reqwest::Client,
+    query_parameters: &QueryParameters,
+    session_token: &str,
+    retry_policy: &RetryPolicy,
+    bindings: &RecordBatch,
+    stage_created: bool,
+    multipart_config: MultipartConfig,
+) -> Result<String, BindUploadError> {
+    let query = |sql: String| {
+        snowflake_query_with_client(
+            client,
+            query_parameters.clone(),
+            session_token.to_string(),
+            sql,
+            None,
+            retry_policy,
+            QueryExecutionMode::Blocking,
+        )
+    };
+    if !stage_created {
+        query(CREATE_BIND_STAGE.to_string())
+            .await
+            .context(StageCreationSnafu)?;
+    }
+
+    let mut file = tempfile::Builder::new()
+        .prefix("sf_binds_")
+        .suffix(".csv")
+        .tempfile()
+        .context(IoSnafu)?;
+    let mut writer = BufWriter::new(file.as_file_mut());
+    write_csv(bindings, &mut writer)?;
+    writer.flush().context(IoSnafu)?;
+    drop(writer);
+
+    let location = format!("@{BIND_STAGE}/{}", uuid::Uuid::new_v4());
+    let put = query(put_statement(&file.path().to_string_lossy(), &location))
+        .await
+        .context(PutSnafu)?;
+    let upload_data = put
+        .data
+        .to_file_upload_data(multipart_config)
+        .context(FileTransferPreparationSnafu)?;
+    upload_files(&upload_data).await.context(FileUploadSnafu)?;
+    Ok(location)
+}
+
+/// Quotes in the local path are doubled so a temp dir containing `'` still
+/// yields a single string literal.
+fn put_statement(path: &str, location: &str) -> String {
+    let path = path.replace('\\', "/").replace('\'', "''");
+    format!("PUT 'file://{path}' '{location}' overwrite=true auto_compress=true")
+}
+
+enum CsvColumn<'a> {
+    Int32(&'a Int32Array),
+    Utf8(&'a StringArray),
+}
+
+/// Writes one line per parameter set. Text is always quoted, so an empty
+/// unquoted field is NULL and `""` is an empty string.
+fn write_csv(bindings: &RecordBatch, out: &mut impl Write) -> Result<(), BindUploadError> {
+    let columns = bindings
+        .columns()
+        .iter()
+        .map(|column| match column.data_type() {
+            DataType::Int32 => Ok(CsvColumn::Int32(
+                column.as_any().downcast_ref::<Int32Array>().unwrap(),
+            )),
+            DataType::Utf8 => Ok(CsvColumn::Utf8(
+                column.as_any().downcast_ref::<StringArray>().unwrap(),
+            )),
+            data_type => UnsupportedTypeSnafu {
+                type_: data_type.to_string(),
+            }
+            .fail(),
+        })
+        .collect::<Result<Vec<_>, _>>()?;
+
+    for row in 0..bindings.num_rows() {
+        for (index, column) in columns.iter().enumerate() {
+            if index > 0 {
+                out.write_all(b",").context(IoSnafu)?;
+            }
+            match column {
+                CsvColumn::Int32(array) if array.is_valid(row) => {
+                    write!(out, "{}", array.value(row)).context(IoSnafu)?
+                }
+                CsvColumn::Utf8(array) if array.is_valid(row) => {
+                    write!(out, "\"{}\"", array.value(row).replace('"', "\"\"")).context(IoSnafu)?
+                }
+                _ => {}
+            }
+        }
+        out.write_all(b"\n").context(IoSnafu)?;
+    }
+    Ok(())
+}
+
+#[derive(Debug, Snafu)]
+pub enum BindUploadError {
+    #[snafu(display("Unsupported bind parameter type for stage binding: {type_}"))]
+    UnsupportedType {
+        type_: String,
+        #[snafu(implicit)]
+        location: Location,
+    },
+    #[snafu(display("Failed to write bindings file"))]
+    Io {
+        source: std::io::Error,
+        #[snafu(implicit)]
+        location: Location,
+    },
+    #[snafu(display("Failed to create the bind stage"))]
+    StageCreation {
+        source: RestError,
+        #[snafu(implicit)]
+        location: Location,
+    },
+    #[snafu(display("Failed to put bindings to the bind stage"))]
+    Put {
+        source: RestError,
+        #[snafu(implicit)]
+        location: Location,
+    },
+    #[snafu(display("Failed to prepare bindings upload"))]
+    FileTransferPreparation {
+        source: QueryResponseError,
+        #[snafu(implicit)]
+        location: Location,
+    },
+    #[snafu(display("Failed to upload bindings"))]
+    FileUpload {
+        source: FileManagerError,
+        #[snafu(implicit)]
+        location: Location,
+    },
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::config::settings::Setting;
+    use arrow::datatypes::{Field, Schema};
+    use std::collections::HashMap;
+    use std::sync::Arc;
+
+    fn bindings(ids: Vec<Option<i32>>, names: Vec<Option<&str>>) -> RecordBatch {
+        let schema = Arc::new(Schema::new(vec![
+            Field::new("param_1", DataType::Int32, true),
+            Field::new("param_2", DataType::Utf8, true),
+        ]));
+        RecordBatch::try_new(
+            schema,
+            vec![
+                Arc::new(Int32Array::from(ids)),
+                Arc::new(StringArray::from(names)),
+            ],
+        )
+        .unwrap()
+    }
+
+    #[test]
+    fn writes_nulls_empty_strings_and_quotes() {
+        let batch = bindings(
+            vec![Some(1), None, Some(-3)],
+            vec![Some("say \"hi\", bye"), Some(""), None],
+        );
+        let mut csv = Vec::new();
+        write_csv(&batch, &mut csv).unwrap();
+        assert_eq!(
+            String::from_utf8(csv).unwrap(),
+            "1,\"say \"\"hi\"\", bye\"\n,\"\"\n-3,\n"
+        );
+    }
+
+    #[test]
+    fn put_statement_escapes_quotes_in_path() {
+        assert_eq!(
+            put_statement("C:\\Temp\\o'brien\\sf_binds_1.csv", "@SYSTEM$BIND/1"),
+            "PUT 'file://C:/Temp/o''brien/sf_binds_1.csv' '@SYSTEM$BIND/1' \
+             overwrite=true auto_compress=true"
+        );
+    }
+
+    #[test]
+    fn stages_only_parameter_set_arrays_above_threshold() {
+        let settings = HashMap::from([(
+            STAGE_BINDING_THRESHOLD_OPTION.to_string(),
+            Setting::String("4".to_string()),
+        )]);
+        let threshold = stage_binding_threshold(&settings).unwrap();
+        assert_eq!(threshold, 4);
+        assert!(!should_stage(
+            &bindings(vec![Some(1); 2], vec![None; 2]),
+            threshold
+        ));
+        assert!(should_stage(
+            &bindings(vec![Some(1); 3], vec![None; 3]),
+            threshold
+        ));
+        assert_eq!(
+            stage_binding_threshold(&HashMap::<String, Setting>::new()).unwrap(),
+            DEFAULT_STAGE_BINDING_THRESHOLD
+        );
+    }
+}
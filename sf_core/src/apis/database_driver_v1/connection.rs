@@ -13,9 +13,6 @@ use reqwest;
 pub fn connection_init(conn_handle: Handle, _db_handle: Handle) -> Result<(), ApiError> {
     match CONN_HANDLE_MANAGER.get_obj(conn_handle) {
         Some(conn_ptr) => {
-            // Create a blocking runtime for the login process
-            let rt = tokio::runtime::Runtime::new().context(RuntimeCreationSnafu)?;
-
             let settings_guard = conn_ptr
                 .lock()
                 .map_err(|_| ConnectionLockingSnafu {}.build())?;
@@ -27,7 +24,8 @@ pub fn connection_init(conn_handle: Handle, _db_handle: Handle) -> Result<(), Ap
                 create_tls_client_with_config(login_parameters.client_info.tls_config.clone())
                     .context(TlsClientCreationSnafu)?;
 
-            let login_result = rt
+            let login_result = crate::runtime::global_runtime()
+                .context(RuntimeCreationSnafu)?
                 .block_on(async {
                     crate::rest::snowflake::snowflake_login_with_client(
                         &http_client,
@@ -66,6 +64,27 @@ pub fn connection_set_option(handle: Handle, key: String, value: Setting) -> Res
     }
 }
 
+/// Applies all settings under a single lock, so no other caller observes
+/// a partially configured connection.
+pub fn connection_set_options(
+    handle: Handle,
+    options: HashMap<String, Setting>,
+) -> Result<(), ApiError> {
+    match CONN_HANDLE_MANAGER.get_obj(handle) {
+        Some(conn_ptr) => {
+            let mut conn = conn_ptr
+                .lock()
+                .map_err(|_| ConnectionLockingSnafu {}.build())?;
+            conn.settings.extend(options);
+            Ok(())
+        }
+        None => InvalidArgumentSnafu {
+            argument: "Connection handle not found".to_string(),
+        }
+        .fail(),
+    }
+}
+
 pub fn connection_new() -> Handle {
     CONN_HANDLE_MANAGER.add_handle(Mutex::new(Connection::new()))
 }
@@ -85,6 +104,8 @@ pub struct Connection {
     pub session_token: Option<String>,
     pub http_client: Option<reqwest::Client>,
     pub retry_policy: RetryPolicy,
+    /// Whether the session's temporary bind stage has been created
+    pub bind_stage_created: bool,
 }
 
 impl Default for Connection {
@@ -100,11 +121,14 @@ impl Connection {
             session_token: None,
             http_client: None,
             retry_policy: RetryPolicy::default(),
+            bind_stage_created: false,
         }
     }
 
     fn initialize(&mut self, session_token: String, http_client: reqwest::Client) {
         self.session_token = Some(session_token);
         self.http_client = Some(http_client);
+        // Temporary stages do not outlive the session
+        self.bind_stage_created = false;
     }
 }
@@ -1,9 +1,11 @@
+use snafu::ResultExt;
 use std::sync::Mutex;
 
 use super::Handle;
 use super::Setting;
 use super::error::*;
 use super::global_state::DB_HANDLE_MANAGER;
+use crate::runtime::{RuntimeConfig, configure_runtime};
 
 pub fn database_new() -> Handle {
     DB_HANDLE_MANAGER.add_handle(Mutex::new(Database::new()))
@@ -27,7 +29,15 @@ pub fn database_set_option(db_handle: Handle, key: String, value: Setting) -> Re
 pub fn database_init(db_handle: Handle) -> Result<(), ApiError> {
     let handle = db_handle;
     match DB_HANDLE_MANAGER.get_obj(handle) {
-        Some(_db_ptr) => Ok(()),
+        Some(db_ptr) => {
+            let db = db_ptr.lock().map_err(|_| DatabaseLockingSnafu {}.build())?;
+            if let Some(config) =
+                RuntimeConfig::from_settings(&db.settings).context(ConfigurationSnafu)?
+            {
+                configure_runtime(config);
+            }
+            Ok(())
+        }
         None => InvalidArgumentSnafu {
             argument: "Database handle not found".to_string(),
         }
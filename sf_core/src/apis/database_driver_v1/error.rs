@@ -1,5 +1,6 @@
 use snafu::{Location, Snafu};
 
+pub use crate::apis::database_driver_v1::bind_upload::BindUploadError;
 pub use crate::apis::database_driver_v1::query::QueryResponseProcessingError;
 pub use crate::config::ConfigError;
 pub use crate::rest::snowflake::RestError;
@@ -70,4 +71,21 @@ pub enum ApiError {
         #[snafu(source(from(QueryResponseProcessingError, Box::new)))]
         source: Box<QueryResponseProcessingError>,
     },
+    #[snafu(display("Failed to upload bindings to a stage: {source}"))]
+    BindUpload {
+        #[snafu(implicit)]
+        location: Location,
+        source: BindUploadError,
+    },
+    #[snafu(display(
+        "Bound parameter stream failed after {executed} parameter sets were executed: {source}"
+    ))]
+    PartialBindStream {
+        /// Parameter sets whose executions already committed
+        executed: u64,
+        #[snafu(implicit)]
+        location: Location,
+        #[snafu(source(from(ApiError, Box::new)))]
+        source: Box<ApiError>,
+    },
 }
@@ -1,4 +1,6 @@
 #![allow(clippy::result_large_err)]
+mod bind_stream;
+mod bind_upload;
 mod connection;
 mod database;
 pub(crate) mod error;
@@ -12,15 +14,21 @@ pub use connection::connection_init;
 pub use connection::connection_new;
 pub use connection::connection_release;
 pub use connection::connection_set_option;
+pub use connection::connection_set_options;
 pub use database::database_init;
 pub use database::database_new;
 pub use database::database_release;
 pub use database::database_set_option;
 pub use error::ApiError;
 pub use statement::statement_bind;
+pub use statement::statement_bind_stream;
+pub use statement::statement_execute_partitions;
 pub use statement::statement_execute_query;
+pub use statement::statement_get_parameter_schema;
 pub use statement::statement_new;
 pub use statement::statement_prepare;
+pub use statement::statement_read_partition;
 pub use statement::statement_release;
 pub use statement::statement_set_option;
+pub use statement::statement_set_options;
 pub use statement::statement_set_sql_query;
@@ -1,18 +1,25 @@
 use crate::arrow_utils::ArrowUtilsError;
-use crate::arrow_utils::{
-    boxed_arrow_reader, convert_string_rowset_to_arrow_reader, create_schema,
+use crate::arrow_utils::{boxed_arrow_reader, create_schema, decode_json_rowset_to_arrow_reader};
+use crate::chunks::{
+    ChunkError, ChunkPrefetchConfig, ChunkReader, PartitionDescriptor, read_chunk_schema,
 };
-use crate::chunks::{ChunkError, ChunkReader};
 use crate::file_manager;
-use crate::file_manager::{DownloadResult, UploadResult, download_files, upload_files};
+use crate::file_manager::{
+    DownloadResult, MultipartConfig, UploadResult, download_files, upload_files,
+};
 use crate::query_types::RowType;
 use crate::rest;
-use arrow::array::{Array, Int64Array, RecordBatchReader, StringArray};
+use arrow::array::{Array, Int64Array, RecordBatch, RecordBatchReader, StringArray};
+use arrow::datatypes::{DataType, Field, Schema, SchemaRef};
 use arrow::error::ArrowError;
+use arrow::ffi::FFI_ArrowSchema;
+use arrow_ipc::writer::StreamWriter;
 use base64::{Engine, engine::general_purpose::STANDARD as BASE64};
+use bytes::Bytes;
 use reqwest::Client;
 use rest::snowflake::query_response::{self, QueryResponseError};
-use snafu::{Location, ResultExt, Snafu};
+use snafu::{Location, OptionExt, ResultExt, Snafu};
+use std::collections::{HashMap, VecDeque};
 use std::sync::Arc;
 
 const PUT_GET_ROWSET_TEXT_LENGTH: u64 = 10000;
@@ -21,23 +28,209 @@ const PUT_GET_ROWSET_FIXED_LENGTH: u64 = 64;
 pub async fn process_query_response(
     data: &query_response::Data,
     http_client: &Client,
+    prefetch_config: ChunkPrefetchConfig,
+    multipart_config: MultipartConfig,
 ) -> Result<Box<dyn RecordBatchReader + Send>, QueryResponseProcessingError> {
     match data.command {
-        Some(ref command) => perform_put_get(command.clone(), data).await,
-        None => read_batches(data, http_client)
+        Some(ref command) => perform_put_get(command.clone(), data, multipart_config).await,
+        None => read_batches(data, http_client, prefetch_config)
             .await
             .context(BatchReadingSnafu),
     }
 }
 
+/// Chunks of a result, each described by a serialized `PartitionDescriptor`.
+pub struct ResultPartitions {
+    pub schema: FFI_ArrowSchema,
+    pub partitions: Vec<Vec<u8>>,
+}
+
+/// Describes every chunk of the response as a partition that can be read on
+/// its own. Results without remote chunks become a single inline partition.
+pub async fn partition_query_response(
+    data: &query_response::Data,
+    http_client: &Client,
+    multipart_config: MultipartConfig,
+) -> Result<ResultPartitions, QueryResponseProcessingError> {
+    let (schema, descriptors) = match data.command {
+        Some(ref command) => {
+            let reader = perform_put_get(command.clone(), data, multipart_config).await?;
+            let (schema, descriptor) = inline_partition(reader).context(PartitionEncodingSnafu)?;
+            (schema, vec![descriptor])
+        }
+        None => partition_batches(data, http_client)
+            .await
+            .context(BatchReadingSnafu)?,
+    };
+    Ok(ResultPartitions {
+        schema: export_schema(&schema)?,
+        partitions: descriptors
+            .iter()
+            .map(PartitionDescriptor::to_bytes)
+            .collect(),
+    })
+}
+
+pub fn export_schema(schema: &Schema) -> Result<FFI_ArrowSchema, QueryResponseProcessingError> {
+    FFI_ArrowSchema::try_from(schema).context(SchemaExportSnafu)
+}
+
+/// Result and parameter metadata of a query the server only described.
+#[derive(Clone, Debug)]
+pub struct QueryDescription {
+    pub result_schema: SchemaRef,
+    /// One field per bind marker, named after the bind or its position
+    pub parameter_schema: SchemaRef,
+}
+
+pub fn describe_query_response(data: &query_response::Data) -> QueryDescription {
+    let result_fields = data
+        .row_type
+        .iter()
+        .flatten()
+        .map(|row_type| {
+            described_field(
+                &row_type.name,
+                &row_type.type_,
+                row_type.nullable,
+                [
+                    ("precision", row_type.precision),
+                    ("scale", row_type.scale),
+                    ("charLength", row_type.length),
+                    ("byteLength", row_type.byte_length),
+                ],
+            )
+        })
+        .collect::<Vec<_>>();
+
+    let parameter_fields = match &data.meta_data_of_binds {
+        Some(binds) => binds
+            .iter()
+            .enumerate()
+            .map(|(index, bind)| {
+                let position = (index + 1).to_string();
+                described_field(
+                    bind.name.as_deref().unwrap_or(&position),
+                    &bind.type_,
+                    bind.nullable,
+                    [
+                        ("precision", bind.precision),
+                        ("scale", bind.scale),
+                        ("charLength", bind.length),
+                        ("byteLength", bind.byte_length),
+                    ],
+                )
+            })
+            .collect(),
+        // Only the count is known, the binds are sent as text
+        None => (1..=data.number_of_binds.unwrap_or(0).max(0))
+            .map(|position| described_field(&position.to_string(), "TEXT", true, []))
+            .collect(),
+    };
+
+    QueryDescription {
+        result_schema: Arc::new(Schema::new(result_fields)),
+        parameter_schema: Arc::new(Schema::new(parameter_fields)),
+    }
+}
+
+/// Field carrying the metadata Snowflake attaches to the fields of its Arrow
+/// results, so described columns look like executed ones.
+fn described_field<const N: usize>(
+    name: &str,
+    type_: &str,
+    nullable: bool,
+    attributes: [(&str, Option<u64>); N],
+) -> Field {
+    let logical_type = type_.to_uppercase();
+    let data_type = match logical_type.as_str() {
+        "FIXED" => DataType::Int64,
+        "REAL" => DataType::Float64,
+        "BOOLEAN" => DataType::Boolean,
+        _ => DataType::Utf8,
+    };
+    let mut metadata = HashMap::from([("logicalType".to_string(), logical_type)]);
+    metadata.extend(
+        attributes
+            .into_iter()
+            .filter_map(|(key, value)| Some((key.to_string(), value?.to_string()))),
+    );
+    Field::new(name, data_type, nullable).with_metadata(metadata)
+}
+
+/// Reader for one execution's result, created only when it is its turn to
+/// be read.
+pub type PendingReader =
+    Box<dyn FnOnce() -> Result<Box<dyn RecordBatchReader + Send>, ArrowError> + Send>;
+
+/// Reads the results of several executions of one query one after another.
+/// Each pending result becomes a reader once the previous one is exhausted,
+/// so only one of them fetches chunks at a time. The readers must share the
+/// schema of `first`.
+pub fn chain_readers(
+    first: Box<dyn RecordBatchReader + Send>,
+    pending: Vec<PendingReader>,
+) -> Box<dyn RecordBatchReader + Send> {
+    if pending.is_empty() {
+        return first;
+    }
+    Box::new(ChainedReader {
+        schema: first.schema(),
+        current: Some(first),
+        pending: pending.into(),
+    })
+}
+
+struct ChainedReader {
+    schema: SchemaRef,
+    current: Option<Box<dyn RecordBatchReader + Send>>,
+    pending: VecDeque<PendingReader>,
+}
+
+impl Iterator for ChainedReader {
+    type Item = Result<RecordBatch, ArrowError>;
+
+    fn next(&mut self) -> Option<Self::Item> {
+        loop {
+            if let Some(batch) = self.current.as_mut()?.next() {
+                return Some(batch);
+            }
+            self.current = None;
+            match (self.pending.pop_front()?)() {
+                Ok(reader) => self.current = Some(reader),
+                Err(e) => return Some(Err(e)),
+            }
+        }
+    }
+}
+
+impl RecordBatchReader for ChainedReader {
+    fn schema(&self) -> SchemaRef {
+        self.schema.clone()
+    }
+}
+
+pub async fn read_partition(
+    descriptor: &PartitionDescriptor,
+    http_client: &Client,
+) -> Result<Box<dyn RecordBatchReader + Send>, QueryResponseProcessingError> {
+    let reader = descriptor
+        .read(http_client)
+        .await
+        .context(ChunkReadingSnafu)
+        .context(BatchReadingSnafu)?;
+    Ok(Box::new(reader))
+}
+
 async fn perform_put_get(
     command: String,
     data: &query_response::Data,
+    multipart_config: MultipartConfig,
 ) -> Result<Box<dyn RecordBatchReader + Send>, QueryResponseProcessingError> {
     match command.as_str() {
         "UPLOAD" => {
             let file_upload_data = data
-                .to_file_upload_data()
+                .to_file_upload_data(multipart_config)
                 .context(FileTransferPreparationSnafu)?;
             let upload_results = upload_files(&file_upload_data)
                 .await
@@ -63,15 +256,17 @@ async fn perform_put_get(
 async fn read_batches(
     data: &query_response::Data,
     http_client: &Client,
+    prefetch_config: ChunkPrefetchConfig,
 ) -> Result<Box<dyn RecordBatchReader + Send>, ReadBatchesError> {
     if let Some(rowset_base64) = &data.rowset_base64 {
-        let rowset_bytes = BASE64.decode(rowset_base64).context(Base64DecodingSnafu)?;
+        let rowset_bytes = Bytes::from(BASE64.decode(rowset_base64).context(Base64DecodingSnafu)?);
 
         let reader_result = if let Some(chunk_download_data) = data.to_chunk_download_data() {
             ChunkReader::multi_chunk(
                 rowset_bytes,
                 chunk_download_data.into(),
                 http_client.clone(),
+                prefetch_config,
             )
             .await
         } else {
@@ -86,25 +281,56 @@ async fn read_batches(
             .map(|rt| rt.try_into())
             .collect::<Result<Vec<_>, _>>()
             .context(RowTypeParsingSnafu)?;
-
-        // Validate column counts before converting
-        if !rowset.is_empty() {
-            let num_columns_rowset = rowset.first().unwrap().len();
-            let num_columns_rowtype = row_types.len();
-            if num_columns_rowset != num_columns_rowtype {
-                return ColumnCountMismatchSnafu {
-                    rowtype_count: num_columns_rowtype,
-                    rowset_count: num_columns_rowset,
-                }
-                .fail();
-            }
-        }
-        convert_string_rowset_to_arrow_reader(rowset, &row_types).context(RowsetConversionSnafu)
+        decode_json_rowset_to_arrow_reader(rowset.get(), &row_types).context(RowsetConversionSnafu)
     } else {
         MissingRowsetOrRowtypeSnafu.fail()
     }
 }
 
+async fn partition_batches(
+    data: &query_response::Data,
+    http_client: &Client,
+) -> Result<(SchemaRef, Vec<PartitionDescriptor>), ReadBatchesError> {
+    if let Some(rowset_base64) = &data.rowset_base64 {
+        let chunks = data.to_chunk_download_data().unwrap_or_default();
+        let mut descriptors = Vec::with_capacity(chunks.len() + 1);
+        let schema = if rowset_base64.is_empty() {
+            let first = chunks.first().context(MissingRowsetOrRowtypeSnafu)?;
+            read_chunk_schema(http_client, first)
+                .await
+                .context(ChunkReadingSnafu)?
+        } else {
+            let rowset_bytes =
+                Bytes::from(BASE64.decode(rowset_base64).context(Base64DecodingSnafu)?);
+            let schema = ChunkReader::single_chunk(rowset_bytes)
+                .context(ChunkReadingSnafu)?
+                .schema();
+            descriptors.push(PartitionDescriptor::Inline {
+                data: rowset_base64.clone(),
+            });
+            schema
+        };
+        descriptors.extend(chunks.iter().map(PartitionDescriptor::remote));
+        Ok((schema, descriptors))
+    } else {
+        let reader = read_batches(data, http_client, ChunkPrefetchConfig::default()).await?;
+        let (schema, descriptor) = inline_partition(reader).context(PartitionEncodingSnafu)?;
+        Ok((schema, vec![descriptor]))
+    }
+}
+
+/// Serializes a reader into a single inline partition.
+fn inline_partition(
+    reader: Box<dyn RecordBatchReader + Send>,
+) -> Result<(SchemaRef, PartitionDescriptor), ArrowError> {
+    let schema = reader.schema();
+    let mut writer = StreamWriter::try_new(Vec::new(), &schema)?;
+    for batch in reader {
+        writer.write(&batch?)?;
+    }
+    Ok((schema, PartitionDescriptor::inline(&writer.into_inner()?)))
+}
+
 /// Helper macro to create string arrays from field accessors
 macro_rules! string_array {
     ($data:expr, $field:ident) => {
@@ -232,19 +458,22 @@ pub enum QueryResponseProcessingError {
         #[snafu(implicit)]
         location: Location,
     },
+    #[snafu(display("Failed to encode result as an inline partition"))]
+    PartitionEncoding {
+        source: ArrowError,
+        #[snafu(implicit)]
+        location: Location,
+    },
+    #[snafu(display("Failed to export result schema"))]
+    SchemaExport {
+        source: ArrowError,
+        #[snafu(implicit)]
+        location: Location,
+    },
 }
 
 #[derive(Debug, Snafu)]
 pub enum ReadBatchesError {
-    #[snafu(display(
-        "Column count mismatch: rowtype has {rowtype_count} columns, but rowset has {rowset_count} columns"
-    ))]
-    ColumnCountMismatch {
-        rowtype_count: usize,
-        rowset_count: usize,
-        #[snafu(implicit)]
-        location: Location,
-    },
     #[snafu(display("Rowset or rowtype not found in the response"))]
     MissingRowsetOrRowtype {
         #[snafu(implicit)]
@@ -274,4 +503,52 @@ pub enum ReadBatchesError {
         #[snafu(implicit)]
         location: Location,
     },
+    #[snafu(display("Failed to encode rowset as an inline partition"))]
+    PartitionEncoding {
+        source: ArrowError,
+        #[snafu(implicit)]
+        location: Location,
+    },
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn describes_result_columns_and_binds() {
+        let data: query_response::Data = serde_json::from_str(
+            r#"{
+                "rowtype": [
+                    {"name": "C_CUSTKEY", "type": "fixed", "nullable": false,
+                     "precision": 38, "scale": 0, "length": null, "byteLength": null},
+                    {"name": "C_NAME", "type": "text", "nullable": true,
+                     "precision": null, "scale": null, "length": 25, "byteLength": 100}
+                ],
+                "numberOfBinds": 1,
+                "metaDataOfBinds": [{"type": "FIXED", "precision": 38, "scale": 0}]
+            }"#,
+        )
+        .unwrap();
+        let description = describe_query_response(&data);
+
+        let result = &description.result_schema;
+        assert_eq!(result.fields().len(), 2);
+        let key = result.field(0);
+        assert_eq!(key.name(), "C_CUSTKEY");
+        assert_eq!(key.data_type(), &DataType::Int64);
+        assert!(!key.is_nullable());
+        assert_eq!(key.metadata()["logicalType"], "FIXED");
+        assert_eq!(key.metadata()["precision"], "38");
+        assert_eq!(key.metadata()["scale"], "0");
+        let name = result.field(1);
+        assert_eq!(name.data_type(), &DataType::Utf8);
+        assert_eq!(name.metadata()["charLength"], "25");
+        assert!(!name.metadata().contains_key("precision"));
+
+        let parameters = &description.parameter_schema;
+        assert_eq!(parameters.fields().len(), 1);
+        assert_eq!(parameters.field(0).name(), "1");
+        assert_eq!(parameters.field(0).metadata()["logicalType"], "FIXED");
+    }
 }
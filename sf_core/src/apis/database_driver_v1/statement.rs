@@ -2,17 +2,27 @@ use snafu::ResultExt;
 use std::sync::{Mutex, MutexGuard};
 
 use super::Handle;
+use super::bind_stream::{ParameterGroups, bind_stream_flush_rows};
+use super::bind_upload::{should_stage, stage_binding_threshold, upload_bindings};
 use super::error::*;
 use super::global_state::{CONN_HANDLE_MANAGER, STMT_HANDLE_MANAGER};
-use crate::apis::database_driver_v1::query::process_query_response;
+use crate::apis::database_driver_v1::query::{
+    PendingReader, QueryDescription, chain_readers, describe_query_response, export_schema,
+    partition_query_response, process_query_response, read_partition,
+};
+use crate::chunks::{ChunkPrefetchConfig, PartitionDescriptor};
+use crate::file_manager::MultipartConfig;
 use crate::{
     config::{rest_parameters::QueryParameters, settings::Setting},
-    rest::snowflake::{self, QueryExecutionMode, snowflake_query_with_client},
+    rest::snowflake::{
+        self, QueryExecutionMode, snowflake_describe_with_client, snowflake_query_with_client,
+    },
 };
 
-use arrow::array::{RecordBatch, StructArray};
+use arrow::array::{RecordBatch, RecordBatchReader, StructArray};
+use arrow::error::ArrowError;
 use arrow::ffi::{FFI_ArrowArray, FFI_ArrowSchema};
-use arrow::ffi_stream::FFI_ArrowArrayStream;
+use arrow::ffi_stream::{ArrowArrayStreamReader, FFI_ArrowArrayStream};
 use arrow::{
     array::{Int32Array, StringArray},
     datatypes::DataType,
@@ -21,7 +31,7 @@ use snafu::Snafu;
 use std::{collections::HashMap, sync::Arc};
 
 use super::connection::Connection;
-use crate::rest::snowflake::query_request;
+use crate::rest::snowflake::{query_request, query_response};
 
 pub fn statement_new(conn_handle: Handle) -> Result<Handle, ApiError> {
     let handle = conn_handle;
@@ -64,6 +74,26 @@ pub fn statement_set_option(handle: Handle, key: String, value: Setting) -> Resu
     }
 }
 
+/// Sets several options at once, under one statement lock.
+pub fn statement_set_options(
+    handle: Handle,
+    options: HashMap<String, Setting>,
+) -> Result<(), ApiError> {
+    match STMT_HANDLE_MANAGER.get_obj(handle) {
+        Some(stmt_ptr) => {
+            let mut stmt = stmt_ptr
+                .lock()
+                .map_err(|_| StatementLockingSnafu {}.build())?;
+            stmt.settings.extend(options);
+            Ok(())
+        }
+        None => InvalidArgumentSnafu {
+            argument: "Statement handle not found".to_string(),
+        }
+        .fail(),
+    }
+}
+
 pub fn statement_set_sql_query(stmt_handle: Handle, query: String) -> Result<(), ApiError> {
     let handle = stmt_handle;
     match STMT_HANDLE_MANAGER.get_obj(handle) {
@@ -72,6 +102,7 @@ pub fn statement_set_sql_query(stmt_handle: Handle, query: String) -> Result<(),
                 .lock()
                 .map_err(|_| StatementLockingSnafu {}.build())?;
             stmt.query = Some(query);
+            stmt.prepared = None;
             Ok(())
         }
         None => InvalidArgumentSnafu {
@@ -81,9 +112,78 @@ pub fn statement_set_sql_query(stmt_handle: Handle, query: String) -> Result<(),
     }
 }
 
-pub fn statement_prepare(_stmt_handle: Handle) -> Result<(), ApiError> {
-    // TODO: Implement statement preparation logic if required.
-    Ok(())
+pub struct PreparedStatement {
+    pub result_schema: Box<FFI_ArrowSchema>,
+    pub parameter_schema: Box<FFI_ArrowSchema>,
+}
+
+/// Describes the query on the server once and caches its result and parameter
+/// metadata on the statement. Preparing again reuses the cache until the query
+/// text changes.
+pub fn statement_prepare(stmt_handle: Handle) -> Result<PreparedStatement, ApiError> {
+    let stmt_ptr = get_statement(stmt_handle)?;
+    let mut stmt = stmt_ptr
+        .lock()
+        .map_err(|_| StatementLockingSnafu {}.build())?;
+    let description = match &stmt.prepared {
+        Some(description) => description.clone(),
+        None => {
+            let description = describe_query(&stmt)?;
+            stmt.prepared = Some(description.clone());
+            description
+        }
+    };
+    Ok(PreparedStatement {
+        result_schema: Box::new(
+            export_schema(&description.result_schema).context(QueryResponseProcessingSnafu)?,
+        ),
+        parameter_schema: Box::new(
+            export_schema(&description.parameter_schema).context(QueryResponseProcessingSnafu)?,
+        ),
+    })
+}
+
+/// Parameter metadata of a prepared statement, answered from the cache.
+pub fn statement_get_parameter_schema(
+    stmt_handle: Handle,
+) -> Result<Box<FFI_ArrowSchema>, ApiError> {
+    with_statement(stmt_handle, |stmt| {
+        let description = stmt.prepared.as_ref().ok_or_else(|| {
+            InvalidArgumentSnafu {
+                argument: "Statement is not prepared".to_string(),
+            }
+            .build()
+        })?;
+        let schema =
+            export_schema(&description.parameter_schema).context(QueryResponseProcessingSnafu)?;
+        Ok(Box::new(schema))
+    })
+}
+
+fn describe_query(stmt: &Statement) -> Result<QueryDescription, ApiError> {
+    let query = stmt.query.clone().ok_or_else(|| {
+        InvalidArgumentSnafu {
+            argument: "Query not found".to_string(),
+        }
+        .build()
+    })?;
+    let (query_parameters, session_token, http_client) = {
+        let conn = stmt
+            .conn
+            .lock()
+            .map_err(|_| ConnectionLockingSnafu {}.build())?;
+        query_context(&conn)?
+    };
+    let rt = crate::runtime::global_runtime().context(RuntimeCreationSnafu)?;
+    let response = rt
+        .block_on(snowflake_describe_with_client(
+            &http_client,
+            query_parameters,
+            session_token,
+            query,
+        ))
+        .context(LoginSnafu)?;
+    Ok(describe_query_response(&response.data))
 }
 
 fn with_statement<T>(
@@ -137,51 +237,216 @@ pub unsafe fn statement_bind(
     })
 }
 
+/// # Safety
+///
+/// `stream` must point to a valid FFI_ArrowArrayStream. The statement takes
+/// ownership of the stream and leaves an empty one in its place; batches are
+/// read from it only when the statement is executed.
+pub unsafe fn statement_bind_stream(
+    stmt_handle: Handle,
+    stream: *mut FFI_ArrowArrayStream,
+) -> Result<(), ApiError> {
+    let reader = unsafe { ArrowArrayStreamReader::from_raw(stream) }.map_err(|_| {
+        InvalidArgumentSnafu {
+            argument: "Failed to import ArrowArrayStream".to_string(),
+        }
+        .build()
+    })?;
+    with_statement(stmt_handle, |mut stmt| {
+        stmt.bind_parameter_stream(Box::new(reader)).map_err(|_| {
+            InvalidArgumentSnafu {
+                argument: "Failed to bind parameters".to_string(),
+            }
+            .build()
+        })
+    })
+}
+
 pub struct ExecuteResult {
     pub stream: Box<FFI_ArrowArrayStream>,
     pub rows_affected: i64,
 }
 
-pub fn statement_execute_query(stmt_handle: Handle) -> Result<ExecuteResult, ApiError> {
-    let handle = stmt_handle;
-    let stmt_ptr = STMT_HANDLE_MANAGER.get_obj(handle).ok_or_else(|| {
+pub struct PartitionedResult {
+    pub schema: Box<FFI_ArrowSchema>,
+    /// Serialized partition descriptors, one per result chunk
+    pub partitions: Vec<Vec<u8>>,
+    pub rows_affected: i64,
+}
+
+struct QueryOutcome {
+    data: query_response::Data,
+    http_client: reqwest::Client,
+    prefetch_config: ChunkPrefetchConfig,
+    multipart_config: MultipartConfig,
+}
+
+fn get_statement(stmt_handle: Handle) -> Result<Arc<Mutex<Statement>>, ApiError> {
+    STMT_HANDLE_MANAGER.get_obj(stmt_handle).ok_or_else(|| {
         InvalidArgumentSnafu {
             argument: "Statement handle not found".to_string(),
         }
         .build()
-    })?;
+    })
+}
 
-    let mut stmt = stmt_ptr
-        .lock()
-        .map_err(|_| StatementLockingSnafu {}.build())?;
-    let query = stmt.query.take().ok_or_else(|| {
+fn query_context(
+    conn: &Connection,
+) -> Result<(QueryParameters, String, reqwest::Client), ApiError> {
+    Ok((
+        QueryParameters::from_settings(&conn.settings).context(ConfigurationSnafu)?,
+        conn.session_token.clone().ok_or_else(|| {
+            InvalidArgumentSnafu {
+                argument: "Session token not found".to_string(),
+            }
+            .build()
+        })?,
+        conn.http_client
+            .clone()
+            .ok_or_else(|| ConnectionNotInitializedSnafu {}.build())?,
+    ))
+}
+
+/// Runs the statement's query, once per group of streamed parameter sets when
+/// a parameter stream is bound and once otherwise.
+///
+/// A streamed bind is not atomic: every group is a separate execution that
+/// autocommits. When a group fails after others went through, the error is
+/// wrapped in `PartialBindStream` with the number of parameter sets already
+/// executed, so the caller knows where to resume.
+fn run_query(
+    stmt: &mut Statement,
+    rt: &tokio::runtime::Runtime,
+) -> Result<Vec<QueryOutcome>, ApiError> {
+    // Prepared statements keep their query so they can be executed again
+    let query = if stmt.prepared.is_some() {
+        stmt.query.clone()
+    } else {
+        stmt.query.take()
+    };
+    let query = query.ok_or_else(|| {
         InvalidArgumentSnafu {
             argument: "Query not found".to_string(),
         }
         .build()
     })?;
 
-    // Create a blocking runtime for the async operations
-    let rt = tokio::runtime::Runtime::new().context(RuntimeCreationSnafu)?;
+    let Some(parameters) = stmt.parameter_stream.take() else {
+        return Ok(vec![submit_query(stmt, rt, query)?]);
+    };
+    let flush_rows =
+        bind_stream_flush_rows(&effective_settings(stmt)?).context(ConfigurationSnafu)?;
+    let mut outcomes = Vec::new();
+    let mut executed = 0;
+    for group in ParameterGroups::new(parameters, flush_rows) {
+        let group = group.map_err(|_| {
+            InvalidArgumentSnafu {
+                argument: "Failed to read bound parameter stream".to_string(),
+            }
+            .build()
+        });
+        let outcome = group.and_then(|group| {
+            let rows = group.num_rows() as u64;
+            stmt.parameter_bindings = Some(group);
+            let outcome = submit_query(stmt, rt, query.clone());
+            stmt.parameter_bindings = None;
+            outcome.map(|outcome| (outcome, rows))
+        });
+        match outcome {
+            Ok((outcome, rows)) => {
+                outcomes.push(outcome);
+                executed += rows;
+            }
+            Err(e) if executed > 0 => {
+                return Err(e).context(PartialBindStreamSnafu { executed });
+            }
+            Err(e) => return Err(e),
+        }
+    }
+    if outcomes.is_empty() {
+        return InvalidArgumentSnafu {
+            argument: "Bound parameter stream is empty".to_string(),
+        }
+        .fail();
+    }
+    Ok(outcomes)
+}
+
+// Statement options take precedence over the connection-wide ones
+fn effective_settings(stmt: &Statement) -> Result<HashMap<String, Setting>, ApiError> {
+    let conn = stmt
+        .conn
+        .lock()
+        .map_err(|_| ConnectionLockingSnafu {}.build())?;
+    let mut settings = conn.settings.clone();
+    settings.extend(stmt.settings.clone());
+    Ok(settings)
+}
 
-    let (query_parameters, session_token, http_client, retry_policy) = {
+fn submit_query(
+    stmt: &Statement,
+    rt: &tokio::runtime::Runtime,
+    query: String,
+) -> Result<QueryOutcome, ApiError> {
+    let (
+        query_parameters,
+        session_token,
+        http_client,
+        retry_policy,
+        prefetch_config,
+        multipart_config,
+        stage_threshold,
+        bind_stage_created,
+    ) = {
+        let result_settings = effective_settings(stmt)?;
         let conn = stmt
             .conn
             .lock()
             .map_err(|_| ConnectionLockingSnafu {}.build())?;
+        let (query_parameters, session_token, http_client) = query_context(&conn)?;
         (
-            QueryParameters::from_settings(&conn.settings).context(ConfigurationSnafu)?,
-            conn.session_token.clone().ok_or_else(|| {
+            query_parameters,
+            session_token,
+            http_client,
+            conn.retry_policy.clone(),
+            ChunkPrefetchConfig::from_settings(&result_settings).context(ConfigurationSnafu)?,
+            MultipartConfig::from_settings(&result_settings).context(ConfigurationSnafu)?,
+            stage_binding_threshold(&result_settings).context(ConfigurationSnafu)?,
+            conn.bind_stage_created,
+        )
+    };
+
+    // Large parameter set arrays go through a stage instead of the request body
+    let bindings = match stmt.parameter_bindings.as_ref() {
+        Some(parameters) if should_stage(parameters, stage_threshold) => {
+            let location = rt
+                .block_on(upload_bindings(
+                    &http_client,
+                    &query_parameters,
+                    &session_token,
+                    &retry_policy,
+                    parameters,
+                    bind_stage_created,
+                    multipart_config.clone(),
+                ))
+                .context(BindUploadSnafu)?;
+            if !bind_stage_created {
+                stmt.conn
+                    .lock()
+                    .map_err(|_| ConnectionLockingSnafu {}.build())?
+                    .bind_stage_created = true;
+            }
+            Some(query_request::Bindings::Stage(location))
+        }
+        _ => stmt
+            .get_query_parameter_bindings()
+            .map_err(|_| {
                 InvalidArgumentSnafu {
-                    argument: "Session token not found".to_string(),
+                    argument: "Failed to get query parameter bindings".to_string(),
                 }
                 .build()
-            })?,
-            conn.http_client
-                .clone()
-                .ok_or_else(|| ConnectionNotInitializedSnafu {}.build())?,
-            conn.retry_policy.clone(),
-        )
+            })?
+            .map(query_request::Bindings::Inline),
     };
 
     let response = rt
@@ -190,20 +455,55 @@ pub fn statement_execute_query(stmt_handle: Handle) -> Result<ExecuteResult, Api
             query_parameters,
             session_token,
             query,
-            stmt.get_query_parameter_bindings().map_err(|_| {
-                InvalidArgumentSnafu {
-                    argument: "Failed to get query parameter bindings".to_string(),
-                }
-                .build()
-            })?,
+            bindings,
             &retry_policy,
             stmt.execution_mode(),
         ))
         .context(LoginSnafu)?;
 
-    let response_reader = rt
-        .block_on(process_query_response(&response.data, &http_client))
+    Ok(QueryOutcome {
+        data: response.data,
+        http_client,
+        prefetch_config,
+        multipart_config,
+    })
+}
+
+async fn outcome_reader(
+    outcome: QueryOutcome,
+) -> Result<Box<dyn RecordBatchReader + Send>, QueryResponseProcessingError> {
+    process_query_response(
+        &outcome.data,
+        &outcome.http_client,
+        outcome.prefetch_config,
+        outcome.multipart_config,
+    )
+    .await
+}
+
+pub fn statement_execute_query(stmt_handle: Handle) -> Result<ExecuteResult, ApiError> {
+    let stmt_ptr = get_statement(stmt_handle)?;
+    let mut stmt = stmt_ptr
+        .lock()
+        .map_err(|_| StatementLockingSnafu {}.build())?;
+    let rt = crate::runtime::global_runtime().context(RuntimeCreationSnafu)?;
+    let mut outcomes = run_query(&mut stmt, rt)?.into_iter();
+
+    // Later executions of a parameter stream are read only once the earlier
+    // ones are, so their chunks are not all prefetched at the same time
+    let first = outcomes.next().ok_or_else(|| GenericSnafu {}.build())?;
+    let first = rt
+        .block_on(outcome_reader(first))
         .context(QueryResponseProcessingSnafu)?;
+    let pending = outcomes
+        .map(|outcome| -> PendingReader {
+            Box::new(move || {
+                rt.block_on(outcome_reader(outcome))
+                    .map_err(|e| ArrowError::ExternalError(Box::new(e)))
+            })
+        })
+        .collect();
+    let response_reader = chain_readers(first, pending);
 
     let rowset_stream = Box::new(FFI_ArrowArrayStream::new(response_reader));
 
@@ -215,54 +515,122 @@ pub fn statement_execute_query(stmt_handle: Handle) -> Result<ExecuteResult, Api
     })
 }
 
+/// Executes the query and describes each chunk of the result as a partition
+/// that `statement_read_partition` can read independently.
+pub fn statement_execute_partitions(stmt_handle: Handle) -> Result<PartitionedResult, ApiError> {
+    let stmt_ptr = get_statement(stmt_handle)?;
+    let mut stmt = stmt_ptr
+        .lock()
+        .map_err(|_| StatementLockingSnafu {}.build())?;
+    let rt = crate::runtime::global_runtime().context(RuntimeCreationSnafu)?;
+    let outcomes = run_query(&mut stmt, rt)?;
+
+    // Executions of a parameter stream share the schema of the first one
+    let mut result: Option<PartitionedResult> = None;
+    for outcome in outcomes {
+        let partitions = rt
+            .block_on(partition_query_response(
+                &outcome.data,
+                &outcome.http_client,
+                outcome.multipart_config,
+            ))
+            .context(QueryResponseProcessingSnafu)?;
+        match result.as_mut() {
+            Some(result) => result.partitions.extend(partitions.partitions),
+            None => {
+                result = Some(PartitionedResult {
+                    schema: Box::new(partitions.schema),
+                    partitions: partitions.partitions,
+                    rows_affected: 0,
+                })
+            }
+        }
+    }
+
+    stmt.state = StatementState::Executed;
+    result.ok_or_else(|| GenericSnafu {}.build())
+}
+
+/// Reads one partition returned by `statement_execute_partitions`. The
+/// statement only provides the HTTP client, so partitions of a result can be
+/// read through any statement, concurrently.
+pub fn statement_read_partition(
+    stmt_handle: Handle,
+    descriptor: &[u8],
+) -> Result<Box<FFI_ArrowArrayStream>, ApiError> {
+    let descriptor = PartitionDescriptor::from_bytes(descriptor).map_err(|_| {
+        InvalidArgumentSnafu {
+            argument: "Invalid partition descriptor".to_string(),
+        }
+        .build()
+    })?;
+    let http_client = {
+        let stmt_ptr = get_statement(stmt_handle)?;
+        let stmt = stmt_ptr
+            .lock()
+            .map_err(|_| StatementLockingSnafu {}.build())?;
+        let conn = stmt
+            .conn
+            .lock()
+            .map_err(|_| ConnectionLockingSnafu {}.build())?;
+        conn.http_client
+            .clone()
+            .ok_or_else(|| ConnectionNotInitializedSnafu {}.build())?
+    };
+
+    let rt = crate::runtime::global_runtime().context(RuntimeCreationSnafu)?;
+    let reader = rt
+        .block_on(read_partition(&descriptor, &http_client))
+        .context(QueryResponseProcessingSnafu)?;
+    Ok(Box::new(FFI_ArrowArrayStream::new(reader)))
+}
+
+/// Converts bound parameters into query bindings. A single row binds plain
+/// values; more rows are sent as array bindings, so the whole parameter set
+/// array runs in one request.
 fn parameters_from_record_batch(
     record_batch: &RecordBatch,
 ) -> Result<HashMap<String, query_request::BindParameter>, StatementError> {
     let mut parameters = HashMap::new();
     for i in 0..record_batch.num_columns() {
         let column = record_batch.column(i);
-        match column.data_type() {
+        let (type_, values) = match column.data_type() {
             DataType::Int32 => {
-                let value = column
-                    .as_any()
-                    .downcast_ref::<Int32Array>()
-                    .unwrap()
-                    .value(0);
-                let json_value = serde_json::Value::String(value.to_string());
-                parameters.insert(
-                    format!("{}", i + 1),
-                    query_request::BindParameter {
-                        type_: "FIXED".to_string(),
-                        value: json_value,
-                        format: None,
-                        schema: None,
-                    },
-                );
+                let array = column.as_any().downcast_ref::<Int32Array>().unwrap();
+                let values = array
+                    .iter()
+                    .map(|value| value.map(|value| value.to_string()))
+                    .collect::<Vec<_>>();
+                ("FIXED", values)
             }
             DataType::Utf8 => {
-                let value = column
-                    .as_any()
-                    .downcast_ref::<StringArray>()
-                    .unwrap()
-                    .value(0);
-                let json_value = serde_json::Value::String(value.to_string());
-                parameters.insert(
-                    format!("{}", i + 1),
-                    query_request::BindParameter {
-                        type_: "TEXT".to_string(),
-                        value: json_value,
-                        format: None,
-                        schema: None,
-                    },
-                );
+                let array = column.as_any().downcast_ref::<StringArray>().unwrap();
+                let values = array
+                    .iter()
+                    .map(|value| value.map(str::to_string))
+                    .collect::<Vec<_>>();
+                ("TEXT", values)
             }
             _ => {
-                UnsupportedBindParameterTypeSnafu {
+                return UnsupportedBindParameterTypeSnafu {
                     type_: column.data_type().to_string(),
                 }
-                .fail()?;
+                .fail();
             }
-        }
+        };
+        let json_value = match values.as_slice() {
+            [value] => serde_json::json!(value),
+            values => serde_json::json!(values),
+        };
+        parameters.insert(
+            format!("{}", i + 1),
+            query_request::BindParameter {
+                type_: type_.to_string(),
+                value: json_value,
+                format: None,
+                schema: None,
+            },
+        );
     }
     Ok(parameters)
 }
@@ -272,6 +640,10 @@ pub struct Statement {
     pub settings: HashMap<String, Setting>,
     pub query: Option<String>,
     pub parameter_bindings: Option<RecordBatch>,
+    /// Parameter sets read group by group when the statement is executed
+    pub parameter_stream: Option<Box<dyn RecordBatchReader + Send>>,
+    /// Server description of `query`, cleared when the query changes
+    pub prepared: Option<QueryDescription>,
     pub conn: Arc<Mutex<Connection>>,
 }
 
@@ -288,23 +660,39 @@ impl Statement {
             state: StatementState::Initialized,
             query: None,
             parameter_bindings: None,
+            parameter_stream: None,
+            prepared: None,
             conn,
         }
     }
 
     pub fn bind_parameters(&mut self, record_batch: RecordBatch) -> Result<(), StatementError> {
+        self.ensure_bindable()?;
+        self.parameter_bindings = Some(record_batch);
+        self.parameter_stream = None;
+        Ok(())
+    }
+
+    pub fn bind_parameter_stream(
+        &mut self,
+        parameters: Box<dyn RecordBatchReader + Send>,
+    ) -> Result<(), StatementError> {
+        self.ensure_bindable()?;
+        self.parameter_bindings = None;
+        self.parameter_stream = Some(parameters);
+        Ok(())
+    }
+
+    fn ensure_bindable(&self) -> Result<(), StatementError> {
         match self.state {
-            StatementState::Initialized => {
-                self.parameter_bindings = Some(record_batch);
-            }
-            _ => {
-                InvalidStateTransitionSnafu {
-                    msg: format!("Cannot bind parameters in state={:?}", self.state),
-                }
-                .fail()?;
+            StatementState::Initialized => Ok(()),
+            // Prepared statements are bound again before every execution
+            StatementState::Executed if self.prepared.is_some() => Ok(()),
+            _ => InvalidStateTransitionSnafu {
+                msg: format!("Cannot bind parameters in state={:?}", self.state),
             }
+            .fail(),
         }
-        Ok(())
     }
 
     pub fn get_query_parameter_bindings(
@@ -365,3 +753,45 @@ pub enum StatementError {
         location: snafu::Location,
     },
 }
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use arrow::datatypes::{Field, Schema};
+
+    fn bindings(ids: Vec<Option<i32>>, names: Vec<Option<&str>>) -> RecordBatch {
+        let schema = Arc::new(Schema::new(vec![
+            Field::new("param_1", DataType::Int32, true),
+            Field::new("param_2", DataType::Utf8, true),
+        ]));
+        RecordBatch::try_new(
+            schema,
+            vec![
+                Arc::new(Int32Array::from(ids)),
+                Arc::new(StringArray::from(names)),
+            ],
+        )
+        .unwrap()
+    }
+
+    #[test]
+    fn single_row_binds_plain_values() {
+        let parameters =
+            parameters_from_record_batch(&bindings(vec![Some(7)], vec![None])).unwrap();
+        assert_eq!(parameters["1"].type_, "FIXED");
+        assert_eq!(parameters["1"].value, serde_json::json!("7"));
+        assert_eq!(parameters["2"].type_, "TEXT");
+        assert_eq!(parameters["2"].value, serde_json::Value::Null);
+    }
+
+    #[test]
+    fn parameter_set_array_binds_arrays() {
+        let parameters = parameters_from_record_batch(&bindings(
+            vec![Some(1), None, Some(3)],
+            vec![Some("a"), Some("b"), None],
+        ))
+        .unwrap();
+        assert_eq!(parameters["1"].value, serde_json::json!(["1", null, "3"]));
+        assert_eq!(parameters["2"].value, serde_json::json!(["a", "b", null]));
+    }
+}
@@ -1,8 +1,9 @@
-use arrow::array::{Array, Int64Array, StringArray};
+use arrow::array::{Array, Int64Builder, StringBuilder};
 use arrow::datatypes::{DataType, Field, Schema};
 use arrow::error::ArrowError;
-use arrow::record_batch::RecordBatch;
-use snafu::{Location, ResultExt, Snafu};
+use arrow::record_batch::{RecordBatch, RecordBatchIterator, RecordBatchReader};
+use serde::de::{self, DeserializeSeed, Deserializer, IgnoredAny, SeqAccess, Visitor};
+use snafu::{IntoError, Location, ResultExt, Snafu};
 use std::collections::HashMap;
 use std::sync::Arc;
 
@@ -45,51 +46,257 @@ pub fn create_field(row_type: &RowType) -> Field {
     }
 }
 
-/// Creates an Arrow array from column values and data type
-fn create_column_array(
-    values: Vec<&str>,
-    row_type: &RowType,
-) -> Result<Arc<dyn Array>, ArrowUtilsError> {
-    match row_type {
-        RowType::Text { .. } => Ok(Arc::new(StringArray::from(values))),
-        RowType::Fixed { .. } => {
-            // Convert string values to i64 and return parsing error if any value is invalid
-            let int_values: Result<Vec<i64>, ArrowUtilsError> = values
-                .into_iter()
-                .map(|v| {
-                    v.parse::<i64>().context(IntegerParsingSnafu {
-                        value: v.to_string(),
-                    })
-                })
-                .collect();
-            Ok(Arc::new(Int64Array::from(int_values?)))
+/// Upper bounds for the record batches a JSON rowset is split into.
+const JSON_ROWSET_BATCH_ROWS: usize = 8192;
+const JSON_ROWSET_BATCH_BYTES: usize = 16 * 1024 * 1024;
+
+enum ColumnBuilder {
+    Text(StringBuilder),
+    Fixed(Int64Builder),
+}
+
+impl ColumnBuilder {
+    fn new(row_type: &RowType) -> Self {
+        match row_type {
+            RowType::Text { .. } => ColumnBuilder::Text(StringBuilder::new()),
+            RowType::Fixed { .. } => ColumnBuilder::Fixed(Int64Builder::new()),
+        }
+    }
+
+    fn finish(&mut self) -> Arc<dyn Array> {
+        match self {
+            ColumnBuilder::Text(builder) => Arc::new(builder.finish()),
+            ColumnBuilder::Fixed(builder) => Arc::new(builder.finish()),
+        }
+    }
+}
+
+/// Decoding state shared by the nested serde visitors.
+struct RowsetDecoder {
+    schema: Arc<Schema>,
+    builders: Vec<ColumnBuilder>,
+    batch_rows: usize,
+    batch_bytes: usize,
+    batches: Vec<RecordBatch>,
+    // Typed cause of the last failure, serde errors can only carry a message
+    error: Option<ArrowUtilsError>,
+}
+
+impl RowsetDecoder {
+    fn flush(&mut self) -> Result<(), ArrowError> {
+        // An empty rowset still yields one empty batch
+        if self.batch_rows == 0 && !self.batches.is_empty() {
+            return Ok(());
         }
+        let columns = self
+            .builders
+            .iter_mut()
+            .map(ColumnBuilder::finish)
+            .collect();
+        self.batches
+            .push(RecordBatch::try_new(self.schema.clone(), columns)?);
+        self.batch_rows = 0;
+        self.batch_bytes = 0;
+        Ok(())
+    }
+
+    fn fail<E: de::Error>(&mut self, error: ArrowUtilsError) -> E {
+        let message = error.to_string();
+        self.error = Some(error);
+        E::custom(message)
+    }
+}
+
+struct RowsetSeed<'a>(&'a mut RowsetDecoder);
+
+impl<'de> DeserializeSeed<'de> for RowsetSeed<'_> {
+    type Value = ();
+
+    fn deserialize<D: Deserializer<'de>>(self, deserializer: D) -> Result<(), D::Error> {
+        deserializer.deserialize_seq(self)
+    }
+}
+
+impl<'de> Visitor<'de> for RowsetSeed<'_> {
+    type Value = ();
+
+    fn expecting(&self, f: &mut std::fmt::Formatter) -> std::fmt::Result {
+        f.write_str("an array of rows")
+    }
+
+    fn visit_seq<A: SeqAccess<'de>>(self, mut rows: A) -> Result<(), A::Error> {
+        let decoder = self.0;
+        while rows.next_element_seed(RowSeed(&mut *decoder))?.is_some() {
+            decoder.batch_rows += 1;
+            if decoder.batch_rows >= JSON_ROWSET_BATCH_ROWS
+                || decoder.batch_bytes >= JSON_ROWSET_BATCH_BYTES
+            {
+                let result = decoder.flush();
+                result.map_err(|source| decoder.fail::<A::Error>(ArrowSnafu.into_error(source)))?;
+            }
+        }
+        Ok(())
+    }
+}
+
+struct RowSeed<'a>(&'a mut RowsetDecoder);
+
+impl<'de> DeserializeSeed<'de> for RowSeed<'_> {
+    type Value = ();
+
+    fn deserialize<D: Deserializer<'de>>(self, deserializer: D) -> Result<(), D::Error> {
+        deserializer.deserialize_seq(self)
+    }
+}
+
+impl<'de> Visitor<'de> for RowSeed<'_> {
+    type Value = ();
+
+    fn expecting(&self, f: &mut std::fmt::Formatter) -> std::fmt::Result {
+        f.write_str("an array of cells")
+    }
+
+    fn visit_seq<A: SeqAccess<'de>>(self, mut cells: A) -> Result<(), A::Error> {
+        let decoder = self.0;
+        let expected = decoder.builders.len();
+        let mut actual = 0;
+        while actual < expected {
+            if cells
+                .next_element_seed(CellSeed(&mut *decoder, actual))?
+                .is_none()
+            {
+                break;
+            }
+            actual += 1;
+        }
+        while cells.next_element::<IgnoredAny>()?.is_some() {
+            actual += 1;
+        }
+        if actual != expected {
+            return Err(decoder.fail(
+                ColumnCountMismatchSnafu {
+                    rowtype_count: expected,
+                    rowset_count: actual,
+                }
+                .build(),
+            ));
+        }
+        Ok(())
+    }
+}
+
+/// Appends one cell to the builder of the column at the given index.
+struct CellSeed<'a>(&'a mut RowsetDecoder, usize);
+
+impl<'de> DeserializeSeed<'de> for CellSeed<'_> {
+    type Value = ();
+
+    fn deserialize<D: Deserializer<'de>>(self, deserializer: D) -> Result<(), D::Error> {
+        deserializer.deserialize_any(self)
     }
 }
 
-/// Converts a string rowset with RowType metadata to Arrow format
-/// Supports TEXT and FIXED (with scale 0) types, converting strings to appropriate Arrow types
-/// Assumes rowset and row_types have been validated to have matching column counts
-pub fn convert_string_rowset_to_arrow_reader(
-    rowset: &[Vec<String>],
+impl<'de> Visitor<'de> for CellSeed<'_> {
+    type Value = ();
+
+    fn expecting(&self, f: &mut std::fmt::Formatter) -> std::fmt::Result {
+        f.write_str("a string, number or null cell")
+    }
+
+    fn visit_str<E: de::Error>(self, value: &str) -> Result<(), E> {
+        let CellSeed(decoder, column) = self;
+        match &mut decoder.builders[column] {
+            ColumnBuilder::Text(builder) => {
+                builder.append_value(value);
+                decoder.batch_bytes += value.len();
+            }
+            ColumnBuilder::Fixed(builder) => match value.parse::<i64>() {
+                Ok(value) => {
+                    builder.append_value(value);
+                    decoder.batch_bytes += std::mem::size_of::<i64>();
+                }
+                Err(source) => {
+                    return Err(decoder.fail(
+                        IntegerParsingSnafu {
+                            value: value.to_string(),
+                        }
+                        .into_error(source),
+                    ));
+                }
+            },
+        }
+        Ok(())
+    }
+
+    fn visit_i64<E: de::Error>(self, value: i64) -> Result<(), E> {
+        let CellSeed(decoder, column) = self;
+        match &mut decoder.builders[column] {
+            ColumnBuilder::Fixed(builder) => {
+                builder.append_value(value);
+                decoder.batch_bytes += std::mem::size_of::<i64>();
+                Ok(())
+            }
+            ColumnBuilder::Text(_) => {
+                Err(E::invalid_type(de::Unexpected::Signed(value), &"a string"))
+            }
+        }
+    }
+
+    fn visit_u64<E: de::Error>(self, value: u64) -> Result<(), E> {
+        match i64::try_from(value) {
+            Ok(value) => self.visit_i64(value),
+            Err(_) => Err(E::invalid_value(
+                de::Unexpected::Unsigned(value),
+                &"a 64-bit integer",
+            )),
+        }
+    }
+
+    fn visit_unit<E: de::Error>(self) -> Result<(), E> {
+        let CellSeed(decoder, column) = self;
+        match &mut decoder.builders[column] {
+            ColumnBuilder::Text(builder) => builder.append_null(),
+            ColumnBuilder::Fixed(builder) => builder.append_null(),
+        }
+        Ok(())
+    }
+}
+
+/// Decodes a JSON rowset with RowType metadata into Arrow record batches.
+///
+/// Cells are appended straight into typed builders while the JSON is parsed,
+/// so no intermediate `String` is created per cell. The rows are split into
+/// batches of bounded row count and approximate byte size.
+pub fn decode_json_rowset_to_arrow_reader(
+    rowset: &str,
     row_types: &[RowType],
-) -> Result<Box<dyn arrow::record_batch::RecordBatchReader + Send>, ArrowUtilsError> {
-    // Create Arrow schema from RowType metadata
+) -> Result<Box<dyn RecordBatchReader + Send>, ArrowUtilsError> {
     let schema = create_schema(row_types)?;
+    let mut decoder = RowsetDecoder {
+        schema: schema.clone(),
+        builders: row_types.iter().map(ColumnBuilder::new).collect(),
+        batch_rows: 0,
+        batch_bytes: 0,
+        batches: Vec::new(),
+        error: None,
+    };
 
-    // Create Arrow arrays for each column
-    let columns: Result<Vec<Arc<dyn Array>>, ArrowUtilsError> = row_types
-        .iter()
-        .enumerate()
-        .map(|(col_idx, row_type)| {
-            let values: Vec<&str> = rowset.iter().map(|row| row[col_idx].as_str()).collect();
-            create_column_array(values, row_type)
-        })
-        .collect();
-
-    let columns = columns?;
+    let mut deserializer = serde_json::Deserializer::from_str(rowset);
+    let parsed = RowsetSeed(&mut decoder)
+        .deserialize(&mut deserializer)
+        .and_then(|()| deserializer.end());
+    if let Err(source) = parsed {
+        return Err(match decoder.error.take() {
+            Some(error) => error,
+            None => JsonRowsetSnafu.into_error(source),
+        });
+    }
+    decoder.flush().context(ArrowSnafu)?;
 
-    boxed_arrow_reader(schema, columns).context(ArrowSnafu)
+    Ok(Box::new(RecordBatchIterator::new(
+        decoder.batches.into_iter().map(Ok),
+        schema,
+    )))
 }
 
 /// Creates an Arrow Schema from a list of RowType definitions
@@ -130,6 +337,21 @@ pub enum ArrowUtilsError {
         #[snafu(implicit)]
         location: Location,
     },
+    #[snafu(display("Failed to parse JSON rowset"))]
+    JsonRowset {
+        source: serde_json::Error,
+        #[snafu(implicit)]
+        location: Location,
+    },
+    #[snafu(display(
+        "Column count mismatch: rowtype has {rowtype_count} columns, but rowset has {rowset_count} columns"
+    ))]
+    ColumnCountMismatch {
+        rowtype_count: usize,
+        rowset_count: usize,
+        #[snafu(implicit)]
+        location: Location,
+    },
     #[snafu(display("Failed to parse integer value: {value}"))]
     IntegerParsing {
         value: String,
@@ -143,7 +365,6 @@ pub enum ArrowUtilsError {
 mod tests {
     use super::*;
     use arrow::array::{Int64Array, StringArray};
-    use arrow::record_batch::RecordBatchReader;
 
     #[test]
     fn test_string_rowset_translation_with_metadata_small() {
@@ -162,7 +383,8 @@ mod tests {
         ];
 
         // Convert to Arrow reader
-        let mut reader = convert_string_rowset_to_arrow_reader(&rowset, &row_types).unwrap();
+        let rowset = serde_json::to_string(&rowset).unwrap();
+        let mut reader = decode_json_rowset_to_arrow_reader(&rowset, &row_types).unwrap();
 
         // Validate schema and metadata
         let schema = reader.schema();
@@ -237,7 +459,8 @@ mod tests {
         ];
 
         // Convert to Arrow reader
-        let mut reader = convert_string_rowset_to_arrow_reader(&rowset, &row_types).unwrap();
+        let rowset = serde_json::to_string(&rowset).unwrap();
+        let mut reader = decode_json_rowset_to_arrow_reader(&rowset, &row_types).unwrap();
 
         // Validate schema and metadata
         let schema = reader.schema();
@@ -292,4 +515,101 @@ mod tests {
             panic!("Expected one record batch");
         }
     }
+
+    #[test]
+    fn test_json_rowset_split_into_bounded_batches_with_nulls() {
+        let rows = JSON_ROWSET_BATCH_ROWS + 10;
+        let rowset = (0..rows)
+            .map(|i| match i % 3 {
+                0 => format!(r#"[null, "{i}"]"#),
+                1 => format!(r#"["row \"{i}\"", null]"#),
+                _ => format!(r#"["row {i}", {i}]"#),
+            })
+            .collect::<Vec<_>>()
+            .join(",");
+        let rowset = format!("[{rowset}]");
+        let row_types = vec![
+            RowType::text("col_text", true, 16, 64),
+            RowType::fixed("col_fixed", true, 10, 0).unwrap(),
+        ];
+
+        let batches = decode_json_rowset_to_arrow_reader(&rowset, &row_types)
+            .unwrap()
+            .collect::<Result<Vec<_>, _>>()
+            .unwrap();
+
+        assert_eq!(
+            batches.iter().map(|b| b.num_rows()).collect::<Vec<_>>(),
+            vec![JSON_ROWSET_BATCH_ROWS, 10]
+        );
+        let last = &batches[1];
+        let text = last
+            .column(0)
+            .as_any()
+            .downcast_ref::<StringArray>()
+            .unwrap();
+        let fixed = last
+            .column(1)
+            .as_any()
+            .downcast_ref::<Int64Array>()
+            .unwrap();
+        let first_row = JSON_ROWSET_BATCH_ROWS;
+        for (idx, row) in (first_row..rows).enumerate() {
+            match row % 3 {
+                0 => {
+                    assert!(text.is_null(idx));
+                    assert_eq!(fixed.value(idx), row as i64);
+                }
+                1 => {
+                    assert_eq!(text.value(idx), format!("row \"{row}\""));
+                    assert!(fixed.is_null(idx));
+                }
+                _ => {
+                    assert_eq!(text.value(idx), format!("row {row}"));
+                    assert_eq!(fixed.value(idx), row as i64);
+                }
+            }
+        }
+    }
+
+    #[test]
+    fn test_json_rowset_empty() {
+        let row_types = vec![RowType::text("col_text", false, 16, 64)];
+        let batches = decode_json_rowset_to_arrow_reader("[]", &row_types)
+            .unwrap()
+            .collect::<Result<Vec<_>, _>>()
+            .unwrap();
+        assert_eq!(batches.len(), 1);
+        assert_eq!(batches[0].num_rows(), 0);
+    }
+
+    #[test]
+    fn test_json_rowset_errors() {
+        let row_types = vec![
+            RowType::text("col_text", false, 16, 64),
+            RowType::fixed("col_fixed", false, 10, 0).unwrap(),
+        ];
+
+        let err = decode_json_rowset_to_arrow_reader(r#"[["a", "1", "x"]]"#, &row_types)
+            .err()
+            .unwrap();
+        assert!(matches!(
+            err,
+            ArrowUtilsError::ColumnCountMismatch {
+                rowtype_count: 2,
+                rowset_count: 3,
+                ..
+            }
+        ));
+
+        let err = decode_json_rowset_to_arrow_reader(r#"[["a", "1.5"]]"#, &row_types)
+            .err()
+            .unwrap();
+        assert!(matches!(err, ArrowUtilsError::IntegerParsing { ref value, .. } if value == "1.5"));
+
+        let err = decode_json_rowset_to_arrow_reader(r#"[["a", "1"]"#, &row_types)
+            .err()
+            .unwrap();
+        assert!(matches!(err, ArrowUtilsError::JsonRowset { .. }));
+    }
 }
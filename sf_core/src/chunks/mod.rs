@@ -0,0 +1,556 @@
+mod partition;
+mod prefetch;
+mod result_buffer;
+mod streaming;
+
+use std::collections::{HashMap, VecDeque};
+use std::io;
+use std::str::FromStr;
+
+use crate::compression::{CompressionError, decompress_into, gzip_uncompressed_size_hint};
+use arrow::array::{RecordBatch, RecordBatchReader};
+use arrow::buffer::Buffer;
+use arrow::datatypes::SchemaRef;
+use arrow::error::ArrowError;
+use arrow_ipc::reader::StreamDecoder;
+use bytes::Bytes;
+use prefetch::ChunkPrefetcher;
+use reqwest::Client;
+use reqwest::header::{self, HeaderMap, HeaderName, HeaderValue};
+use snafu::{Location, ResultExt, Snafu};
+use streaming::ChunkStreamer;
+
+pub use partition::{PartitionDescriptor, read_chunk_schema};
+pub use prefetch::{
+    CHUNK_PREFETCH_DEPTH_OPTION, CHUNK_PREFETCH_MEMORY_BUDGET_OPTION, CHUNK_SPILL_DIRECTORY_OPTION,
+    CHUNK_STREAMING_OPTION, ChunkPrefetchConfig,
+};
+pub use result_buffer::SpillStats;
+pub use streaming::StreamingChunkDecoder;
+
+const MAX_CHUNK_DECOMPRESSION_RETRIES: u32 = 2;
+
+pub struct ChunkDownloadData {
+    url: String,
+    headers: HashMap<String, String>,
+    uncompressed_size: Option<usize>,
+}
+
+impl ChunkDownloadData {
+    pub fn new(chunk_url: &str, chunk_headers: &HashMap<String, String>) -> Self {
+        Self {
+            url: chunk_url.to_string(),
+            headers: chunk_headers.clone(),
+            uncompressed_size: None,
+        }
+    }
+
+    /// Attaches the uncompressed size reported by the server, used to reserve
+    /// prefetch memory before the chunk is downloaded.
+    pub fn with_uncompressed_size(mut self, uncompressed_size: i64) -> Self {
+        self.uncompressed_size = usize::try_from(uncompressed_size).ok();
+        self
+    }
+}
+/// Record batches of one Arrow IPC stream chunk.
+///
+/// Batches are decoded in place: their arrays are slices of the chunk body,
+/// which stays alive for as long as any of them is referenced.
+pub struct ChunkBatches {
+    decoder: StreamDecoder,
+    // Undecoded remainder of the chunk, `None` once the stream ended or failed
+    buffer: Option<Buffer>,
+}
+
+impl ChunkBatches {
+    pub fn new(data: Bytes) -> Self {
+        Self {
+            decoder: StreamDecoder::new(),
+            buffer: Some(Buffer::from(data)),
+        }
+    }
+
+    /// Decodes messages up to and including the stream's schema.
+    pub fn schema(&mut self) -> Result<SchemaRef, ArrowError> {
+        loop {
+            if let Some(schema) = self.decoder.schema() {
+                return Ok(schema);
+            }
+            match self.buffer.as_mut() {
+                Some(buffer) if !buffer.is_empty() => {
+                    // A stream starts with its schema, so no batch can be returned here
+                    self.decoder.decode(buffer)?;
+                }
+                _ => {
+                    return Err(ArrowError::IpcError(
+                        "Chunk ended before its schema".to_string(),
+                    ));
+                }
+            }
+        }
+    }
+}
+
+impl Iterator for ChunkBatches {
+    type Item = Result<RecordBatch, ArrowError>;
+
+    fn next(&mut self) -> Option<Self::Item> {
+        let buffer = self.buffer.as_mut()?;
+        while !buffer.is_empty() {
+            match self.decoder.decode(buffer) {
+                Ok(Some(batch)) => return Some(Ok(batch)),
+                Ok(None) => {}
+                Err(e) => {
+                    self.buffer = None;
+                    return Some(Err(e));
+                }
+            }
+        }
+        self.buffer = None;
+        self.decoder.finish().err().map(Err)
+    }
+}
+
+pub struct ChunkReader {
+    schema: SchemaRef,
+    current_stream: Option<ChunkBatches>,
+    current_batches: std::vec::IntoIter<RecordBatch>,
+    remaining: Option<RemainingChunks>,
+    // Counters of the remaining chunks, kept after they are dropped
+    final_spill_stats: Option<SpillStats>,
+}
+
+// Where the chunks after the first one come from
+enum RemainingChunks {
+    Prefetched(ChunkPrefetcher),
+    Streamed(ChunkStreamer),
+}
+
+impl ChunkReader {
+    pub async fn multi_chunk(
+        initial: Bytes,
+        mut rest: VecDeque<ChunkDownloadData>,
+        client: Client,
+        prefetch_config: ChunkPrefetchConfig,
+    ) -> Result<Self, ChunkError> {
+        let initial = if initial.is_empty() {
+            get_chunk_data(&client, &rest.pop_front().unwrap()).await?
+        } else {
+            initial
+        };
+        let mut reader = ChunkBatches::new(initial);
+        let schema = reader.schema().context(ChunkReadingSnafu)?;
+        let remaining = if prefetch_config.streaming {
+            RemainingChunks::Streamed(ChunkStreamer::new(rest, client, prefetch_config)?)
+        } else {
+            RemainingChunks::Prefetched(ChunkPrefetcher::new(rest, client, prefetch_config)?)
+        };
+        Ok(Self {
+            schema,
+            current_stream: Some(reader),
+            current_batches: Vec::new().into_iter(),
+            remaining: Some(remaining),
+            final_spill_stats: None,
+        })
+    }
+
+    /// Bytes of this result spilled to disk and read back so far.
+    pub fn spill_stats(&self) -> Option<SpillStats> {
+        match &self.remaining {
+            Some(RemainingChunks::Prefetched(prefetcher)) => prefetcher.spill_stats(),
+            Some(RemainingChunks::Streamed(_)) => None,
+            None => self.final_spill_stats,
+        }
+    }
+
+    // Drops the remaining chunks, which removes any spill files still on disk
+    fn close_remaining(&mut self) {
+        self.final_spill_stats = self.spill_stats();
+        self.remaining = None;
+    }
+
+    pub fn single_chunk(initial: Bytes) -> Result<Self, ChunkError> {
+        let mut reader = ChunkBatches::new(initial);
+        Ok(Self {
+            schema: reader.schema().context(ChunkReadingSnafu)?,
+            current_stream: Some(reader),
+            current_batches: Vec::new().into_iter(),
+            remaining: None,
+            final_spill_stats: None,
+        })
+    }
+}
+
+impl Iterator for ChunkReader {
+    type Item = Result<RecordBatch, ArrowError>;
+
+    fn next(&mut self) -> Option<Self::Item> {
+        loop {
+            if let Some(mut current_stream) = self.current_stream.take() {
+                let next_batch = current_stream.next();
+                if next_batch.is_some() {
+                    self.current_stream = Some(current_stream);
+                    return next_batch;
+                }
+            }
+            if let Some(batch) = self.current_batches.next() {
+                return Some(Ok(batch));
+            }
+            let next = match self.remaining.as_mut()? {
+                RemainingChunks::Prefetched(prefetcher) => prefetcher.next_chunk(),
+                RemainingChunks::Streamed(streamer) => streamer
+                    .next_batch()
+                    .map(|batch| batch.map(|batch| vec![batch])),
+            };
+            match next {
+                Some(Ok(batches)) => self.current_batches = batches.into_iter(),
+                Some(Err(e)) => {
+                    self.close_remaining();
+                    return Some(Err(ArrowError::IpcError(e.to_string())));
+                }
+                None => {
+                    self.close_remaining();
+                    return None;
+                }
+            }
+        }
+    }
+}
+
+impl RecordBatchReader for ChunkReader {
+    fn schema(&self) -> SchemaRef {
+        self.schema.clone()
+    }
+}
+
+/// Downloads a chunk and returns its decoded body.
+pub async fn get_chunk_data(
+    client: &Client,
+    chunk: &ChunkDownloadData,
+) -> Result<Bytes, ChunkError> {
+    let mut decompress_attempt = 0;
+    loop {
+        let response = send_chunk_request(client, chunk).await?;
+        let encoding_header = response.headers().get(header::CONTENT_ENCODING).cloned();
+        let body = response.bytes().await.context(CommunicationSnafu)?;
+
+        match decode_chunk_body(body, encoding_header.as_ref(), chunk.uncompressed_size) {
+            Ok(decoded) => return Ok(decoded),
+            Err(err @ ChunkError::Decompression { .. }) => {
+                if decompress_attempt >= MAX_CHUNK_DECOMPRESSION_RETRIES {
+                    return Err(err);
+                }
+                decompress_attempt += 1;
+                tracing::warn!(
+                    attempt = decompress_attempt,
+                    url = %chunk.url,
+                    "Chunk decompression failed, retrying"
+                );
+                continue;
+            }
+            Err(err) => return Err(err),
+        }
+    }
+}
+
+/// Requests a chunk with retries and returns the successful response before
+/// its body has been read.
+async fn send_chunk_request(
+    client: &Client,
+    chunk: &ChunkDownloadData,
+) -> Result<reqwest::Response, ChunkError> {
+    let url = &chunk.url;
+    let mut headers = HeaderMap::new();
+    for (key, value) in chunk.headers.iter() {
+        let header_name = HeaderName::from_str(key).context(HeaderNameSnafu { key })?;
+        let header_value = HeaderValue::from_str(value).context(HeaderValueSnafu { key })?;
+        headers.insert(header_name, header_value);
+    }
+    use crate::config::retry::RetryPolicy;
+    use crate::http::retry::{HttpContext, HttpError, execute_with_retry};
+    use reqwest::Method;
+
+    let policy = RetryPolicy::default();
+    let ctx = HttpContext::new(Method::GET, url.clone()).with_idempotent(true);
+
+    let response = match execute_with_retry(
+        || client.get(url.clone()).headers(headers.clone()),
+        &ctx,
+        &policy,
+        |r| async move { Ok(r) },
+    )
+    .await
+    {
+        Ok(r) => r,
+        Err(e) => {
+            return match e {
+                HttpError::Transport { source, .. } => Err(source).context(CommunicationSnafu),
+                HttpError::DeadlineExceeded { .. } | HttpError::RetryAfterExceeded { .. } => {
+                    UnsuccessfulResponseHTTPSnafu {
+                        status: reqwest::StatusCode::REQUEST_TIMEOUT,
+                    }
+                    .fail()
+                }
+                HttpError::MaxAttempts { last_status, .. } => UnsuccessfulResponseHTTPSnafu {
+                    status: last_status,
+                }
+                .fail(),
+            };
+        }
+    };
+
+    if !response.status().is_success() {
+        UnsuccessfulResponseHTTPSnafu {
+            status: response.status(),
+        }
+        .fail()?;
+    }
+    Ok(response)
+}
+
+/// Splits a Content-Encoding header into its codings, skipping `identity`.
+fn content_codings(encoding: &HeaderValue) -> Result<impl Iterator<Item = &str>, ChunkError> {
+    let encoding_str = encoding.to_str().context(ContentEncodingHeaderSnafu)?;
+    Ok(encoding_str
+        .split(',')
+        .map(|s| s.trim())
+        .filter(|s| !s.is_empty() && !s.eq_ignore_ascii_case("identity")))
+}
+
+/// Undoes the Content-Encoding of a chunk body.
+///
+/// Identity bodies are returned as they are. Gzip is decompressed into a
+/// buffer allocated once, sized from `uncompressed_size` or the gzip trailer.
+pub fn decode_chunk_body(
+    body: Bytes,
+    encoding: Option<&HeaderValue>,
+    uncompressed_size: Option<usize>,
+) -> Result<Bytes, ChunkError> {
+    let Some(value) = encoding else {
+        return Ok(body);
+    };
+
+    let mut data = body;
+    for token in content_codings(value)? {
+        if token.eq_ignore_ascii_case("gzip") {
+            let mut decompressed =
+                Vec::with_capacity(decompressed_capacity(&data, uncompressed_size));
+            decompress_into(&data, &mut decompressed).context(DecompressionSnafu)?;
+            data = Bytes::from(decompressed);
+            continue;
+        }
+        return UnsupportedEncodingSnafu {
+            encoding: token.to_string(),
+        }
+        .fail();
+    }
+
+    Ok(data)
+}
+
+/// Upper bound on the gzip trailer hint, as a multiple of the compressed
+/// length. The trailer comes from the response body, so a malformed one must
+/// not be able to force an arbitrarily large allocation.
+const MAX_GZIP_SIZE_HINT_RATIO: usize = 32;
+
+fn decompressed_capacity(data: &[u8], uncompressed_size: Option<usize>) -> usize {
+    uncompressed_size
+        .or_else(|| {
+            gzip_uncompressed_size_hint(data)
+                .map(|hint| hint.min(data.len().saturating_mul(MAX_GZIP_SIZE_HINT_RATIO)))
+        })
+        .unwrap_or(data.len())
+}
+
+#[derive(Snafu, Debug)]
+pub enum ChunkError {
+    #[snafu(display("Invalid header name for {key}"))]
+    HeaderName {
+        key: String,
+        source: reqwest::header::InvalidHeaderName,
+        #[snafu(implicit)]
+        location: Location,
+    },
+    #[snafu(display("Invalid header value for {key}"))]
+    HeaderValue {
+        key: String,
+        source: reqwest::header::InvalidHeaderValue,
+        #[snafu(implicit)]
+        location: Location,
+    },
+    #[snafu(display("Failed to communicate with Snowflake to get chunk data"))]
+    Communication {
+        source: reqwest::Error,
+        #[snafu(implicit)]
+        location: Location,
+    },
+    #[snafu(display("Snowflake responded with non-successful HTTP status"))]
+    UnsuccessfulResponseHTTP {
+        status: reqwest::StatusCode,
+        #[snafu(implicit)]
+        location: Location,
+    },
+    #[snafu(display("Failed to decompress chunk data: {source}"))]
+    Decompression {
+        source: CompressionError,
+        #[snafu(implicit)]
+        location: Location,
+    },
+    #[snafu(display("Content-Encoding header is not valid UTF-8"))]
+    ContentEncodingHeader {
+        source: reqwest::header::ToStrError,
+        #[snafu(implicit)]
+        location: Location,
+    },
+    #[snafu(display("Unsupported content encoding: {encoding}"))]
+    UnsupportedEncoding {
+        encoding: String,
+        #[snafu(implicit)]
+        location: Location,
+    },
+    #[snafu(display("Failed to start the driver runtime for chunk prefetching"))]
+    RuntimeCreation {
+        source: io::Error,
+        #[snafu(implicit)]
+        location: Location,
+    },
+    #[snafu(display("Failed to read chunk data"))]
+    ChunkReading {
+        source: ArrowError,
+        #[snafu(implicit)]
+        location: Location,
+    },
+    #[snafu(display("Invalid partition descriptor"))]
+    PartitionDescriptor {
+        source: serde_json::Error,
+        #[snafu(implicit)]
+        location: Location,
+    },
+    #[snafu(display("Failed to decode base64 partition data"))]
+    InlineChunkDecoding {
+        source: base64::DecodeError,
+        #[snafu(implicit)]
+        location: Location,
+    },
+    #[snafu(display("Failed to spill chunk data to disk"))]
+    Spill {
+        source: io::Error,
+        #[snafu(implicit)]
+        location: Location,
+    },
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::compression::compress_data;
+    use arrow::array::{Array, Int64Array};
+    use arrow::datatypes::{DataType, Field, Schema};
+    use arrow_ipc::writer::StreamWriter;
+    use std::sync::Arc;
+
+    fn ipc_stream(batches: usize, rows: i64) -> Vec<u8> {
+        let schema = Arc::new(Schema::new(vec![Field::new("ID", DataType::Int64, false)]));
+        let mut writer = StreamWriter::try_new(Vec::new(), &schema).unwrap();
+        for batch in 0..batches as i64 {
+            let ids = Int64Array::from_iter_values(batch * rows..(batch + 1) * rows);
+            writer
+                .write(&RecordBatch::try_new(schema.clone(), vec![Arc::new(ids)]).unwrap())
+                .unwrap();
+        }
+        writer.into_inner().unwrap()
+    }
+
+    fn header(value: &str) -> HeaderValue {
+        HeaderValue::from_str(value).expect("valid header value")
+    }
+
+    #[test]
+    fn decode_chunk_body_identity_returns_original() {
+        let source = Bytes::from_static(b"hello world");
+        let identity = header("identity");
+        let decoded =
+            decode_chunk_body(source.clone(), Some(&identity), None).expect("identity succeeds");
+        assert_eq!(decoded, source);
+        assert_eq!(decoded.as_ptr(), source.as_ptr());
+    }
+
+    #[test]
+    fn decode_chunk_body_supports_gzip() {
+        let payload = b"payload".to_vec();
+        let compressed = compress_data(payload.clone()).expect("compression succeeds");
+        let gzip = header("gzip");
+        let decoded =
+            decode_chunk_body(compressed.into(), Some(&gzip), None).expect("gzip decodes");
+        assert_eq!(decoded, payload);
+    }
+
+    #[test]
+    fn decode_chunk_body_supports_mixed_encodings() {
+        let payload = b"abc123".to_vec();
+        let compressed = compress_data(payload.clone()).expect("compression succeeds");
+        let gzip_identity = header(" gzip , identity ");
+        let decoded = decode_chunk_body(compressed.into(), Some(&gzip_identity), Some(6))
+            .expect("mixed encodings decode");
+        assert_eq!(decoded, payload);
+    }
+
+    #[test]
+    fn decode_chunk_body_rejects_unsupported_encoding() {
+        let data = Bytes::from_static(b"bytes");
+        let unsupported = header("br");
+        let err = decode_chunk_body(data, Some(&unsupported), None).expect_err("br unsupported");
+        match err {
+            ChunkError::UnsupportedEncoding { encoding, .. } => assert_eq!(encoding, "br"),
+            other => panic!("expected unsupported-encoding error, got {other:?}"),
+        }
+    }
+
+    #[test]
+    fn chunk_batches_decode_in_place() {
+        let data = Bytes::from(ipc_stream(3, 100));
+        let mut batches = ChunkBatches::new(data.clone());
+        assert_eq!(batches.schema().unwrap().field(0).name(), "ID");
+
+        let batches = batches.collect::<Result<Vec<_>, _>>().unwrap();
+        assert_eq!(batches.len(), 3);
+        let ids = batches[2]
+            .column(0)
+            .as_any()
+            .downcast_ref::<Int64Array>()
+            .unwrap();
+        assert_eq!(ids.value(99), 299);
+        let values = ids.values().inner().as_ptr() as usize;
+        let body = data.as_ptr_range();
+        assert!((body.start as usize..body.end as usize).contains(&values));
+    }
+
+    #[test]
+    fn chunk_batches_report_truncated_stream() {
+        let data = ipc_stream(1, 100);
+        let truncated = Bytes::copy_from_slice(&data[..data.len() - 16]);
+        let results = ChunkBatches::new(truncated).collect::<Vec<_>>();
+        assert!(results.last().unwrap().is_err());
+    }
+
+    #[test]
+    fn gzip_trailer_gives_uncompressed_size() {
+        let payload = ipc_stream(2, 1000);
+        let compressed = compress_data(payload.clone()).expect("compression succeeds");
+        assert_eq!(
+            gzip_uncompressed_size_hint(&compressed),
+            Some(payload.len())
+        );
+    }
+
+    #[test]
+    fn malformed_gzip_trailer_hint_is_capped() {
+        let mut body = vec![0u8; 16];
+        body.extend_from_slice(&u32::MAX.to_le_bytes());
+        assert_eq!(
+            decompressed_capacity(&body, None),
+            body.len() * MAX_GZIP_SIZE_HINT_RATIO
+        );
+        assert_eq!(decompressed_capacity(&body, Some(1024)), 1024);
+    }
+}
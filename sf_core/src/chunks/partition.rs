@@ -0,0 +1,150 @@
+use std::collections::HashMap;
+
+use arrow::datatypes::SchemaRef;
+use arrow::error::ArrowError;
+use base64::{Engine, engine::general_purpose::STANDARD as BASE64};
+use bytes::Bytes;
+use reqwest::Client;
+use reqwest::header;
+use serde::{Deserialize, Serialize};
+use snafu::ResultExt;
+
+use super::{
+    ChunkDownloadData, ChunkError, ChunkReader, ChunkReadingSnafu, CommunicationSnafu,
+    InlineChunkDecodingSnafu, PartitionDescriptorSnafu, StreamingChunkDecoder, get_chunk_data,
+    send_chunk_request,
+};
+
+/// Self-contained description of one chunk of a result.
+///
+/// A descriptor carries everything needed to fetch its chunk, so it can be
+/// read through any connection, in another thread or another process.
+#[derive(Serialize, Deserialize, Debug, Clone, PartialEq, Eq)]
+#[serde(tag = "kind", rename_all = "snake_case")]
+pub enum PartitionDescriptor {
+    /// Base64 encoded Arrow IPC stream that came with the query response
+    Inline { data: String },
+    Remote {
+        url: String,
+        headers: HashMap<String, String>,
+        uncompressed_size: Option<usize>,
+    },
+}
+
+impl PartitionDescriptor {
+    pub fn inline(data: &[u8]) -> Self {
+        Self::Inline {
+            data: BASE64.encode(data),
+        }
+    }
+
+    pub fn remote(chunk: &ChunkDownloadData) -> Self {
+        Self::Remote {
+            url: chunk.url.clone(),
+            headers: chunk.headers.clone(),
+            uncompressed_size: chunk.uncompressed_size,
+        }
+    }
+
+    pub fn to_bytes(&self) -> Vec<u8> {
+        serde_json::to_vec(self).expect("Partition descriptors always serialize")
+    }
+
+    pub fn from_bytes(bytes: &[u8]) -> Result<Self, ChunkError> {
+        serde_json::from_slice(bytes).context(PartitionDescriptorSnafu)
+    }
+
+    /// Fetches the chunk and returns a reader over its batches.
+    pub async fn read(&self, client: &Client) -> Result<ChunkReader, ChunkError> {
+        let data = match self {
+            Self::Inline { data } => {
+                Bytes::from(BASE64.decode(data).context(InlineChunkDecodingSnafu)?)
+            }
+            Self::Remote {
+                url,
+                headers,
+                uncompressed_size,
+            } => {
+                let chunk = ChunkDownloadData {
+                    url: url.clone(),
+                    headers: headers.clone(),
+                    uncompressed_size: *uncompressed_size,
+                };
+                get_chunk_data(client, &chunk).await?
+            }
+        };
+        ChunkReader::single_chunk(data)
+    }
+}
+
+/// Reads a chunk only as far as its schema and drops the rest of the download.
+pub async fn read_chunk_schema(
+    client: &Client,
+    chunk: &ChunkDownloadData,
+) -> Result<SchemaRef, ChunkError> {
+    let mut response = send_chunk_request(client, chunk).await?;
+    let encoding = response.headers().get(header::CONTENT_ENCODING).cloned();
+    let mut decoder = StreamingChunkDecoder::new(encoding.as_ref())?;
+    while let Some(data) = response.chunk().await.context(CommunicationSnafu)? {
+        decoder.push(data)?;
+        if let Some(schema) = decoder.schema() {
+            return Ok(schema);
+        }
+    }
+    Err(ArrowError::IpcError(
+        "Chunk ended before its schema".to_string(),
+    ))
+    .context(ChunkReadingSnafu)
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use arrow::array::{Int64Array, RecordBatch};
+    use arrow::datatypes::{DataType, Field, Schema};
+    use arrow_ipc::writer::StreamWriter;
+    use std::sync::Arc;
+
+    #[test]
+    fn remote_descriptor_round_trips() {
+        let headers = HashMap::from([(
+            "x-amz-server-side-encryption".to_string(),
+            "AES256".to_string(),
+        )]);
+        let chunk =
+            ChunkDownloadData::new("https://stage/chunk_1", &headers).with_uncompressed_size(1024);
+        let descriptor = PartitionDescriptor::remote(&chunk);
+        let bytes = descriptor.to_bytes();
+        assert_eq!(PartitionDescriptor::from_bytes(&bytes).unwrap(), descriptor);
+    }
+
+    #[test]
+    fn rejects_malformed_descriptor() {
+        assert!(matches!(
+            PartitionDescriptor::from_bytes(b"{\"kind\":\"local\"}"),
+            Err(ChunkError::PartitionDescriptor { .. })
+        ));
+    }
+
+    #[tokio::test]
+    async fn inline_descriptor_reads_without_network() {
+        let schema = Arc::new(Schema::new(vec![Field::new("ID", DataType::Int64, false)]));
+        let batch = RecordBatch::try_new(
+            schema.clone(),
+            vec![Arc::new(Int64Array::from(vec![1, 2, 3]))],
+        )
+        .unwrap();
+        let mut writer = StreamWriter::try_new(Vec::new(), &schema).unwrap();
+        writer.write(&batch).unwrap();
+        let descriptor = PartitionDescriptor::inline(&writer.into_inner().unwrap());
+
+        let bytes = descriptor.to_bytes();
+        let reader = PartitionDescriptor::from_bytes(&bytes)
+            .unwrap()
+            .read(&Client::new())
+            .await
+            .unwrap();
+        let batches = reader.collect::<Result<Vec<_>, _>>().unwrap();
+        assert_eq!(batches, vec![batch]);
+    }
+}
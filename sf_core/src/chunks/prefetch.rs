@@ -0,0 +1,341 @@
+use std::collections::{BTreeMap, VecDeque};
+use std::path::PathBuf;
+use std::sync::Arc;
+use std::sync::mpsc::{self, Receiver, Sender};
+
+use tokio::task::JoinSet;
+
+use arrow::array::RecordBatch;
+use bytes::Bytes;
+use reqwest::Client;
+use snafu::ResultExt;
+
+use super::result_buffer::{ResultBufferManager, SpillStats, SpilledChunk};
+use super::{
+    ChunkBatches, ChunkDownloadData, ChunkError, ChunkReadingSnafu, RuntimeCreationSnafu,
+    get_chunk_data,
+};
+use crate::config::ConfigError;
+use crate::config::settings::{Settings, positive_int_setting};
+
+pub const CHUNK_PREFETCH_DEPTH_OPTION: &str = "chunk_prefetch_depth";
+pub const CHUNK_PREFETCH_MEMORY_BUDGET_OPTION: &str = "chunk_prefetch_memory_budget";
+pub const CHUNK_STREAMING_OPTION: &str = "chunk_streaming";
+pub const CHUNK_SPILL_DIRECTORY_OPTION: &str = "chunk_spill_directory";
+
+const DEFAULT_PREFETCH_DEPTH: usize = 4;
+const DEFAULT_MEMORY_BUDGET_BYTES: usize = 512 * 1024 * 1024;
+// Reservation used for chunks whose metadata does not carry an uncompressed size
+const DEFAULT_CHUNK_SIZE_HINT: usize = 16 * 1024 * 1024;
+
+/// Controls how many result chunks are downloaded ahead of the consumer.
+#[derive(Clone, Debug, PartialEq, Eq)]
+pub struct ChunkPrefetchConfig {
+    /// Maximum number of chunk downloads kept in flight at the same time.
+    pub prefetch_depth: usize,
+    /// Upper bound for the bytes held by chunks that are downloading or decoded
+    /// but not yet handed to the consumer. The head chunk is always allowed,
+    /// so a single chunk larger than the budget cannot stall the reader. With
+    /// a spill directory, chunks kept in memory also count until the consumer
+    /// drops their batches.
+    pub memory_budget_bytes: usize,
+    /// Decode chunks while they download and hand out batches one at a time
+    /// instead of materializing whole chunks.
+    pub streaming: bool,
+    /// Directory for chunks that arrive while the memory budget is used up.
+    /// Downloads wait for the consumer instead when unset. Spilled chunks are
+    /// not capped, the directory needs room for the rest of the result.
+    pub spill_directory: Option<PathBuf>,
+}
+
+impl Default for ChunkPrefetchConfig {
+    fn default() -> Self {
+        Self {
+            prefetch_depth: DEFAULT_PREFETCH_DEPTH,
+            memory_budget_bytes: DEFAULT_MEMORY_BUDGET_BYTES,
+            streaming: false,
+            spill_directory: None,
+        }
+    }
+}
+
+impl ChunkPrefetchConfig {
+    pub fn from_settings(settings: &dyn Settings) -> Result<Self, ConfigError> {
+        let defaults = Self::default();
+        Ok(Self {
+            prefetch_depth: positive_int_setting(settings, CHUNK_PREFETCH_DEPTH_OPTION)?
+                .unwrap_or(defaults.prefetch_depth),
+            memory_budget_bytes: positive_int_setting(
+                settings,
+                CHUNK_PREFETCH_MEMORY_BUDGET_OPTION,
+            )?
+            .unwrap_or(defaults.memory_budget_bytes),
+            streaming: settings
+                .get_string(CHUNK_STREAMING_OPTION)
+                .map(|s| s.to_lowercase() == "true")
+                .unwrap_or(defaults.streaming),
+            spill_directory: settings
+                .get_string(CHUNK_SPILL_DIRECTORY_OPTION)
+                .map(PathBuf::from)
+                .or(defaults.spill_directory),
+        })
+    }
+}
+
+enum ChunkBody {
+    InMemory(Vec<RecordBatch>),
+    Spilled(SpilledChunk),
+}
+
+struct CompletedChunk {
+    index: usize,
+    reservation: usize,
+    // Decoded body length held in memory; the batches are slices of that one buffer
+    size: usize,
+    result: Result<ChunkBody, ChunkError>,
+}
+
+struct ReadyChunk {
+    size: usize,
+    result: Result<ChunkBody, ChunkError>,
+}
+
+/// Downloads and decodes chunks in the background and returns them in sequence.
+///
+/// All bookkeeping happens on the consumer thread: every call to `next_chunk`
+/// collects finished downloads, tops the pipeline up to `prefetch_depth` within
+/// the memory budget and then waits only if the head chunk is still missing.
+///
+/// With a spill directory the budget no longer holds downloads back: chunks
+/// that do not fit are written to disk and mapped back when their turn comes.
+pub(super) struct ChunkPrefetcher {
+    config: ChunkPrefetchConfig,
+    client: Client,
+    runtime: tokio::runtime::Handle,
+    buffer: Option<Arc<ResultBufferManager>>,
+    // Dropping the set aborts downloads that are still in flight.
+    tasks: JoinSet<()>,
+    pending: VecDeque<ChunkDownloadData>,
+    next_to_schedule: usize,
+    next_to_return: usize,
+    in_flight: usize,
+    reserved_bytes: usize,
+    ready: BTreeMap<usize, ReadyChunk>,
+    results_tx: Sender<CompletedChunk>,
+    results_rx: Receiver<CompletedChunk>,
+}
+
+impl ChunkPrefetcher {
+    pub(super) fn new(
+        chunks: VecDeque<ChunkDownloadData>,
+        client: Client,
+        config: ChunkPrefetchConfig,
+    ) -> Result<Self, ChunkError> {
+        let runtime = crate::runtime::global_runtime()
+            .context(RuntimeCreationSnafu)?
+            .handle()
+            .clone();
+        let buffer = match &config.spill_directory {
+            Some(directory) => Some(Arc::new(ResultBufferManager::new(
+                config.memory_budget_bytes,
+                directory,
+            )?)),
+            None => None,
+        };
+        let (results_tx, results_rx) = mpsc::channel();
+        let mut prefetcher = Self {
+            config,
+            client,
+            runtime,
+            buffer,
+            tasks: JoinSet::new(),
+            pending: chunks,
+            next_to_schedule: 0,
+            next_to_return: 0,
+            in_flight: 0,
+            reserved_bytes: 0,
+            ready: BTreeMap::new(),
+            results_tx,
+            results_rx,
+        };
+        prefetcher.schedule();
+        Ok(prefetcher)
+    }
+
+    /// Returns the decoded batches of the next chunk in sequence, or `None`
+    /// once every chunk has been handed out.
+    pub(super) fn next_chunk(&mut self) -> Option<Result<Vec<RecordBatch>, ChunkError>> {
+        loop {
+            while let Ok(completed) = self.results_rx.try_recv() {
+                self.accept(completed);
+            }
+            self.schedule();
+
+            if let Some(ready) = self.ready.remove(&self.next_to_return) {
+                self.next_to_return += 1;
+                self.reserved_bytes -= ready.size;
+                self.schedule();
+                return Some(ready.result.and_then(|body| match body {
+                    ChunkBody::InMemory(batches) => Ok(batches),
+                    ChunkBody::Spilled(spilled) => decode_chunk(spilled.load()?),
+                }));
+            }
+
+            if self.in_flight == 0 {
+                return None;
+            }
+
+            // The sender half lives in `self`, so the channel cannot disconnect here.
+            let completed = self.results_rx.recv().ok()?;
+            self.accept(completed);
+        }
+    }
+
+    /// Spill counters, `None` unless a spill directory is configured.
+    pub(super) fn spill_stats(&self) -> Option<SpillStats> {
+        self.buffer.as_ref().map(|buffer| buffer.stats())
+    }
+
+    fn accept(&mut self, completed: CompletedChunk) {
+        self.in_flight -= 1;
+        while self.tasks.try_join_next().is_some() {}
+        let size = completed.size;
+        // Swap the size hint for the real decoded size now that it is known.
+        self.reserved_bytes = self.reserved_bytes - completed.reservation + size;
+        self.ready.insert(
+            completed.index,
+            ReadyChunk {
+                size,
+                result: completed.result,
+            },
+        );
+    }
+
+    fn schedule(&mut self) {
+        while self.in_flight < self.config.prefetch_depth {
+            let Some(reservation) = self.pending.front().map(chunk_size_hint) else {
+                break;
+            };
+            let budget_exceeded =
+                self.reserved_bytes + reservation > self.config.memory_budget_bytes;
+            if budget_exceeded && self.reserved_bytes > 0 && self.buffer.is_none() {
+                break;
+            }
+            let chunk = self.pending.pop_front().unwrap();
+            let index = self.next_to_schedule;
+            self.next_to_schedule += 1;
+            self.in_flight += 1;
+            self.reserved_bytes += reservation;
+
+            let client = self.client.clone();
+            let buffer = self.buffer.clone();
+            let results_tx = self.results_tx.clone();
+            let task = async move {
+                let (size, result) = match get_chunk_data(&client, &chunk).await {
+                    // Held chunks return their bytes to the budget once the
+                    // consumer drops their batches. Decoding and spilling both
+                    // block, so keep them off the async workers.
+                    Ok(data) => tokio::task::block_in_place(|| match buffer {
+                        Some(buffer) => match buffer.try_hold(data) {
+                            Ok(held) => (held.len(), decode_chunk(held).map(ChunkBody::InMemory)),
+                            Err(data) => (0, buffer.spill(&data).map(ChunkBody::Spilled)),
+                        },
+                        None => (data.len(), decode_chunk(data).map(ChunkBody::InMemory)),
+                    }),
+                    Err(e) => (0, Err(e)),
+                };
+                let _ = results_tx.send(CompletedChunk {
+                    index,
+                    reservation,
+                    size,
+                    result,
+                });
+            };
+            self.tasks.spawn_on(task, &self.runtime);
+        }
+    }
+}
+
+impl Drop for ChunkPrefetcher {
+    fn drop(&mut self) {
+        if let Some(stats) = self.spill_stats().filter(|stats| stats.chunks_spilled > 0) {
+            tracing::debug!(?stats, "Result chunks spilled to disk");
+        }
+    }
+}
+
+fn chunk_size_hint(chunk: &ChunkDownloadData) -> usize {
+    chunk.uncompressed_size.unwrap_or(DEFAULT_CHUNK_SIZE_HINT)
+}
+
+fn decode_chunk(data: Bytes) -> Result<Vec<RecordBatch>, ChunkError> {
+    ChunkBatches::new(data)
+        .collect::<Result<Vec<_>, _>>()
+        .context(ChunkReadingSnafu)
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::config::settings::Setting;
+    use std::collections::HashMap;
+
+    #[test]
+    fn prefetch_config_defaults_when_unset() {
+        let settings: HashMap<String, Setting> = HashMap::new();
+        let config = ChunkPrefetchConfig::from_settings(&settings).unwrap();
+        assert_eq!(config, ChunkPrefetchConfig::default());
+    }
+
+    #[test]
+    fn prefetch_config_accepts_int_and_string_values() {
+        let mut settings: HashMap<String, Setting> = HashMap::new();
+        settings.insert(CHUNK_PREFETCH_DEPTH_OPTION.to_string(), Setting::Int(8));
+        settings.insert(
+            CHUNK_PREFETCH_MEMORY_BUDGET_OPTION.to_string(),
+            Setting::String("1048576".to_string()),
+        );
+        let config = ChunkPrefetchConfig::from_settings(&settings).unwrap();
+        assert_eq!(config.prefetch_depth, 8);
+        assert_eq!(config.memory_budget_bytes, 1_048_576);
+        assert!(!config.streaming);
+    }
+
+    #[test]
+    fn prefetch_config_enables_streaming() {
+        let mut settings: HashMap<String, Setting> = HashMap::new();
+        settings.insert(
+            CHUNK_STREAMING_OPTION.to_string(),
+            Setting::String("TRUE".to_string()),
+        );
+        let config = ChunkPrefetchConfig::from_settings(&settings).unwrap();
+        assert!(config.streaming);
+    }
+
+    #[test]
+    fn prefetch_config_reads_spill_directory() {
+        let mut settings: HashMap<String, Setting> = HashMap::new();
+        settings.insert(
+            CHUNK_SPILL_DIRECTORY_OPTION.to_string(),
+            Setting::String("/var/tmp/results".to_string()),
+        );
+        let config = ChunkPrefetchConfig::from_settings(&settings).unwrap();
+        assert_eq!(
+            config.spill_directory,
+            Some(PathBuf::from("/var/tmp/results"))
+        );
+    }
+
+    #[test]
+    fn prefetch_config_rejects_zero_depth() {
+        let mut settings: HashMap<String, Setting> = HashMap::new();
+        settings.insert(CHUNK_PREFETCH_DEPTH_OPTION.to_string(), Setting::Int(0));
+        let err = ChunkPrefetchConfig::from_settings(&settings).expect_err("zero depth");
+        match err {
+            ConfigError::InvalidParameterValue { parameter, .. } => {
+                assert_eq!(parameter, CHUNK_PREFETCH_DEPTH_OPTION)
+            }
+            other => panic!("expected invalid-parameter error, got {other:?}"),
+        }
+    }
+}
@@ -0,0 +1,209 @@
+use std::io::Write;
+use std::path::Path;
+use std::sync::Arc;
+use std::sync::atomic::{AtomicU64, AtomicUsize, Ordering};
+
+use bytes::Bytes;
+use memmap2::Mmap;
+use snafu::ResultExt;
+use tempfile::{NamedTempFile, TempDir};
+
+use super::{ChunkError, SpillSnafu};
+
+/// Totals of result data moved to and from the spill directory.
+#[derive(Clone, Copy, Debug, Default, PartialEq, Eq)]
+pub struct SpillStats {
+    pub chunks_spilled: u64,
+    pub bytes_spilled: u64,
+    pub bytes_reread: u64,
+}
+
+#[derive(Default)]
+struct SpillCounters {
+    chunks_spilled: AtomicU64,
+    bytes_spilled: AtomicU64,
+    bytes_reread: AtomicU64,
+}
+
+/// Keeps decoded chunk bodies in memory up to a byte budget and writes the
+/// rest to a private temporary directory.
+///
+/// Chunk bodies are Arrow IPC streams, so a spilled chunk is stored as is and
+/// memory-mapped back when the consumer reaches it; its batches then point
+/// into the mapping instead of the heap.
+pub(super) struct ResultBufferManager {
+    memory_budget_bytes: usize,
+    // Shared with the chunks held in memory, which return their bytes on drop
+    in_memory_bytes: Arc<AtomicUsize>,
+    // Removed with everything still in it when the last chunk is gone
+    directory: Arc<TempDir>,
+    counters: Arc<SpillCounters>,
+}
+
+impl ResultBufferManager {
+    pub(super) fn new(memory_budget_bytes: usize, parent: &Path) -> Result<Self, ChunkError> {
+        let directory = tempfile::Builder::new()
+            .prefix("sf_result_")
+            .tempdir_in(parent)
+            .context(SpillSnafu)?;
+        Ok(Self {
+            memory_budget_bytes,
+            in_memory_bytes: Arc::default(),
+            directory: Arc::new(directory),
+            counters: Arc::default(),
+        })
+    }
+
+    /// Accounts the chunk body against the budget, handing it back as `Err`
+    /// if it does not fit. A chunk is always admitted while nothing else is
+    /// held in memory. The bytes count until the returned body and every
+    /// batch decoded from it are dropped, not just until the chunk is handed
+    /// to the consumer.
+    pub(super) fn try_hold(&self, body: Bytes) -> Result<Bytes, Bytes> {
+        let size = body.len();
+        let reserved = self
+            .in_memory_bytes
+            .fetch_update(Ordering::AcqRel, Ordering::Acquire, |held| {
+                (held == 0 || held + size <= self.memory_budget_bytes).then_some(held + size)
+            })
+            .is_ok();
+        if !reserved {
+            return Err(body);
+        }
+        Ok(Bytes::from_owner(HeldChunk {
+            body,
+            in_memory_bytes: self.in_memory_bytes.clone(),
+        }))
+    }
+
+    /// Writes a chunk body to its own file in the spill directory.
+    pub(super) fn spill(&self, body: &[u8]) -> Result<SpilledChunk, ChunkError> {
+        let mut file = NamedTempFile::new_in(self.directory.path()).context(SpillSnafu)?;
+        file.write_all(body).context(SpillSnafu)?;
+        file.flush().context(SpillSnafu)?;
+        self.counters.chunks_spilled.fetch_add(1, Ordering::Relaxed);
+        self.counters
+            .bytes_spilled
+            .fetch_add(body.len() as u64, Ordering::Relaxed);
+        Ok(SpilledChunk {
+            file,
+            _directory: self.directory.clone(),
+            counters: self.counters.clone(),
+        })
+    }
+
+    pub(super) fn stats(&self) -> SpillStats {
+        SpillStats {
+            chunks_spilled: self.counters.chunks_spilled.load(Ordering::Relaxed),
+            bytes_spilled: self.counters.bytes_spilled.load(Ordering::Relaxed),
+            bytes_reread: self.counters.bytes_reread.load(Ordering::Relaxed),
+        }
+    }
+}
+
+/// A chunk body waiting on disk.
+pub(super) struct SpilledChunk {
+    file: NamedTempFile,
+    _directory: Arc<TempDir>,
+    counters: Arc<SpillCounters>,
+}
+
+impl SpilledChunk {
+    /// Maps the chunk back. The file is deleted once the returned bytes and
+    /// every batch decoded from them are dropped.
+    pub(super) fn load(self) -> Result<Bytes, ChunkError> {
+        // SAFETY: the file is private to this process and never written again
+        let map = unsafe { Mmap::map(self.file.as_file()) }.context(SpillSnafu)?;
+        self.counters
+            .bytes_reread
+            .fetch_add(map.len() as u64, Ordering::Relaxed);
+        Ok(Bytes::from_owner(MappedChunk {
+            map,
+            _file: self.file,
+            _directory: self._directory,
+        }))
+    }
+}
+
+/// A chunk body counted against the memory budget for as long as it lives.
+struct HeldChunk {
+    body: Bytes,
+    in_memory_bytes: Arc<AtomicUsize>,
+}
+
+impl AsRef<[u8]> for HeldChunk {
+    fn as_ref(&self) -> &[u8] {
+        &self.body
+    }
+}
+
+impl Drop for HeldChunk {
+    fn drop(&mut self) {
+        self.in_memory_bytes
+            .fetch_sub(self.body.len(), Ordering::AcqRel);
+    }
+}
+
+struct MappedChunk {
+    map: Mmap,
+    // Unmapped before the file and its directory are removed
+    _file: NamedTempFile,
+    _directory: Arc<TempDir>,
+}
+
+impl AsRef<[u8]> for MappedChunk {
+    fn as_ref(&self) -> &[u8] {
+        &self.map
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn holds_within_budget_until_bodies_are_dropped() {
+        let parent = tempfile::tempdir().unwrap();
+        let manager = ResultBufferManager::new(100, parent.path()).unwrap();
+        let body = |size: usize| Bytes::from(vec![0u8; size]);
+        let first = manager.try_hold(body(150)).unwrap();
+        assert!(manager.try_hold(body(1)).is_err());
+
+        // A slice, like a decoded batch, keeps the whole body counted
+        let slice = first.slice(0..10);
+        drop(first);
+        assert!(manager.try_hold(body(1)).is_err());
+        drop(slice);
+
+        let _held = (
+            manager.try_hold(body(60)).unwrap(),
+            manager.try_hold(body(40)).unwrap(),
+        );
+        assert!(manager.try_hold(body(1)).is_err());
+    }
+
+    #[test]
+    fn spilled_chunk_round_trips_and_is_removed() {
+        let parent = tempfile::tempdir().unwrap();
+        let manager = ResultBufferManager::new(0, parent.path()).unwrap();
+        let spilled = manager.spill(b"arrow ipc body").unwrap();
+        let path = spilled.file.path().to_path_buf();
+        assert!(path.exists());
+
+        let body = spilled.load().unwrap();
+        assert_eq!(&body[..], b"arrow ipc body");
+        assert_eq!(
+            manager.stats(),
+            SpillStats {
+                chunks_spilled: 1,
+                bytes_spilled: 14,
+                bytes_reread: 14,
+            }
+        );
+        drop(body);
+        assert!(!path.exists());
+
+        drop(manager);
+        assert_eq!(std::fs::read_dir(parent.path()).unwrap().count(), 0);
+    }
+}
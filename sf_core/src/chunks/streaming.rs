@@ -0,0 +1,370 @@
+use std::collections::VecDeque;
+use std::sync::Arc;
+use std::sync::mpsc::{self, Receiver, Sender};
+
+use arrow::array::RecordBatch;
+use arrow::buffer::Buffer;
+use arrow::datatypes::SchemaRef;
+use arrow_ipc::reader::StreamDecoder;
+use bytes::Bytes;
+use reqwest::Client;
+use reqwest::header::{self, HeaderValue};
+use snafu::ResultExt;
+use tokio::sync::Semaphore;
+use tokio::task::JoinSet;
+
+use super::{
+    ChunkDownloadData, ChunkError, ChunkPrefetchConfig, ChunkReadingSnafu, CommunicationSnafu,
+    DecompressionSnafu, MAX_CHUNK_DECOMPRESSION_RETRIES, RuntimeCreationSnafu,
+    UnsupportedEncodingSnafu, content_codings, send_chunk_request,
+};
+use crate::compression::GzipStreamDecoder;
+
+// Decoded batches a chunk may hold before its download waits for the consumer
+const BUFFERED_BATCHES_PER_CHUNK: usize = 2;
+
+/// Turns the pieces of a chunk body into record batches as they arrive.
+///
+/// Gzip is inflated piece by piece and the output goes straight to an
+/// incremental IPC decoder, so only the message being assembled is buffered
+/// instead of the whole compressed and decompressed chunk.
+pub struct StreamingChunkDecoder {
+    gzip: Option<GzipStreamDecoder>,
+    ipc: StreamDecoder,
+}
+
+impl StreamingChunkDecoder {
+    pub fn new(encoding: Option<&HeaderValue>) -> Result<Self, ChunkError> {
+        let mut gzip = None;
+        if let Some(encoding) = encoding {
+            for token in content_codings(encoding)? {
+                if !token.eq_ignore_ascii_case("gzip") || gzip.is_some() {
+                    return UnsupportedEncodingSnafu {
+                        encoding: token.to_string(),
+                    }
+                    .fail();
+                }
+                gzip = Some(GzipStreamDecoder::new());
+            }
+        }
+        Ok(Self {
+            gzip,
+            ipc: StreamDecoder::new(),
+        })
+    }
+
+    /// Consumes the next piece of the body and returns the batches it completed.
+    pub fn push(&mut self, data: Bytes) -> Result<Vec<RecordBatch>, ChunkError> {
+        let data = match &mut self.gzip {
+            Some(gzip) => Bytes::from(gzip.push(&data).context(DecompressionSnafu)?),
+            None => data,
+        };
+        self.decode(data)
+    }
+
+    /// Schema of the stream, once its first message has been decoded.
+    pub fn schema(&self) -> Option<SchemaRef> {
+        self.ipc.schema()
+    }
+
+    /// Returns the batches still buffered once the body has ended.
+    pub fn finish(mut self) -> Result<Vec<RecordBatch>, ChunkError> {
+        let batches = match self.gzip.take() {
+            Some(gzip) => self.decode(Bytes::from(gzip.finish().context(DecompressionSnafu)?))?,
+            None => Vec::new(),
+        };
+        self.ipc.finish().context(ChunkReadingSnafu)?;
+        Ok(batches)
+    }
+
+    fn decode(&mut self, data: Bytes) -> Result<Vec<RecordBatch>, ChunkError> {
+        let mut buffer = Buffer::from(data);
+        let mut batches = Vec::new();
+        while !buffer.is_empty() {
+            if let Some(batch) = self.ipc.decode(&mut buffer).context(ChunkReadingSnafu)? {
+                batches.push(batch);
+            }
+        }
+        Ok(batches)
+    }
+}
+
+struct StreamedChunk {
+    batches: Receiver<Result<RecordBatch, ChunkError>>,
+    // Returned to the download task for every batch the consumer takes
+    credits: Arc<Semaphore>,
+}
+
+/// Streams chunks and hands out their batches in sequence as soon as each
+/// one is decoded.
+///
+/// Up to `prefetch_depth` chunks download concurrently. Each of them holds
+/// at most `BUFFERED_BATCHES_PER_CHUNK` decoded batches, so the memory budget
+/// of the buffered prefetcher does not apply.
+pub(super) struct ChunkStreamer {
+    config: ChunkPrefetchConfig,
+    client: Client,
+    runtime: tokio::runtime::Handle,
+    // Dropping the set aborts downloads that are still in flight.
+    tasks: JoinSet<()>,
+    pending: VecDeque<ChunkDownloadData>,
+    streams: VecDeque<StreamedChunk>,
+}
+
+impl ChunkStreamer {
+    pub(super) fn new(
+        chunks: VecDeque<ChunkDownloadData>,
+        client: Client,
+        config: ChunkPrefetchConfig,
+    ) -> Result<Self, ChunkError> {
+        let runtime = crate::runtime::global_runtime()
+            .context(RuntimeCreationSnafu)?
+            .handle()
+            .clone();
+        let mut streamer = Self {
+            config,
+            client,
+            runtime,
+            tasks: JoinSet::new(),
+            pending: chunks,
+            streams: VecDeque::new(),
+        };
+        streamer.schedule();
+        Ok(streamer)
+    }
+
+    /// Returns the next batch in sequence, or `None` after the last chunk.
+    pub(super) fn next_batch(&mut self) -> Option<Result<RecordBatch, ChunkError>> {
+        loop {
+            let head = self.streams.front()?;
+            match head.batches.recv() {
+                Ok(result) => {
+                    head.credits.add_permits(1);
+                    return Some(result);
+                }
+                // The download task finished and every batch has been taken
+                Err(_) => {
+                    self.streams.pop_front();
+                    while self.tasks.try_join_next().is_some() {}
+                    self.schedule();
+                }
+            }
+        }
+    }
+
+    fn schedule(&mut self) {
+        while self.streams.len() < self.config.prefetch_depth {
+            let Some(chunk) = self.pending.pop_front() else {
+                break;
+            };
+            let (batches_tx, batches) = mpsc::channel();
+            let credits = Arc::new(Semaphore::new(BUFFERED_BATCHES_PER_CHUNK));
+            let client = self.client.clone();
+            let task_credits = credits.clone();
+            let task = async move {
+                let result = stream_chunk(&client, &chunk, &batches_tx, &task_credits).await;
+                if let Err(e) = result {
+                    let _ = batches_tx.send(Err(e));
+                }
+            };
+            self.tasks.spawn_on(task, &self.runtime);
+            self.streams.push_back(StreamedChunk { batches, credits });
+        }
+    }
+}
+
+/// Streams one chunk into its batch channel. A body that breaks off or fails
+/// to decode before any batch reached the consumer is requested again, up to
+/// `MAX_CHUNK_DECOMPRESSION_RETRIES` times. Once a batch has been handed out
+/// the chunk cannot start over, so later failures are returned as they are.
+async fn stream_chunk(
+    client: &Client,
+    chunk: &ChunkDownloadData,
+    batches: &Sender<Result<RecordBatch, ChunkError>>,
+    credits: &Semaphore,
+) -> Result<(), ChunkError> {
+    let mut attempt = 0;
+    loop {
+        let response = send_chunk_request(client, chunk).await?;
+        let mut forwarded = false;
+        match stream_body(response, batches, credits, &mut forwarded).await {
+            Err(
+                err @ (ChunkError::Communication { .. }
+                | ChunkError::Decompression { .. }
+                | ChunkError::ChunkReading { .. }),
+            ) if !forwarded && attempt < MAX_CHUNK_DECOMPRESSION_RETRIES => {
+                attempt += 1;
+                tracing::warn!(
+                    attempt,
+                    url = %chunk.url,
+                    error = %err,
+                    "Chunk stream failed before its first batch, retrying"
+                );
+            }
+            result => return result,
+        }
+    }
+}
+
+async fn stream_body(
+    mut response: reqwest::Response,
+    batches: &Sender<Result<RecordBatch, ChunkError>>,
+    credits: &Semaphore,
+    forwarded: &mut bool,
+) -> Result<(), ChunkError> {
+    let encoding = response.headers().get(header::CONTENT_ENCODING).cloned();
+    let mut decoder = StreamingChunkDecoder::new(encoding.as_ref())?;
+    while let Some(data) = response.chunk().await.context(CommunicationSnafu)? {
+        for batch in decoder.push(data)? {
+            *forwarded = true;
+            if !forward(batch, batches, credits).await {
+                return Ok(());
+            }
+        }
+    }
+    for batch in decoder.finish()? {
+        *forwarded = true;
+        if !forward(batch, batches, credits).await {
+            return Ok(());
+        }
+    }
+    Ok(())
+}
+
+/// Waits for room in the chunk's buffer and sends the batch, returns `false`
+/// once the consumer is gone.
+async fn forward(
+    batch: RecordBatch,
+    batches: &Sender<Result<RecordBatch, ChunkError>>,
+    credits: &Semaphore,
+) -> bool {
+    match credits.acquire().await {
+        Ok(permit) => permit.forget(),
+        Err(_) => return false,
+    }
+    batches.send(Ok(batch)).is_ok()
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::compression::compress_data;
+    use arrow::array::Int64Array;
+    use arrow::datatypes::{DataType, Field, Schema};
+    use arrow_ipc::writer::StreamWriter;
+    use std::collections::HashMap;
+    use tokio::io::{AsyncReadExt, AsyncWriteExt};
+    use tokio::net::TcpListener;
+
+    fn ipc_stream(batches: i64, rows: i64) -> Vec<u8> {
+        let schema = Arc::new(Schema::new(vec![Field::new("ID", DataType::Int64, false)]));
+        let mut writer = StreamWriter::try_new(Vec::new(), &schema).unwrap();
+        for batch in 0..batches {
+            let ids = Int64Array::from_iter_values(batch * rows..(batch + 1) * rows);
+            writer
+                .write(&RecordBatch::try_new(schema.clone(), vec![Arc::new(ids)]).unwrap())
+                .unwrap();
+        }
+        writer.into_inner().unwrap()
+    }
+
+    #[test]
+    fn gzip_chunk_yields_batches_before_the_body_ends() {
+        let body = compress_data(ipc_stream(4, 10_000)).unwrap();
+        let gzip = HeaderValue::from_static("gzip");
+        let mut decoder = StreamingChunkDecoder::new(Some(&gzip)).unwrap();
+
+        let mut rows = Vec::new();
+        let mut first_batch_at = None;
+        for (idx, piece) in body.chunks(512).enumerate() {
+            let batches = decoder.push(Bytes::copy_from_slice(piece)).unwrap();
+            if !batches.is_empty() && first_batch_at.is_none() {
+                first_batch_at = Some(idx);
+            }
+            rows.extend(batches.iter().map(|b| b.num_rows()));
+        }
+        rows.extend(decoder.finish().unwrap().iter().map(|b| b.num_rows()));
+
+        assert_eq!(rows, vec![10_000; 4]);
+        assert!(first_batch_at.unwrap() < body.len() / 512);
+    }
+
+    #[test]
+    fn identity_chunk_decodes_in_pieces() {
+        let body = ipc_stream(2, 100);
+        let mut decoder = StreamingChunkDecoder::new(None).unwrap();
+        let mut rows = 0;
+        for piece in body.chunks(7) {
+            rows += decoder
+                .push(Bytes::copy_from_slice(piece))
+                .unwrap()
+                .iter()
+                .map(|b| b.num_rows())
+                .sum::<usize>();
+        }
+        assert!(decoder.finish().unwrap().is_empty());
+        assert_eq!(rows, 200);
+    }
+
+    #[test]
+    fn truncated_gzip_chunk_fails_on_finish() {
+        let body = compress_data(ipc_stream(1, 100)).unwrap();
+        let gzip = HeaderValue::from_static("gzip");
+        let mut decoder = StreamingChunkDecoder::new(Some(&gzip)).unwrap();
+        decoder
+            .push(Bytes::copy_from_slice(&body[..body.len() - 8]))
+            .unwrap();
+        assert!(matches!(
+            decoder.finish(),
+            Err(ChunkError::Decompression { .. })
+        ));
+    }
+
+    #[test]
+    fn rejects_unsupported_encoding() {
+        let encoding = HeaderValue::from_static("gzip, br");
+        assert!(matches!(
+            StreamingChunkDecoder::new(Some(&encoding)),
+            Err(ChunkError::UnsupportedEncoding { encoding, .. }) if encoding == "br"
+        ));
+    }
+
+    #[tokio::test]
+    async fn retries_chunk_whose_body_fails_before_any_batch() {
+        // Given a server whose first response is not valid gzip and whose second one is
+        let body = compress_data(ipc_stream(2, 100)).unwrap();
+        let responses = vec![b"not gzip".to_vec(), body];
+        let listener = TcpListener::bind("127.0.0.1:0").await.unwrap();
+        let url = format!("http://{}", listener.local_addr().unwrap());
+        let server = tokio::spawn(async move {
+            for body in responses {
+                let (mut socket, _) = listener.accept().await.unwrap();
+                let mut request = [0u8; 4096];
+                let _ = socket.read(&mut request).await.unwrap();
+                let head = format!(
+                    "HTTP/1.1 200 OK\r\nContent-Encoding: gzip\r\nContent-Length: {}\r\nConnection: close\r\n\r\n",
+                    body.len()
+                );
+                socket.write_all(head.as_bytes()).await.unwrap();
+                socket.write_all(&body).await.unwrap();
+            }
+        });
+
+        // When the chunk is streamed
+        let (batches_tx, batches) = mpsc::channel();
+        let credits = Semaphore::new(Semaphore::MAX_PERMITS);
+        let chunk = ChunkDownloadData::new(&url, &HashMap::new());
+        stream_chunk(&Client::new(), &chunk, &batches_tx, &credits)
+            .await
+            .unwrap();
+        drop(batches_tx);
+
+        // Then the second response yields every batch and no error reaches the consumer
+        let rows = batches
+            .iter()
+            .map(|batch| batch.unwrap().num_rows())
+            .collect::<Vec<_>>();
+        assert_eq!(rows, vec![100, 100]);
+        server.await.unwrap();
+    }
+}
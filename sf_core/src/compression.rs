@@ -1,8 +1,9 @@
-use flate2::{Compression, GzBuilder, bufread::GzDecoder};
+use flate2::{Compression, GzBuilder, bufread::GzDecoder, write};
 use snafu::{Location, ResultExt, Snafu};
 use std::io::{Read, Write};
 
-// PUT/GET compression
+// PUT compression in one piece, kept for tests that need gzip input
+#[cfg(test)]
 pub fn compress_data(input_data: Vec<u8>) -> Result<Vec<u8>, CompressionError> {
     // Use GzBuilder to create gzip with a zeroed timestamp for consistent normalization
     let mut encoder = GzBuilder::new()
@@ -15,14 +16,82 @@ pub fn compress_data(input_data: Vec<u8>) -> Result<Vec<u8>, CompressionError> {
     Ok(compressed_data)
 }
 
+/// Incremental gzip compression for PUT. Uses a zeroed timestamp, so the
+/// same input always compresses to the same output.
+pub struct GzipStreamEncoder {
+    encoder: write::GzEncoder<Vec<u8>>,
+}
+
+impl Default for GzipStreamEncoder {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+impl GzipStreamEncoder {
+    pub fn new() -> Self {
+        Self {
+            encoder: GzBuilder::new()
+                .mtime(0)
+                .write(Vec::new(), Compression::best()),
+        }
+    }
+
+    /// Compresses the next piece and returns the output it produced so far.
+    pub fn push(&mut self, input: &[u8]) -> Result<Vec<u8>, CompressionError> {
+        self.encoder.write_all(input).context(DataWritingSnafu)?;
+        Ok(std::mem::take(self.encoder.get_mut()))
+    }
+
+    /// Returns the remaining output, including the gzip trailer.
+    pub fn finish(self) -> Result<Vec<u8>, CompressionError> {
+        self.encoder.finish().context(DataWritingSnafu)
+    }
+}
+
 // Chunks decompression
-pub fn decompress_data(input_data: &[u8]) -> Result<Vec<u8>, CompressionError> {
+/// Streams the decompressed gzip data into `output`, reserve its capacity
+/// up front to avoid reallocations.
+pub fn decompress_into(input_data: &[u8], output: &mut Vec<u8>) -> Result<(), CompressionError> {
     let mut decoder = GzDecoder::new(input_data);
-    let mut decompressed_data = Vec::new();
-    decoder
-        .read_to_end(&mut decompressed_data)
-        .context(DataReadingSnafu)?;
-    Ok(decompressed_data)
+    decoder.read_to_end(output).context(DataReadingSnafu)?;
+    Ok(())
+}
+
+/// Uncompressed size recorded in the gzip trailer (ISIZE, modulo 2^32).
+pub fn gzip_uncompressed_size_hint(input_data: &[u8]) -> Option<usize> {
+    let trailer = *input_data.last_chunk::<4>()?;
+    usize::try_from(u32::from_le_bytes(trailer)).ok()
+}
+
+/// Incremental gzip decompression for bodies that arrive in pieces.
+pub struct GzipStreamDecoder {
+    decoder: write::GzDecoder<Vec<u8>>,
+}
+
+impl Default for GzipStreamDecoder {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+impl GzipStreamDecoder {
+    pub fn new() -> Self {
+        Self {
+            decoder: write::GzDecoder::new(Vec::new()),
+        }
+    }
+
+    /// Decompresses the next piece and returns the output it produced.
+    pub fn push(&mut self, input: &[u8]) -> Result<Vec<u8>, CompressionError> {
+        self.decoder.write_all(input).context(DataReadingSnafu)?;
+        Ok(std::mem::take(self.decoder.get_mut()))
+    }
+
+    /// Returns the remaining output, failing if the gzip stream is incomplete.
+    pub fn finish(self) -> Result<Vec<u8>, CompressionError> {
+        self.decoder.finish().context(DataReadingSnafu)
+    }
 }
 
 #[derive(Snafu, Debug)]
@@ -93,3 +93,26 @@ impl Settings for HashMap<String, Setting> {
         self.insert(key.to_string(), value);
     }
 }
+
+/// Reads a strictly positive integer setting. Wrappers such as ODBC pass every
+/// option as a string, so string values are parsed as well.
+pub fn positive_int_setting(
+    settings: &dyn Settings,
+    key: &str,
+) -> Result<Option<usize>, super::ConfigError> {
+    let value = match settings.get(key) {
+        None => return Ok(None),
+        Some(Setting::Int(value)) => value.to_string(),
+        Some(Setting::String(value)) => value,
+        Some(other) => format!("{other:?}"),
+    };
+    match value.trim().parse::<usize>() {
+        Ok(parsed) if parsed > 0 => Ok(Some(parsed)),
+        _ => super::InvalidParameterValueSnafu {
+            parameter: key,
+            value,
+            explanation: "Expected a positive integer",
+        }
+        .fail(),
+    }
+}
@@ -1,14 +1,12 @@
-use super::types::{
-    EncryptedFileMetadata, EncryptionMaterial, EncryptionResult, MaterialDescription,
-};
+use super::types::{EncryptedFileMetadata, EncryptionMaterial, MaterialDescription};
 use snafu::{Location, ResultExt, Snafu};
 
 use base64::{Engine, engine::general_purpose::STANDARD as BASE64_ENGINE};
 use openssl::{
     error::ErrorStack as OpenSslErrorStack,
-    hash::{MessageDigest, hash},
+    hash::{Hasher, MessageDigest},
     rand::rand_bytes,
-    symm::{Cipher, decrypt, encrypt},
+    symm::{Cipher, Crypter, Mode, decrypt, encrypt},
 };
 
 // Cryptographic constants
@@ -41,109 +39,261 @@ impl CipherSuite {
     }
 }
 
-/// Encrypts file data using AES-CBC with PKCS#7 padding.
-pub fn encrypt_file_data(
-    file_data: &[u8],
-    encryption_material: &EncryptionMaterial,
-) -> Result<EncryptionResult, EncryptionError> {
-    // 1. Decode master key and select the appropriate cipher suite.
-    let master_key = BASE64_ENGINE
-        .decode(&encryption_material.query_stage_master_key)
-        .context(Base64DecodingSnafu {
-            context: "master key",
+/// Encrypts a file piece by piece using AES-CBC with PKCS#7 padding, hashing
+/// the ciphertext as it is produced.
+pub struct FileEncryptor {
+    crypter: Crypter,
+    hasher: Hasher,
+    encrypted_key: String,
+    iv: String,
+    material_desc: MaterialDescription,
+}
+
+impl FileEncryptor {
+    pub fn new(encryption_material: &EncryptionMaterial) -> Result<Self, EncryptionError> {
+        // 1. Decode master key and select the appropriate cipher suite.
+        let master_key = BASE64_ENGINE
+            .decode(&encryption_material.query_stage_master_key)
+            .context(Base64DecodingSnafu {
+                context: "master key",
+            })?;
+        let cipher_suite = CipherSuite::from_key_len(master_key.len())?;
+
+        // 2. Generate a random data encryption key (file key) and initialization vector (IV).
+        let file_key = generate_random_bytes(cipher_suite.key_len).context(OpenSSLSnafu {
+            operation: "generating file key",
         })?;
-    let cipher_suite = CipherSuite::from_key_len(master_key.len())?;
-
-    // 2. Generate a random data encryption key (file key) and initialization vector (IV).
-    let file_key = generate_random_bytes(cipher_suite.key_len).context(OpenSSLSnafu {
-        operation: "generating file key",
-    })?;
-    let iv = generate_random_bytes(AES_BLOCK_SIZE_IN_BYTES).context(OpenSSLSnafu {
-        operation: "generating initialization vector",
-    })?;
-
-    // 3. Encrypt the file data using the file key and IV with AES-CBC.
-    let encrypted_data =
-        encrypt(cipher_suite.cbc, &file_key, Some(&iv), file_data).context(OpenSSLSnafu {
-            operation: "encrypting file data with AES-CBC",
+        let iv = generate_random_bytes(AES_BLOCK_SIZE_IN_BYTES).context(OpenSSLSnafu {
+            operation: "generating initialization vector",
         })?;
 
-    // 4. Encrypt the file key using the master key with AES-ECB.
-    let encrypted_file_key =
-        encrypt(cipher_suite.ecb, &master_key, None, &file_key).context(OpenSSLSnafu {
-            operation: "encrypting file key with AES-ECB",
+        // 3. Set up AES-CBC with the file key and IV for the file data.
+        let crypter = Crypter::new(cipher_suite.cbc, Mode::Encrypt, &file_key, Some(&iv)).context(
+            OpenSSLSnafu {
+                operation: "initializing AES-CBC encryption",
+            },
+        )?;
+        let hasher = Hasher::new(MessageDigest::sha256()).context(OpenSSLSnafu {
+            operation: "initializing SHA-256 digest",
+        })?;
+
+        // 4. Encrypt the file key using the master key with AES-ECB.
+        let encrypted_file_key =
+            encrypt(cipher_suite.ecb, &master_key, None, &file_key).context(OpenSSLSnafu {
+                operation: "encrypting file key with AES-ECB",
+            })?;
+
+        Ok(Self {
+            crypter,
+            hasher,
+            encrypted_key: BASE64_ENGINE.encode(&encrypted_file_key),
+            iv: BASE64_ENGINE.encode(&iv),
+            material_desc: MaterialDescription {
+                query_id: encryption_material.query_id.clone(),
+                smk_id: encryption_material.smk_id.clone(),
+                key_size: (cipher_suite.key_len * 8).to_string(),
+            },
+        })
+    }
+
+    /// Encrypts the next piece of the file, appending the ciphertext to `out`.
+    pub fn update(&mut self, input: &[u8], out: &mut Vec<u8>) -> Result<(), EncryptionError> {
+        let start = out.len();
+        out.resize(start + input.len() + AES_BLOCK_SIZE_IN_BYTES, 0);
+        let written = self
+            .crypter
+            .update(input, &mut out[start..])
+            .context(OpenSSLSnafu {
+                operation: "encrypting file data with AES-CBC",
+            })?;
+        out.truncate(start + written);
+        self.hash(&out[start..])
+    }
+
+    /// Appends the padded last block to `out` and returns the metadata of the
+    /// encrypted file.
+    pub fn finish(mut self, out: &mut Vec<u8>) -> Result<EncryptedFileMetadata, EncryptionError> {
+        let start = out.len();
+        out.resize(start + AES_BLOCK_SIZE_IN_BYTES, 0);
+        let written = self
+            .crypter
+            .finalize(&mut out[start..])
+            .context(OpenSSLSnafu {
+                operation: "encrypting file data with AES-CBC",
+            })?;
+        out.truncate(start + written);
+        self.hash(&out[start..])?;
+
+        let digest = self.hasher.finish().context(OpenSSLSnafu {
+            operation: "calculating SHA-256 digest",
         })?;
+        Ok(EncryptedFileMetadata {
+            encrypted_key: self.encrypted_key,
+            iv: self.iv,
+            material_desc: self.material_desc,
+            digest: BASE64_ENGINE.encode(digest),
+        })
+    }
 
-    // 5. Prepare the metadata for the encrypted file.
-    let material_desc = MaterialDescription {
-        query_id: encryption_material.query_id.clone(),
-        smk_id: encryption_material.smk_id.clone(),
-        key_size: (cipher_suite.key_len * 8).to_string(),
-    };
-
-    let metadata = EncryptedFileMetadata {
-        encrypted_key: BASE64_ENGINE.encode(&encrypted_file_key),
-        iv: BASE64_ENGINE.encode(&iv),
-        material_desc,
-        digest: calculate_digest(&encrypted_data).context(OpenSSLSnafu {
+    fn hash(&mut self, ciphertext: &[u8]) -> Result<(), EncryptionError> {
+        self.hasher.update(ciphertext).context(OpenSSLSnafu {
             operation: "calculating SHA-256 digest",
-        })?,
-    };
+        })
+    }
+}
 
-    Ok(EncryptionResult {
-        data: encrypted_data,
-        metadata,
-    })
+/// Decrypts a downloaded file. With CBC every block depends only on its own
+/// ciphertext and the one before it, so byte ranges of a file can be
+/// decrypted separately and in any order.
+pub struct FileDecryptor {
+    cbc: Cipher,
+    file_key: Vec<u8>,
+    iv: Vec<u8>,
 }
 
-/// Decrypts file data using AES-CBC with PKCS#7 padding.
-pub fn decrypt_file_data(
-    encrypted_data: &[u8],
-    metadata: &EncryptedFileMetadata,
-    encryption_material: &EncryptionMaterial,
-) -> Result<Vec<u8>, EncryptionError> {
-    // 1. Decode master key and select the appropriate cipher suite.
-    let master_key = BASE64_ENGINE
-        .decode(&encryption_material.query_stage_master_key)
-        .context(Base64DecodingSnafu {
-            context: "master key",
-        })?;
-    let cipher_suite = CipherSuite::from_key_len(master_key.len())?;
+impl FileDecryptor {
+    pub fn new(
+        metadata: &EncryptedFileMetadata,
+        encryption_material: &EncryptionMaterial,
+    ) -> Result<Self, EncryptionError> {
+        // 1. Decode master key and select the appropriate cipher suite.
+        let master_key = BASE64_ENGINE
+            .decode(&encryption_material.query_stage_master_key)
+            .context(Base64DecodingSnafu {
+                context: "master key",
+            })?;
+        let cipher_suite = CipherSuite::from_key_len(master_key.len())?;
 
-    // 2. Decode the encrypted file key and IV from metadata.
-    let encrypted_file_key =
-        BASE64_ENGINE
-            .decode(&metadata.encrypted_key)
+        // 2. Decode the encrypted file key and IV from metadata.
+        let encrypted_file_key =
+            BASE64_ENGINE
+                .decode(&metadata.encrypted_key)
+                .context(Base64DecodingSnafu {
+                    context: "encrypted file key",
+                })?;
+        let iv = BASE64_ENGINE
+            .decode(&metadata.iv)
             .context(Base64DecodingSnafu {
-                context: "encrypted file key",
+                context: "initialization vector",
             })?;
-    let iv = BASE64_ENGINE
-        .decode(&metadata.iv)
-        .context(Base64DecodingSnafu {
-            context: "initialization vector",
-        })?;
 
-    // 3. Verify the digest of encrypted data.
-    let calculated_digest = calculate_digest(encrypted_data).context(OpenSSLSnafu {
-        operation: "calculating SHA-256 digest for verification",
-    })?;
-    if calculated_digest != metadata.digest {
-        return DigestMismatchSnafu.fail();
+        // 3. Decrypt the file key using the master key with AES-ECB.
+        let file_key = decrypt(cipher_suite.ecb, &master_key, None, &encrypted_file_key).context(
+            OpenSSLSnafu {
+                operation: "decrypting file key with AES-ECB",
+            },
+        )?;
+
+        Ok(Self {
+            cbc: cipher_suite.cbc,
+            file_key,
+            iv,
+        })
     }
 
-    // 4. Decrypt the file key using the master key with AES-ECB.
-    let file_key = decrypt(cipher_suite.ecb, &master_key, None, &encrypted_file_key).context(
-        OpenSSLSnafu {
-            operation: "decrypting file key with AES-ECB",
-        },
-    )?;
-
-    // 5. Decrypt the file data using the file key and IV with AES-CBC.
-    let decrypted_data =
-        decrypt(cipher_suite.cbc, &file_key, Some(&iv), encrypted_data).context(OpenSSLSnafu {
-            operation: "decrypting file data with AES-CBC",
+    /// Starts decrypting the range that follows `previous_block`, the last
+    /// ciphertext block before it, or the start of the file when `None`. Only
+    /// the range ending the file removes the padding.
+    pub fn range(
+        &self,
+        previous_block: Option<&[u8]>,
+        ends_file: bool,
+    ) -> Result<RangeDecryptor, EncryptionError> {
+        let iv = previous_block.unwrap_or(&self.iv);
+        let mut crypter = Crypter::new(self.cbc, Mode::Decrypt, &self.file_key, Some(iv)).context(
+            OpenSSLSnafu {
+                operation: "initializing AES-CBC decryption",
+            },
+        )?;
+        crypter.pad(ends_file);
+        Ok(RangeDecryptor { crypter })
+    }
+}
+
+/// Decrypts one byte range of a file using AES-CBC.
+pub struct RangeDecryptor {
+    crypter: Crypter,
+}
+
+impl RangeDecryptor {
+    /// Decrypts the next piece of the range, appending the plaintext to `out`.
+    pub fn update(&mut self, input: &[u8], out: &mut Vec<u8>) -> Result<(), EncryptionError> {
+        let start = out.len();
+        out.resize(start + input.len() + AES_BLOCK_SIZE_IN_BYTES, 0);
+        let written = self
+            .crypter
+            .update(input, &mut out[start..])
+            .context(OpenSSLSnafu {
+                operation: "decrypting file data with AES-CBC",
+            })?;
+        out.truncate(start + written);
+        Ok(())
+    }
+
+    /// Appends the rest of the plaintext to `out`, removing the PKCS#7 padding
+    /// at the end of the file.
+    pub fn finish(mut self, out: &mut Vec<u8>) -> Result<(), EncryptionError> {
+        let start = out.len();
+        out.resize(start + AES_BLOCK_SIZE_IN_BYTES, 0);
+        let written = self
+            .crypter
+            .finalize(&mut out[start..])
+            .context(OpenSSLSnafu {
+                operation: "decrypting file data with AES-CBC",
+            })?;
+        out.truncate(start + written);
+        Ok(())
+    }
+}
+
+/// Checks the SHA-256 digest of the ciphertext, fed in file order.
+pub struct DigestVerifier {
+    hasher: Hasher,
+    expected: String,
+}
+
+impl DigestVerifier {
+    pub fn new(metadata: &EncryptedFileMetadata) -> Result<Self, EncryptionError> {
+        Ok(Self {
+            hasher: Hasher::new(MessageDigest::sha256()).context(OpenSSLSnafu {
+                operation: "initializing SHA-256 digest for verification",
+            })?,
+            expected: metadata.digest.clone(),
+        })
+    }
+
+    pub fn update(&mut self, ciphertext: &[u8]) -> Result<(), EncryptionError> {
+        self.hasher.update(ciphertext).context(OpenSSLSnafu {
+            operation: "calculating SHA-256 digest for verification",
+        })
+    }
+
+    pub fn verify(mut self) -> Result<(), EncryptionError> {
+        let digest = self.hasher.finish().context(OpenSSLSnafu {
+            operation: "calculating SHA-256 digest for verification",
         })?;
+        if BASE64_ENGINE.encode(digest) != self.expected {
+            return DigestMismatchSnafu.fail();
+        }
+        Ok(())
+    }
+}
 
+/// Verifies and decrypts a whole file in memory.
+#[cfg(test)]
+pub fn decrypt_file_data(
+    encrypted_data: &[u8],
+    metadata: &EncryptedFileMetadata,
+    encryption_material: &EncryptionMaterial,
+) -> Result<Vec<u8>, EncryptionError> {
+    let mut verifier = DigestVerifier::new(metadata)?;
+    verifier.update(encrypted_data)?;
+    verifier.verify()?;
+
+    let mut decryptor = FileDecryptor::new(metadata, encryption_material)?.range(None, true)?;
+    let mut decrypted_data = Vec::with_capacity(encrypted_data.len());
+    decryptor.update(encrypted_data, &mut decrypted_data)?;
+    decryptor.finish(&mut decrypted_data)?;
     Ok(decrypted_data)
 }
 
@@ -154,12 +304,6 @@ fn generate_random_bytes(size: usize) -> Result<Vec<u8>, OpenSslErrorStack> {
     Ok(buffer)
 }
 
-/// Computes the SHA-256 digest of the data and returns it as a Base64 string.
-fn calculate_digest(data: &[u8]) -> Result<String, OpenSslErrorStack> {
-    let digest = hash(MessageDigest::sha256(), data)?;
-    Ok(BASE64_ENGINE.encode(digest))
-}
-
 #[derive(Snafu, Debug)]
 pub enum EncryptionError {
     #[snafu(display("OpenSSL cryptographic operation failed during {operation}"))]
@@ -188,3 +332,71 @@ pub enum EncryptionError {
         location: Location,
     },
 }
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn encrypts_in_pieces_what_decrypts_whole() {
+        let encryption_material = EncryptionMaterial {
+            query_stage_master_key: BASE64_ENGINE.encode([7u8; AES_256_KEY_SIZE_IN_BYTES]),
+            query_id: "query".to_string(),
+            smk_id: "1".to_string(),
+        };
+        let data: Vec<u8> = (0..100_000u32).map(|i| (i % 251) as u8).collect();
+
+        let mut encryptor = FileEncryptor::new(&encryption_material).unwrap();
+        let mut encrypted = Vec::new();
+        for piece in data.chunks(4_001) {
+            encryptor.update(piece, &mut encrypted).unwrap();
+        }
+        let metadata = encryptor.finish(&mut encrypted).unwrap();
+
+        // PKCS#7 always adds padding, a whole block when the data is aligned
+        assert_eq!(encrypted.len(), (data.len() / 16 + 1) * 16);
+        assert_eq!(
+            decrypt_file_data(&encrypted, &metadata, &encryption_material).unwrap(),
+            data
+        );
+    }
+
+    #[test]
+    fn decrypts_ranges_separately() {
+        let encryption_material = EncryptionMaterial {
+            query_stage_master_key: BASE64_ENGINE.encode([5u8; AES_128_KEY_SIZE_IN_BYTES]),
+            query_id: "query".to_string(),
+            smk_id: "1".to_string(),
+        };
+        let data: Vec<u8> = (0..10_000u32).map(|i| (i % 241) as u8).collect();
+        let mut encryptor = FileEncryptor::new(&encryption_material).unwrap();
+        let mut encrypted = Vec::new();
+        encryptor.update(&data, &mut encrypted).unwrap();
+        let metadata = encryptor.finish(&mut encrypted).unwrap();
+
+        let decryptor = FileDecryptor::new(&metadata, &encryption_material).unwrap();
+        let mut pieces = Vec::new();
+        // Decrypted last to first, each range seeded with the block before it
+        let ranges = [(0, 4096), (4096, 8192), (8192, encrypted.len())];
+        for &(start, end) in ranges.iter().rev() {
+            let previous_block = (start > 0).then(|| &encrypted[start - 16..start]);
+            let mut range = decryptor
+                .range(previous_block, end == encrypted.len())
+                .unwrap();
+            let mut plaintext = Vec::new();
+            range
+                .update(&encrypted[start..end], &mut plaintext)
+                .unwrap();
+            range.finish(&mut plaintext).unwrap();
+            pieces.push(plaintext);
+        }
+        pieces.reverse();
+        assert_eq!(pieces.concat(), data);
+
+        let mut verifier = DigestVerifier::new(&metadata).unwrap();
+        for &(start, end) in &ranges {
+            verifier.update(&encrypted[start..end]).unwrap();
+        }
+        verifier.verify().unwrap();
+    }
+}
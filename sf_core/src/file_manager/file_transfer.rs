@@ -1,36 +1,58 @@
-use super::types::{EncryptedFileMetadata, EncryptionResult, MaterialDescription, StageInfo};
+use super::multipart::MultipartConfig;
+use super::types::{
+    EncryptedBody, EncryptedFileMetadata, EncryptedUpload, MaterialDescription, StageInfo,
+};
 use snafu::{Location, OptionExt, ResultExt, Snafu};
+use std::path::{Path, PathBuf};
+use std::sync::Arc;
+use std::time::Duration;
+use tokio::task::JoinSet;
 
 // AWS SDK imports
-use aws_config::{BehaviorVersion, Region};
-use aws_credential_types::Credentials;
+use aws_sdk_s3::Client as S3Client;
 use aws_sdk_s3::error::SdkError;
-use aws_sdk_s3::{Client as S3Client, primitives::ByteStream};
+use aws_sdk_s3::operation::get_object::GetObjectOutput;
+use aws_sdk_s3::primitives::{ByteStream, Length};
+use aws_sdk_s3::types::{CompletedMultipartUpload, CompletedPart};
+use bytes::Bytes;
 
-const SNOWFLAKE_UPLOAD_PROVIDER: &str = "snowflake-upload";
-const SNOWFLAKE_DOWNLOAD_PROVIDER: &str = "snowflake-download";
 const CONTENT_TYPE_OCTET_STREAM: &str = "application/octet-stream";
-
-// TODO: streaming instead of loading the whole file into memory
+const PART_UPLOAD_ATTEMPTS: u32 = 3;
+const PART_RETRY_BASE_DELAY: Duration = Duration::from_millis(500);
 
 /// Uploads a file to S3, skipping if it already exists and `overwrite` is false.
 pub async fn upload_to_s3_or_skip(
-    encryption_result: EncryptionResult,
+    encrypted_upload: EncryptedUpload,
+    s3_client: &S3Client,
     stage_info: &StageInfo,
     filename: &str,
     overwrite: bool,
+    multipart: &MultipartConfig,
 ) -> Result<String, UploadFileError> {
     // Check if the file already exists in S3
-    let s3_client = create_s3_client(stage_info, SNOWFLAKE_UPLOAD_PROVIDER).await;
     let s3_key = format!("{}{filename}", stage_info.key_prefix);
 
-    if !overwrite && check_if_file_exists(&s3_client, stage_info, &s3_key).await? {
+    if !overwrite && check_if_file_exists(s3_client, stage_info, &s3_key).await? {
         tracing::info!("File already exists in S3: {}", s3_key);
         return Ok("SKIPPED".to_string());
     }
 
     // Proceed with upload if the file does not exist or overwrite is true
-    upload_to_s3(encryption_result, &s3_client, stage_info, &s3_key).await?;
+    if multipart.should_split(encrypted_upload.size)
+        && let EncryptedBody::File(file) = &encrypted_upload.body
+    {
+        upload_multipart_to_s3(
+            s3_client,
+            stage_info,
+            &s3_key,
+            file.path(),
+            &encrypted_upload,
+            multipart,
+        )
+        .await?;
+    } else {
+        upload_to_s3(encrypted_upload, s3_client, stage_info, &s3_key).await?;
+    }
     Ok("UPLOADED".to_string())
 }
 
@@ -54,24 +76,38 @@ async fn check_if_file_exists(
 }
 
 async fn upload_to_s3(
-    encryption_result: EncryptionResult,
+    encrypted_upload: EncryptedUpload,
     s3_client: &S3Client,
     stage_info: &StageInfo,
     s3_key: &str,
 ) -> Result<(), UploadFileError> {
     // Serialize encryption metadata
-    let mat_desc = serde_json::to_string(&encryption_result.metadata.material_desc)
-        .context(SerializationSnafu)?;
+    let metadata = &encrypted_upload.metadata;
+    let mat_desc = serde_json::to_string(&metadata.material_desc).context(SerializationSnafu)?;
+
+    // A spilled file is read as the request is sent, and again on retries,
+    // so it is kept until the upload is done
+    let (body, _spilled_file) = match encrypted_upload.body {
+        EncryptedBody::Memory(data) => (ByteStream::from(data), None),
+        EncryptedBody::File(file) => {
+            let body = ByteStream::from_path(file.path())
+                .await
+                .map_err(std::io::Error::other)
+                .context(BodySnafu)?;
+            (body, Some(file))
+        }
+    };
 
     let put_object_request = s3_client
         .put_object()
         .bucket(stage_info.bucket.clone())
         .key(s3_key)
-        .body(ByteStream::from(encryption_result.data))
+        .body(body)
+        .content_length(encrypted_upload.size as i64)
         .content_type(CONTENT_TYPE_OCTET_STREAM)
-        .metadata("sfc-digest", &encryption_result.metadata.digest)
-        .metadata("x-amz-iv", &encryption_result.metadata.iv)
-        .metadata("x-amz-key", &encryption_result.metadata.encrypted_key)
+        .metadata("sfc-digest", &metadata.digest)
+        .metadata("x-amz-iv", &metadata.iv)
+        .metadata("x-amz-key", &metadata.encrypted_key)
         .metadata("x-amz-matdesc", mat_desc);
 
     tracing::trace!("PUT object request: {:?}", put_object_request);
@@ -88,23 +124,203 @@ async fn upload_to_s3(
     Ok(())
 }
 
-pub async fn download_from_s3(
+/// Uploads a spilled encrypted file in parts, `multipart.concurrency` at a
+/// time. The object gets the same metadata as with a single PUT, and the
+/// digest still covers the whole encrypted file.
+async fn upload_multipart_to_s3(
+    s3_client: &S3Client,
+    stage_info: &StageInfo,
+    s3_key: &str,
+    path: &Path,
+    encrypted_upload: &EncryptedUpload,
+    multipart: &MultipartConfig,
+) -> Result<(), UploadFileError> {
+    let metadata = &encrypted_upload.metadata;
+    let mat_desc = serde_json::to_string(&metadata.material_desc).context(SerializationSnafu)?;
+
+    let created = s3_client
+        .create_multipart_upload()
+        .bucket(stage_info.bucket.clone())
+        .key(s3_key)
+        .content_type(CONTENT_TYPE_OCTET_STREAM)
+        .metadata("sfc-digest", &metadata.digest)
+        .metadata("x-amz-iv", &metadata.iv)
+        .metadata("x-amz-key", &metadata.encrypted_key)
+        .metadata("x-amz-matdesc", mat_desc)
+        .send()
+        .await
+        .map_err(aws_sdk_s3::Error::from)
+        .context(S3UploadSnafu)?;
+    let upload_id = created.upload_id().context(MissingUploadIdSnafu)?;
+
+    let uploader = Arc::new(PartUploader {
+        s3_client: s3_client.clone(),
+        bucket: stage_info.bucket.clone(),
+        s3_key: s3_key.to_string(),
+        upload_id: upload_id.to_string(),
+        path: path.to_path_buf(),
+    });
+    let parts = match upload_parts(&uploader, encrypted_upload.size, multipart).await {
+        Ok(parts) => parts,
+        Err(e) => {
+            // Stored parts are kept, and billed, until the upload is aborted
+            if let Err(abort_error) = s3_client
+                .abort_multipart_upload()
+                .bucket(stage_info.bucket.clone())
+                .key(s3_key)
+                .upload_id(upload_id)
+                .send()
+                .await
+            {
+                tracing::warn!("Failed to abort multipart upload of {s3_key}: {abort_error:?}");
+            }
+            return Err(e);
+        }
+    };
+
+    let result = s3_client
+        .complete_multipart_upload()
+        .bucket(stage_info.bucket.clone())
+        .key(s3_key)
+        .upload_id(upload_id)
+        .multipart_upload(
+            CompletedMultipartUpload::builder()
+                .set_parts(Some(parts))
+                .build(),
+        )
+        .send()
+        .await
+        .map_err(aws_sdk_s3::Error::from)
+        .context(S3UploadSnafu)?;
+
+    tracing::debug!("S3 multipart upload result: {:?}", result);
+
+    Ok(())
+}
+
+async fn upload_parts(
+    uploader: &Arc<PartUploader>,
+    size: u64,
+    multipart: &MultipartConfig,
+) -> Result<Vec<CompletedPart>, UploadFileError> {
+    let concurrency = multipart.concurrency.max(1);
+    let ranges = multipart.part_ranges(size);
+    let mut parts = Vec::with_capacity(ranges.len());
+    // Dropping the set on error aborts the parts still uploading
+    let mut uploads = JoinSet::new();
+
+    for (index, (offset, length)) in ranges.into_iter().enumerate() {
+        if uploads.len() == concurrency {
+            parts.push(join_part(&mut uploads).await?);
+        }
+        let uploader = uploader.clone();
+        let part_number = index as i32 + 1;
+        uploads.spawn(async move { uploader.upload(part_number, offset, length).await });
+    }
+    while !uploads.is_empty() {
+        parts.push(join_part(&mut uploads).await?);
+    }
+
+    parts.sort_by_key(|part| part.part_number());
+    Ok(parts)
+}
+
+async fn join_part(
+    uploads: &mut JoinSet<Result<CompletedPart, UploadFileError>>,
+) -> Result<CompletedPart, UploadFileError> {
+    uploads
+        .join_next()
+        .await
+        .expect("join_part is only called with parts uploading")
+        .context(PartTaskSnafu)?
+}
+
+struct PartUploader {
+    s3_client: S3Client,
+    bucket: String,
+    s3_key: String,
+    upload_id: String,
+    path: PathBuf,
+}
+
+impl PartUploader {
+    /// Uploads one part read from the file, retrying only this part when it
+    /// fails so the parts already stored are kept.
+    async fn upload(
+        &self,
+        part_number: i32,
+        offset: u64,
+        length: u64,
+    ) -> Result<CompletedPart, UploadFileError> {
+        let mut attempt = 1;
+        loop {
+            let body = ByteStream::read_from()
+                .path(&self.path)
+                .offset(offset)
+                .length(Length::Exact(length))
+                .build()
+                .await
+                .map_err(std::io::Error::other)
+                .context(BodySnafu)?;
+            let result = self
+                .s3_client
+                .upload_part()
+                .bucket(self.bucket.clone())
+                .key(&self.s3_key)
+                .upload_id(&self.upload_id)
+                .part_number(part_number)
+                .content_length(length as i64)
+                .body(body)
+                .send()
+                .await;
+            match result {
+                Ok(output) => {
+                    return Ok(CompletedPart::builder()
+                        .part_number(part_number)
+                        .set_e_tag(output.e_tag().map(str::to_string))
+                        .build());
+                }
+                Err(e) if attempt < PART_UPLOAD_ATTEMPTS => {
+                    tracing::warn!(
+                        "Upload of part {part_number} of {} failed, retrying: {e:?}",
+                        self.s3_key
+                    );
+                    tokio::time::sleep(PART_RETRY_BASE_DELAY * 2u32.pow(attempt - 1)).await;
+                    attempt += 1;
+                }
+                Err(e) => return Err(aws_sdk_s3::Error::from(e)).context(S3UploadSnafu),
+            }
+        }
+    }
+}
+
+/// Requests `length` bytes of the file starting at `offset`. With `e_tag`
+/// set, S3 rejects the request if the file has changed since.
+pub async fn get_object_range(
+    s3_client: &S3Client,
     stage_info: &StageInfo,
     filename: &str,
-) -> Result<(Vec<u8>, EncryptedFileMetadata), DownloadFileError> {
-    let s3_client = create_s3_client(stage_info, SNOWFLAKE_DOWNLOAD_PROVIDER).await;
+    offset: u64,
+    length: u64,
+    e_tag: Option<&str>,
+) -> Result<GetObjectOutput, DownloadFileError> {
     let s3_key = format!("{}{filename}", stage_info.key_prefix);
-
-    // Download from S3
-    let response = s3_client
+    s3_client
         .get_object()
         .bucket(stage_info.bucket.clone())
         .key(&s3_key)
+        .range(format!("bytes={offset}-{}", offset + length - 1))
+        .set_if_match(e_tag.map(str::to_string))
         .send()
         .await
         .map_err(aws_sdk_s3::Error::from)
-        .context(S3DownloadSnafu)?;
+        .context(S3DownloadSnafu)
+}
 
+/// Reads the encryption metadata stored with the file.
+pub fn file_metadata(
+    response: &GetObjectOutput,
+) -> Result<EncryptedFileMetadata, DownloadFileError> {
     // Extract metadata from S3 response and construct the metadata structure directly
     let metadata_map = response.metadata().context(MissingFileMetadataSnafu {
         field: "All fields".to_string(),
@@ -120,7 +336,7 @@ pub async fn download_from_s3(
         serde_json::from_str(mat_desc_str).context(DeserializationSnafu)?;
 
     // Construct the metadata structure directly without intermediate variables
-    let file_metadata = EncryptedFileMetadata {
+    Ok(EncryptedFileMetadata {
         encrypted_key: metadata_map
             .get("x-amz-key")
             .context(MissingFileMetadataSnafu {
@@ -140,36 +356,25 @@ pub async fn download_from_s3(
                 field: "sfc-digest".to_string(),
             })?
             .to_owned(),
-    };
-
-    // Read the encrypted data from the response body
-    let encrypted_data = response
-        .body
-        .collect()
-        .await
-        .context(ByteStreamSnafu)?
-        .into_bytes()
-        .to_vec();
-
-    Ok((encrypted_data, file_metadata))
+    })
 }
 
-async fn create_s3_client(stage_info: &StageInfo, provider_name: &'static str) -> S3Client {
-    let credentials = Credentials::new(
-        &stage_info.creds.aws_key_id,
-        &stage_info.creds.aws_secret_key,
-        Some(stage_info.creds.aws_token.clone()),
-        None,
-        provider_name,
-    );
+/// Size of the whole file, from the `Content-Range` of a ranged response.
+pub fn object_size(response: &GetObjectOutput) -> Result<u64, DownloadFileError> {
+    let content_range = response.content_range().context(MissingFileMetadataSnafu {
+        field: "Content-Range".to_string(),
+    })?;
+    parse_object_size(content_range).context(InvalidContentRangeSnafu { content_range })
+}
 
-    let config = aws_config::defaults(BehaviorVersion::latest())
-        .credentials_provider(credentials)
-        .region(Region::new(stage_info.region.clone()))
-        .load()
-        .await;
+// "bytes 0-1023/146515"
+fn parse_object_size(content_range: &str) -> Option<u64> {
+    content_range.rsplit_once('/')?.1.parse().ok()
+}
 
-    S3Client::new(&config)
+/// Returns the next piece of a response body as it arrives.
+pub async fn next_chunk(body: &mut ByteStream) -> Result<Option<Bytes>, DownloadFileError> {
+    body.try_next().await.context(ByteStreamSnafu)
 }
 
 #[derive(Snafu, Debug)]
@@ -188,6 +393,23 @@ pub enum UploadFileError {
         #[snafu(implicit)]
         location: Location,
     },
+    #[snafu(display("S3 did not return an upload id for the multipart upload"))]
+    MissingUploadId {
+        #[snafu(implicit)]
+        location: Location,
+    },
+    #[snafu(display("Part upload task failed"))]
+    PartTask {
+        source: tokio::task::JoinError,
+        #[snafu(implicit)]
+        location: Location,
+    },
+    #[snafu(display("Failed to open the encrypted file for upload"))]
+    Body {
+        source: std::io::Error,
+        #[snafu(implicit)]
+        location: Location,
+    },
     #[snafu(display("Failed to serialize metadata during file upload"))]
     Serialization {
         source: serde_json::Error,
@@ -217,6 +439,12 @@ pub enum DownloadFileError {
         #[snafu(implicit)]
         location: Location,
     },
+    #[snafu(display("Invalid Content-Range in S3 response: {content_range}"))]
+    InvalidContentRange {
+        content_range: String,
+        #[snafu(implicit)]
+        location: Location,
+    },
     #[snafu(display("Failed to read byte stream from S3"))]
     ByteStream {
         source: aws_sdk_s3::primitives::ByteStreamError,
@@ -224,3 +452,15 @@ pub enum DownloadFileError {
         location: Location,
     },
 }
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn reads_object_size_from_content_range() {
+        assert_eq!(parse_object_size("bytes 0-1023/146515"), Some(146515));
+        assert_eq!(parse_object_size("bytes 0-1023/*"), None);
+        assert_eq!(parse_object_size("bytes 0-1023"), None);
+    }
+}
@@ -1,28 +1,52 @@
 mod encryption;
 mod file_transfer;
 
+mod multipart;
 mod path_expansion;
+mod ranged_download;
+mod s3_clients;
 pub mod types;
 
+pub use self::multipart::{
+    MULTIPART_CONCURRENCY_OPTION, MULTIPART_PART_SIZE_OPTION, MULTIPART_THRESHOLD_OPTION,
+    MultipartConfig,
+};
+pub use self::s3_clients::s3_client;
 pub use self::types::*;
 
-use crate::compression::{CompressionError, compress_data};
+use crate::compression::{CompressionError, GzipStreamEncoder};
 use crate::compression_types::{CompressionType, CompressionTypeError, try_guess_compression_type};
-use encryption::{EncryptionError, decrypt_file_data, encrypt_file_data};
-use file_transfer::{DownloadFileError, UploadFileError, download_from_s3, upload_to_s3_or_skip};
+use aws_sdk_s3::Client as S3Client;
+use encryption::{EncryptionError, FileEncryptor};
+use file_transfer::{DownloadFileError, UploadFileError, upload_to_s3_or_skip};
 use path_expansion::{PathExpansionError, expand_filenames};
+use ranged_download::download_to_file;
 use snafu::{Location, ResultExt, Snafu};
 use std::fs::File;
 use std::io::{Read, Write};
 use std::path::Path;
+use tokio::task::JoinSet;
 
+// Source bytes read, compressed and encrypted at a time. Encrypted files up to
+// this size are uploaded from memory, larger ones from a temporary file.
+const UPLOAD_BLOCK_SIZE: usize = 8 * 1024 * 1024;
+
+/// Uploads the files matching the pattern, `data.parallel` at a time, all
+/// through one S3 client. Results keep the order of the expanded file names.
 pub async fn upload_files(data: &UploadData) -> Result<Vec<UploadResult>, FileManagerError> {
     let file_locations =
         expand_filenames(&data.src_location_pattern).context(PathExpansionSnafu)?;
-    let mut results = Vec::new();
-
-    for file_location in file_locations {
-        // TODO: We could experiment with references here for performance after we have working parallel implementation
+    let s3_client = s3_client(&data.stage_info).await;
+    let parallel = data.parallel.max(1);
+    let mut results: Vec<Option<UploadResult>> = vec![None; file_locations.len()];
+    // Dropping the set on error aborts the uploads still running
+    let mut uploads = JoinSet::new();
+
+    for (index, file_location) in file_locations.into_iter().enumerate() {
+        if uploads.len() == parallel {
+            let (index, result) = join_next(&mut uploads).await?;
+            results[index] = Some(result);
+        }
 
         let single_upload_data = SingleUploadData {
             file_path: file_location.path,
@@ -32,28 +56,56 @@ pub async fn upload_files(data: &UploadData) -> Result<Vec<UploadResult>, FileMa
             auto_compress: data.auto_compress,
             source_compression: data.source_compression.clone(),
             overwrite: data.overwrite,
+            multipart: data.multipart.clone(),
         };
-
-        let result = upload_single_file(single_upload_data).await?;
-        results.push(result);
+        let s3_client = s3_client.clone();
+        uploads.spawn(async move {
+            (
+                index,
+                upload_single_file(single_upload_data, &s3_client).await,
+            )
+        });
+    }
+    while !uploads.is_empty() {
+        let (index, result) = join_next(&mut uploads).await?;
+        results[index] = Some(result);
     }
 
-    Ok(results)
+    Ok(results.into_iter().flatten().collect())
 }
 
-pub async fn upload_single_file(data: SingleUploadData) -> Result<UploadResult, FileManagerError> {
-    let mut input_file = File::open(&data.file_path).context(IoSnafu)?;
-
-    let mut file_buffer = Vec::new();
-    input_file.read_to_end(&mut file_buffer).context(IoSnafu)?;
+async fn join_next<T: 'static>(
+    tasks: &mut JoinSet<(usize, Result<T, FileManagerError>)>,
+) -> Result<(usize, T), FileManagerError> {
+    let (index, result) = tasks
+        .join_next()
+        .await
+        .expect("join_next is only called with tasks running")
+        .context(TaskSnafu)?;
+    Ok((index, result?))
+}
 
-    let (encryption_result, file_metadata) = preprocess_file_before_upload(file_buffer, &data)?;
+pub async fn upload_single_file(
+    data: SingleUploadData,
+    s3_client: &S3Client,
+) -> Result<UploadResult, FileManagerError> {
+    // Reading, compressing and encrypting block, so they run off the runtime
+    // threads and other files keep uploading meanwhile
+    let (data, prepared) = tokio::task::spawn_blocking(move || {
+        let prepared = prepare_upload(&data);
+        (data, prepared)
+    })
+    .await
+    .context(TaskSnafu)?;
+    let (encrypted_upload, file_metadata) = prepared?;
 
     let status = upload_to_s3_or_skip(
-        encryption_result,
+        encrypted_upload,
+        s3_client,
         &data.stage_info,
         file_metadata.target.as_str(),
         data.overwrite,
+        &data.multipart,
     )
     .await
     .context(S3UploadSnafu)?;
@@ -79,16 +131,20 @@ pub async fn upload_single_file(data: SingleUploadData) -> Result<UploadResult,
     })
 }
 
-/// Sets file metadata, compresses the file if needed, and encrypts the data before uploading it to S3.
-fn preprocess_file_before_upload(
-    mut file_buffer: Vec<u8>,
+/// Sets file metadata, then reads the file block by block, compressing it if
+/// needed and encrypting it, so only a few blocks are held in memory at once.
+fn prepare_upload(
     data: &SingleUploadData,
-) -> Result<(EncryptionResult, UploadMetadata), FileManagerError> {
-    let source_size = file_buffer.len() as i64;
+) -> Result<(EncryptedUpload, UploadMetadata), FileManagerError> {
+    let mut input_file = File::open(&data.file_path).context(IoSnafu)?;
+    let mut block = vec![0; UPLOAD_BLOCK_SIZE];
+    let mut block_len = read_block(&mut input_file, &mut block).context(IoSnafu)?;
+    let mut source_size = block_len as i64;
 
+    // The first block is enough to recognize compressed formats
     let source_compression = get_source_compression(
         data.filename.as_str(),
-        file_buffer.as_slice(),
+        &block[..block_len],
         &data.source_compression,
     )
     .context(CompressionTypeSnafu)?;
@@ -97,33 +153,103 @@ fn preprocess_file_before_upload(
     let mut target = data.filename.clone();
 
     // Compress the data if needed
-    let target_compression = if data.auto_compress && source_compression == CompressionType::None {
-        file_buffer = compress_data(file_buffer).context(CompressionSnafu)?;
-        target = format!("{}.gz", data.filename);
-        CompressionType::Gzip
-    } else {
-        source_compression.clone()
-    };
+    let (mut gzip, target_compression) =
+        if data.auto_compress && source_compression == CompressionType::None {
+            target = format!("{}.gz", data.filename);
+            (Some(GzipStreamEncoder::new()), CompressionType::Gzip)
+        } else {
+            (None, source_compression.clone())
+        };
 
     // Encrypt the data
-    let encryption_result = encrypt_file_data(file_buffer.as_slice(), &data.encryption_material)
-        .context(EncryptionSnafu)?;
-
-    let target_size = encryption_result.data.len() as i64;
+    let mut encryptor = FileEncryptor::new(&data.encryption_material).context(EncryptionSnafu)?;
+    let mut body = EncryptedBody::Memory(Vec::new());
+    let mut encrypted = Vec::new();
+    while block_len > 0 {
+        let compressed;
+        let plain = match gzip.as_mut() {
+            Some(gzip) => {
+                compressed = gzip.push(&block[..block_len]).context(CompressionSnafu)?;
+                &compressed[..]
+            }
+            None => &block[..block_len],
+        };
+        encryptor
+            .update(plain, &mut encrypted)
+            .context(EncryptionSnafu)?;
+        body.append(&encrypted).context(IoSnafu)?;
+        encrypted.clear();
+
+        block_len = read_block(&mut input_file, &mut block).context(IoSnafu)?;
+        source_size += block_len as i64;
+    }
+    if let Some(gzip) = gzip {
+        let compressed = gzip.finish().context(CompressionSnafu)?;
+        encryptor
+            .update(&compressed, &mut encrypted)
+            .context(EncryptionSnafu)?;
+    }
+    let metadata = encryptor.finish(&mut encrypted).context(EncryptionSnafu)?;
+    body.append(&encrypted).context(IoSnafu)?;
 
+    let size = body.len().context(IoSnafu)?;
     Ok((
-        encryption_result,
+        EncryptedUpload {
+            body,
+            size,
+            metadata,
+        },
         UploadMetadata {
             source,
             target,
             source_size,
             source_compression,
-            target_size,
+            target_size: size as i64,
             target_compression,
         },
     ))
 }
 
+/// Fills `block` unless the file ends first, returning the number of bytes read.
+fn read_block(file: &mut File, block: &mut [u8]) -> std::io::Result<usize> {
+    let mut filled = 0;
+    while filled < block.len() {
+        match file.read(&mut block[filled..]) {
+            Ok(0) => break,
+            Ok(read) => filled += read,
+            Err(e) if e.kind() == std::io::ErrorKind::Interrupted => {}
+            Err(e) => return Err(e),
+        }
+    }
+    Ok(filled)
+}
+
+impl EncryptedBody {
+    fn append(&mut self, data: &[u8]) -> std::io::Result<()> {
+        match self {
+            EncryptedBody::File(file) => file.write_all(data),
+            EncryptedBody::Memory(buffer) if buffer.len() + data.len() <= UPLOAD_BLOCK_SIZE => {
+                buffer.extend_from_slice(data);
+                Ok(())
+            }
+            EncryptedBody::Memory(buffer) => {
+                let mut file = tempfile::Builder::new().prefix("sf_put_").tempfile()?;
+                file.write_all(buffer)?;
+                file.write_all(data)?;
+                *self = EncryptedBody::File(file);
+                Ok(())
+            }
+        }
+    }
+
+    fn len(&self) -> std::io::Result<u64> {
+        match self {
+            EncryptedBody::Memory(buffer) => Ok(buffer.len() as u64),
+            EncryptedBody::File(file) => Ok(file.as_file().metadata()?.len()),
+        }
+    }
+}
+
 /// Uses user-specified compression type or auto-detects the compression type based on the file name and content.
 fn get_source_compression(
     filename: &str,
@@ -142,62 +268,78 @@ fn get_source_compression(
     }
 }
 
+/// Downloads the files, `data.parallel` at a time, all through one S3
+/// client. Results keep the order of `src_locations`.
 pub async fn download_files(
     mut data: DownloadData,
 ) -> Result<Vec<DownloadResult>, FileManagerError> {
-    let mut results = Vec::new();
+    let s3_client = s3_client(&data.stage_info).await;
+    let parallel = data.parallel.max(1);
+    let mut results: Vec<Option<DownloadResult>> = vec![None; data.src_locations.len()];
+    // Dropping the set on error aborts the downloads still running
+    let mut downloads = JoinSet::new();
 
-    for (file_location, encryption_material) in data
+    for (index, (file_location, encryption_material)) in data
         .src_locations
         .drain(..)
         .zip(data.encryption_materials.drain(..))
+        .enumerate()
     {
+        if downloads.len() == parallel {
+            let (index, result) = join_next(&mut downloads).await?;
+            results[index] = Some(result);
+        }
+
         let single_download_data = SingleDownloadData {
             src_location: file_location,
             local_location: data.local_location.clone(),
             stage_info: data.stage_info.clone(),
             encryption_material,
         };
-
-        let result = download_single_file(single_download_data).await?;
-        results.push(result);
+        let s3_client = s3_client.clone();
+        downloads.spawn(async move {
+            (
+                index,
+                download_single_file(single_download_data, &s3_client).await,
+            )
+        });
+    }
+    while !downloads.is_empty() {
+        let (index, result) = join_next(&mut downloads).await?;
+        results[index] = Some(result);
     }
 
-    Ok(results)
+    Ok(results.into_iter().flatten().collect())
 }
 
 pub async fn download_single_file(
     data: SingleDownloadData,
+    s3_client: &S3Client,
 ) -> Result<DownloadResult, FileManagerError> {
-    // Download encrypted data and metadata from S3
-    let (encrypted_data, file_metadata) =
-        download_from_s3(&data.stage_info, data.src_location.as_str())
-            .await
-            .context(S3DownloadSnafu)?;
-
-    // Decrypt the data (this gives us the compressed data)
-    let compressed_data =
-        decrypt_file_data(&encrypted_data, &file_metadata, &data.encryption_material)
-            .context(DecryptionSnafu)?;
-
     // Create the full output path: local_location/src_location
     let output_path = Path::new(&data.local_location).join(&data.src_location);
 
-    // Save the compressed data to the constructed path
-    let mut output_file = File::create(&output_path).context(IoSnafu)?;
-    output_file.write_all(&compressed_data).context(IoSnafu)?;
+    // Download, decrypt and save the data (this gives us the compressed data)
+    let size = download_to_file(
+        s3_client,
+        &data.stage_info,
+        data.src_location.as_str(),
+        &output_path,
+        &data.encryption_material,
+    )
+    .await?;
 
     tracing::info!(
         "File successfully downloaded and decrypted, saved to '{}' ({} bytes)",
         output_path.display(),
-        compressed_data.len()
+        size
     );
 
     // TODO: Right now "DOWNLOADED" is hardcoded, because any error in the download process will result in an error before this point.
     // We should adjust this after we have more tests in different wrappers to ensure error handling is consistent.
     Ok(DownloadResult {
         file: data.src_location,
-        size: compressed_data.len() as i64,
+        size: size as i64,
         status: "DOWNLOADED".to_string(),
         message: "".to_string(),
     })
@@ -248,6 +390,12 @@ pub enum FileManagerError {
         #[snafu(implicit)]
         location: Location,
     },
+    #[snafu(display("File transfer task failed"))]
+    Task {
+        source: tokio::task::JoinError,
+        #[snafu(implicit)]
+        location: Location,
+    },
     #[snafu(display("Failed to get compression type"))]
     CompressionType {
         source: CompressionTypeError,
@@ -256,3 +404,79 @@ pub enum FileManagerError {
         backtrace: snafu::Backtrace,
     },
 }
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use base64::{Engine, engine::general_purpose::STANDARD as BASE64_ENGINE};
+    use encryption::decrypt_file_data;
+
+    fn upload_data(file: &tempfile::NamedTempFile, auto_compress: bool) -> SingleUploadData {
+        SingleUploadData {
+            file_path: file.path().to_str().unwrap().to_string(),
+            filename: "data.bin".to_string(),
+            stage_info: StageInfo {
+                bucket: "bucket".to_string(),
+                key_prefix: "prefix/".to_string(),
+                region: "us-west-2".to_string(),
+                creds: Credentials {
+                    aws_key_id: "key".to_string(),
+                    aws_secret_key: "secret".to_string(),
+                    aws_token: "token".to_string(),
+                },
+            },
+            encryption_material: EncryptionMaterial {
+                query_stage_master_key: BASE64_ENGINE.encode([3u8; 16]),
+                query_id: "query".to_string(),
+                smk_id: "1".to_string(),
+            },
+            auto_compress,
+            source_compression: SourceCompressionParam::None,
+            overwrite: true,
+            multipart: MultipartConfig::default(),
+        }
+    }
+
+    fn decrypted(upload: &EncryptedUpload, data: &SingleUploadData) -> Vec<u8> {
+        let encrypted = match &upload.body {
+            EncryptedBody::Memory(buffer) => buffer.clone(),
+            EncryptedBody::File(file) => std::fs::read(file.path()).unwrap(),
+        };
+        assert_eq!(encrypted.len() as u64, upload.size);
+        decrypt_file_data(&encrypted, &upload.metadata, &data.encryption_material).unwrap()
+    }
+
+    #[test]
+    fn prepares_files_larger_than_a_block_through_a_temporary_file() {
+        let content: Vec<u8> = (0..UPLOAD_BLOCK_SIZE + 1000)
+            .map(|i| (i * 31 % 253) as u8)
+            .collect();
+        let mut file = tempfile::NamedTempFile::new().unwrap();
+        file.write_all(&content).unwrap();
+        let data = upload_data(&file, false);
+
+        let (upload, metadata) = prepare_upload(&data).unwrap();
+
+        assert!(matches!(upload.body, EncryptedBody::File(_)));
+        assert_eq!(metadata.source_size, content.len() as i64);
+        assert_eq!(metadata.target_size, upload.size as i64);
+        assert_eq!(decrypted(&upload, &data), content);
+    }
+
+    #[test]
+    fn prepares_small_compressed_files_in_memory() {
+        let content = b"1,2,3\n".repeat(1000);
+        let mut file = tempfile::NamedTempFile::new().unwrap();
+        file.write_all(&content).unwrap();
+        let data = upload_data(&file, true);
+
+        let (upload, metadata) = prepare_upload(&data).unwrap();
+
+        assert!(matches!(upload.body, EncryptedBody::Memory(_)));
+        assert_eq!(metadata.target, "data.bin.gz");
+        assert_eq!(metadata.target_compression, CompressionType::Gzip);
+        let mut decompressed = Vec::new();
+        crate::compression::decompress_into(&decrypted(&upload, &data), &mut decompressed).unwrap();
+        assert_eq!(decompressed, content);
+    }
+}
@@ -0,0 +1,115 @@
+use crate::config::ConfigError;
+use crate::config::settings::{Settings, positive_int_setting};
+
+pub const MULTIPART_THRESHOLD_OPTION: &str = "put_multipart_threshold";
+pub const MULTIPART_PART_SIZE_OPTION: &str = "put_multipart_part_size";
+pub const MULTIPART_CONCURRENCY_OPTION: &str = "put_multipart_concurrency";
+
+const DEFAULT_MULTIPART_THRESHOLD: u64 = 64 * 1024 * 1024;
+const DEFAULT_PART_SIZE: u64 = 16 * 1024 * 1024;
+const DEFAULT_PART_CONCURRENCY: usize = 8;
+// S3 limits: every part but the last is at least 5 MiB, at most 10000 parts
+const MIN_PART_SIZE: u64 = 5 * 1024 * 1024;
+const MAX_PARTS: u64 = 10_000;
+
+/// Controls when and how PUT sends a file to S3 as a multipart upload.
+#[derive(Clone, Debug, PartialEq, Eq)]
+pub struct MultipartConfig {
+    /// Encrypted size in bytes above which a file is uploaded in parts.
+    pub threshold: u64,
+    /// Size of each part in bytes. Raised when a file would need more parts
+    /// than S3 allows.
+    pub part_size: u64,
+    /// Maximum number of parts of one file uploaded at the same time.
+    pub concurrency: usize,
+}
+
+impl Default for MultipartConfig {
+    fn default() -> Self {
+        Self {
+            threshold: DEFAULT_MULTIPART_THRESHOLD,
+            part_size: DEFAULT_PART_SIZE,
+            concurrency: DEFAULT_PART_CONCURRENCY,
+        }
+    }
+}
+
+impl MultipartConfig {
+    pub fn from_settings(settings: &dyn Settings) -> Result<Self, ConfigError> {
+        let defaults = Self::default();
+        Ok(Self {
+            threshold: positive_int_setting(settings, MULTIPART_THRESHOLD_OPTION)?
+                .map_or(defaults.threshold, |threshold| threshold as u64),
+            part_size: positive_int_setting(settings, MULTIPART_PART_SIZE_OPTION)?
+                .map_or(defaults.part_size, |part_size| part_size as u64),
+            concurrency: positive_int_setting(settings, MULTIPART_CONCURRENCY_OPTION)?
+                .unwrap_or(defaults.concurrency),
+        })
+    }
+
+    pub fn should_split(&self, size: u64) -> bool {
+        size > self.threshold.max(MIN_PART_SIZE)
+    }
+
+    /// Offsets and lengths of the parts of a file of `size` bytes.
+    pub fn part_ranges(&self, size: u64) -> Vec<(u64, u64)> {
+        let part_size = self
+            .part_size
+            .max(MIN_PART_SIZE)
+            .max(size.div_ceil(MAX_PARTS));
+        (0..size)
+            .step_by(part_size as usize)
+            .map(|offset| (offset, part_size.min(size - offset)))
+            .collect()
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::config::settings::Setting;
+    use std::collections::HashMap;
+
+    #[test]
+    fn multipart_config_reads_settings() {
+        let settings = HashMap::from([
+            (
+                MULTIPART_PART_SIZE_OPTION.to_string(),
+                Setting::String("8388608".to_string()),
+            ),
+            (MULTIPART_CONCURRENCY_OPTION.to_string(), Setting::Int(2)),
+        ]);
+        let config = MultipartConfig::from_settings(&settings).unwrap();
+        assert_eq!(
+            config,
+            MultipartConfig {
+                threshold: DEFAULT_MULTIPART_THRESHOLD,
+                part_size: 8 * 1024 * 1024,
+                concurrency: 2,
+            }
+        );
+    }
+
+    #[test]
+    fn part_ranges_cover_file_within_s3_limits() {
+        let config = MultipartConfig {
+            threshold: 0,
+            part_size: 1024,
+            concurrency: 1,
+        };
+        let size = 2 * MIN_PART_SIZE + 7;
+        assert_eq!(
+            config.part_ranges(size),
+            vec![
+                (0, MIN_PART_SIZE),
+                (MIN_PART_SIZE, MIN_PART_SIZE),
+                (2 * MIN_PART_SIZE, 7)
+            ]
+        );
+
+        let huge = MAX_PARTS * MIN_PART_SIZE * 3;
+        let parts = config.part_ranges(huge);
+        assert!(parts.len() as u64 <= MAX_PARTS);
+        assert_eq!(parts.iter().map(|(_, len)| len).sum::<u64>(), huge);
+    }
+}
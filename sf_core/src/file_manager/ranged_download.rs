@@ -0,0 +1,379 @@
+use std::collections::{BTreeMap, BTreeSet};
+use std::fs::File;
+use std::mem::take;
+use std::path::Path;
+use std::sync::{Arc, Mutex};
+
+use aws_sdk_s3::Client as S3Client;
+use aws_sdk_s3::primitives::ByteStream;
+use bytes::Bytes;
+use snafu::ResultExt;
+use tempfile::NamedTempFile;
+use tokio::task::JoinSet;
+
+use super::encryption::{DigestVerifier, EncryptionError, FileDecryptor, RangeDecryptor};
+use super::file_transfer::{file_metadata, get_object_range, next_chunk, object_size};
+use super::types::{EncryptionMaterial, StageInfo};
+use super::{DecryptionSnafu, FileManagerError, IoSnafu, S3DownloadSnafu, TaskSnafu};
+
+// Multiple of the AES block size, so every range starts on a block boundary
+const DOWNLOAD_RANGE_SIZE: u64 = 8 * 1024 * 1024;
+const DOWNLOAD_RANGE_CONCURRENCY: usize = 4;
+// Ranges started ahead of the first one not yet hashed. Bounds the
+// ciphertext held for the digest, which has to be computed in file order.
+const DOWNLOAD_RANGE_WINDOW: usize = 2 * DOWNLOAD_RANGE_CONCURRENCY;
+const AES_BLOCK_SIZE: u64 = 16;
+// Ciphertext of a range collected before it is decrypted and written
+const DECRYPT_BATCH_SIZE: usize = 1024 * 1024;
+
+/// Downloads a file into `output_path`, decrypting it as it arrives. Files
+/// larger than one range are fetched as parallel byte-range GETs, each
+/// decrypted on its own and written at its offset. The ranges go to a
+/// temporary file next to `output_path`, which is renamed to it only once the
+/// digest of the whole ciphertext checks out. Returns the size of the
+/// decrypted file.
+pub async fn download_to_file(
+    s3_client: &S3Client,
+    stage_info: &StageInfo,
+    filename: &str,
+    output_path: &Path,
+    encryption_material: &EncryptionMaterial,
+) -> Result<u64, FileManagerError> {
+    // The first range also carries the metadata and the size of the file
+    let first = get_object_range(
+        s3_client,
+        stage_info,
+        filename,
+        0,
+        DOWNLOAD_RANGE_SIZE,
+        None,
+    )
+    .await
+    .context(S3DownloadSnafu)?;
+    let metadata = file_metadata(&first).context(S3DownloadSnafu)?;
+    let size = object_size(&first).context(S3DownloadSnafu)?;
+    // Later ranges must come from the same version of the file
+    let e_tag = first.e_tag().map(str::to_string);
+    let ranges = (0..size)
+        .step_by(DOWNLOAD_RANGE_SIZE as usize)
+        .map(|offset| (offset, DOWNLOAD_RANGE_SIZE.min(size - offset)))
+        .collect::<Vec<_>>();
+
+    let context = Arc::new(RangeContext {
+        decryptor: FileDecryptor::new(&metadata, encryption_material).context(DecryptionSnafu)?,
+        digest: Mutex::new(OrderedDigest::new(
+            DigestVerifier::new(&metadata).context(DecryptionSnafu)?,
+        )),
+        output: output_temp_file(output_path).context(IoSnafu)?,
+        size,
+    });
+
+    let mut decrypted_size = 0;
+    // Dropping the set on error aborts the ranges still downloading
+    let mut downloads = JoinSet::new();
+    let mut first_body = Some(first.body);
+    for (index, (offset, length)) in ranges.iter().copied().enumerate() {
+        while downloads.len() == DOWNLOAD_RANGE_CONCURRENCY
+            || index >= context.hashed_ranges() + DOWNLOAD_RANGE_WINDOW
+        {
+            decrypted_size += join_range(&mut downloads).await?;
+        }
+
+        let context = context.clone();
+        let body = first_body.take();
+        let (s3_client, stage_info, filename, e_tag) = (
+            s3_client.clone(),
+            stage_info.clone(),
+            filename.to_string(),
+            e_tag.clone(),
+        );
+        downloads.spawn(async move {
+            let body = match body {
+                Some(body) => body,
+                // Starts one block early: CBC needs the previous ciphertext block
+                None => {
+                    get_object_range(
+                        &s3_client,
+                        &stage_info,
+                        &filename,
+                        offset - AES_BLOCK_SIZE,
+                        length + AES_BLOCK_SIZE,
+                        e_tag.as_deref(),
+                    )
+                    .await
+                    .context(S3DownloadSnafu)?
+                    .body
+                }
+            };
+            context.download_range(index, offset, length, body).await
+        });
+    }
+    while !downloads.is_empty() {
+        decrypted_size += join_range(&mut downloads).await?;
+    }
+
+    let context = Arc::into_inner(context).expect("all ranges are done");
+    let digest = context
+        .digest
+        .into_inner()
+        .expect("digest lock is not poisoned");
+    // Dropping the temporary file on a mismatch removes it
+    digest.verify(ranges.len()).context(DecryptionSnafu)?;
+    context
+        .output
+        .persist(output_path)
+        .map_err(|e| e.error)
+        .context(IoSnafu)?;
+    Ok(decrypted_size)
+}
+
+/// Creates the temporary file next to `output_path` with the mode
+/// `File::create` would give it, instead of the owner-only default of
+/// temporary files, so the persisted download is not more restricted.
+fn output_temp_file(output_path: &Path) -> std::io::Result<NamedTempFile> {
+    let mut builder = tempfile::Builder::new();
+    #[cfg(unix)]
+    builder.permissions(std::os::unix::fs::PermissionsExt::from_mode(0o666));
+    builder.tempfile_in(output_path.parent().unwrap_or(Path::new(".")))
+}
+
+async fn join_range(
+    downloads: &mut JoinSet<Result<u64, FileManagerError>>,
+) -> Result<u64, FileManagerError> {
+    downloads
+        .join_next()
+        .await
+        .expect("join_range is only called with ranges downloading")
+        .context(TaskSnafu)?
+}
+
+struct RangeContext {
+    decryptor: FileDecryptor,
+    digest: Mutex<OrderedDigest>,
+    output: NamedTempFile,
+    size: u64,
+}
+
+impl RangeContext {
+    fn hashed_ranges(&self) -> usize {
+        self.digest.lock().unwrap().next
+    }
+
+    /// Decrypts the range as its body arrives and writes the plaintext at the
+    /// range's offset, which CBC keeps equal to the ciphertext offset.
+    /// Returns the number of bytes written.
+    async fn download_range(
+        self: Arc<Self>,
+        index: usize,
+        offset: u64,
+        length: u64,
+        mut body: ByteStream,
+    ) -> Result<u64, FileManagerError> {
+        let ends_file = offset + length == self.size;
+        let mut previous_block = Vec::new();
+        let mut decryptor = None;
+        let mut batch = Vec::new();
+        let mut batch_size = 0;
+        let mut written = 0;
+
+        while let Some(mut chunk) = next_chunk(&mut body).await.context(S3DownloadSnafu)? {
+            if decryptor.is_none() {
+                if offset > 0 {
+                    let missing = AES_BLOCK_SIZE as usize - previous_block.len();
+                    let taken = chunk.split_to(missing.min(chunk.len()));
+                    previous_block.extend_from_slice(&taken);
+                    if previous_block.len() < AES_BLOCK_SIZE as usize {
+                        continue;
+                    }
+                }
+                decryptor = Some(
+                    self.decryptor
+                        .range((offset > 0).then_some(&previous_block[..]), ends_file)
+                        .context(DecryptionSnafu)?,
+                );
+            }
+            if chunk.is_empty() {
+                continue;
+            }
+
+            batch_size += chunk.len();
+            batch.push(chunk);
+            if batch_size >= DECRYPT_BATCH_SIZE {
+                let range = decryptor.take().expect("created above");
+                let (range, size) = self
+                    .clone()
+                    .decrypt_batch(index, offset + written, range, take(&mut batch), false)
+                    .await?;
+                decryptor = range;
+                written += size;
+                batch_size = 0;
+            }
+        }
+
+        let decryptor = decryptor
+            .ok_or_else(|| std::io::Error::from(std::io::ErrorKind::UnexpectedEof))
+            .context(IoSnafu)?;
+        let (_, size) = self
+            .decrypt_batch(index, offset + written, decryptor, batch, true)
+            .await?;
+        Ok(written + size)
+    }
+
+    /// Hashes and decrypts a batch of the range's ciphertext and writes the
+    /// plaintext at `position`. Runs on the blocking pool so that AES and disk
+    /// writes don't hold up the runtime's workers. The last batch of a range
+    /// also flushes the decryptor, otherwise it is handed back for the next
+    /// one. Returns it with the number of bytes written.
+    async fn decrypt_batch(
+        self: Arc<Self>,
+        index: usize,
+        position: u64,
+        mut decryptor: RangeDecryptor,
+        batch: Vec<Bytes>,
+        last: bool,
+    ) -> Result<(Option<RangeDecryptor>, u64), FileManagerError> {
+        tokio::task::spawn_blocking(move || {
+            let mut plaintext = Vec::new();
+            for chunk in batch {
+                decryptor
+                    .update(&chunk, &mut plaintext)
+                    .context(DecryptionSnafu)?;
+                self.digest
+                    .lock()
+                    .unwrap()
+                    .push(index, chunk)
+                    .context(DecryptionSnafu)?;
+            }
+            let decryptor = if last {
+                decryptor.finish(&mut plaintext).context(DecryptionSnafu)?;
+                None
+            } else {
+                Some(decryptor)
+            };
+            write_all_at(self.output.as_file(), &plaintext, position).context(IoSnafu)?;
+            if last {
+                self.digest
+                    .lock()
+                    .unwrap()
+                    .finish(index)
+                    .context(DecryptionSnafu)?;
+            }
+            Ok((decryptor, plaintext.len() as u64))
+        })
+        .await
+        .context(TaskSnafu)?
+    }
+}
+
+/// Feeds the digest in file order while ranges arrive out of order. Chunks of
+/// the first unfinished range are hashed right away, later ones wait here.
+struct OrderedDigest {
+    verifier: DigestVerifier,
+    // First range not completely hashed yet
+    next: usize,
+    pending: BTreeMap<usize, Vec<Bytes>>,
+    finished: BTreeSet<usize>,
+}
+
+impl OrderedDigest {
+    fn new(verifier: DigestVerifier) -> Self {
+        Self {
+            verifier,
+            next: 0,
+            pending: BTreeMap::new(),
+            finished: BTreeSet::new(),
+        }
+    }
+
+    fn push(&mut self, range: usize, chunk: Bytes) -> Result<(), EncryptionError> {
+        if range == self.next {
+            self.verifier.update(&chunk)
+        } else {
+            self.pending.entry(range).or_default().push(chunk);
+            Ok(())
+        }
+    }
+
+    fn finish(&mut self, range: usize) -> Result<(), EncryptionError> {
+        self.finished.insert(range);
+        while self.finished.remove(&self.next) {
+            self.next += 1;
+            for chunk in self.pending.remove(&self.next).into_iter().flatten() {
+                self.verifier.update(&chunk)?;
+            }
+        }
+        Ok(())
+    }
+
+    fn verify(self, ranges: usize) -> Result<(), EncryptionError> {
+        debug_assert_eq!(self.next, ranges);
+        self.verifier.verify()
+    }
+}
+
+#[cfg(unix)]
+fn write_all_at(file: &File, buf: &[u8], offset: u64) -> std::io::Result<()> {
+    std::os::unix::fs::FileExt::write_all_at(file, buf, offset)
+}
+
+#[cfg(windows)]
+fn write_all_at(file: &File, mut buf: &[u8], mut offset: u64) -> std::io::Result<()> {
+    while !buf.is_empty() {
+        let written = std::os::windows::fs::FileExt::seek_write(file, buf, offset)?;
+        if written == 0 {
+            return Err(std::io::ErrorKind::WriteZero.into());
+        }
+        buf = &buf[written..];
+        offset += written as u64;
+    }
+    Ok(())
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::file_manager::encryption::FileEncryptor;
+    use base64::{Engine, engine::general_purpose::STANDARD as BASE64_ENGINE};
+
+    #[test]
+    fn hashes_ranges_in_file_order_whatever_order_they_arrive() {
+        let encryption_material = EncryptionMaterial {
+            query_stage_master_key: BASE64_ENGINE.encode([9u8; 32]),
+            query_id: "query".to_string(),
+            smk_id: "1".to_string(),
+        };
+        let mut encryptor = FileEncryptor::new(&encryption_material).unwrap();
+        let mut encrypted = Vec::new();
+        encryptor.update(&[1u8; 3000], &mut encrypted).unwrap();
+        let metadata = encryptor.finish(&mut encrypted).unwrap();
+        let chunk = |start: usize, end: usize| Bytes::copy_from_slice(&encrypted[start..end]);
+
+        let mut digest = OrderedDigest::new(DigestVerifier::new(&metadata).unwrap());
+        digest.push(2, chunk(2048, 2500)).unwrap();
+        digest.push(1, chunk(1024, 2048)).unwrap();
+        digest.push(2, chunk(2500, encrypted.len())).unwrap();
+        digest.finish(2).unwrap();
+        digest.push(0, chunk(0, 512)).unwrap();
+        digest.finish(1).unwrap();
+        digest.push(0, chunk(512, 1024)).unwrap();
+        assert_eq!(digest.next, 0);
+        digest.finish(0).unwrap();
+        assert_eq!(digest.next, 3);
+        digest.verify(3).unwrap();
+    }
+
+    #[cfg(unix)]
+    #[test]
+    fn output_gets_the_mode_file_create_gives() {
+        use std::os::unix::fs::PermissionsExt;
+
+        let dir = tempfile::tempdir().unwrap();
+        let mode = |path: &Path| path.metadata().unwrap().permissions().mode() & 0o777;
+        let created = dir.path().join("created");
+        File::create(&created).unwrap();
+
+        let output = dir.path().join("downloaded");
+        output_temp_file(&output).unwrap().persist(&output).unwrap();
+        assert_eq!(mode(&output), mode(&created));
+    }
+}
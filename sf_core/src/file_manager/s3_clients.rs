@@ -0,0 +1,32 @@
+use aws_config::{BehaviorVersion, Region};
+use aws_credential_types::Credentials;
+use aws_sdk_s3::Client as S3Client;
+
+use super::types::StageInfo;
+
+const STAGE_CREDENTIALS_PROVIDER: &str = "snowflake-stage";
+
+/// Creates the S3 client for the stage's region and credentials.
+///
+/// A PUT or GET command creates one client and shares it, with its
+/// connection pool, between all of its files instead of loading the SDK
+/// config and opening new connections per file. Stage credentials are issued
+/// per command, so the client is dropped with the command and no credentials
+/// outlive it.
+pub async fn s3_client(stage_info: &StageInfo) -> S3Client {
+    let credentials = Credentials::new(
+        &stage_info.creds.aws_key_id,
+        &stage_info.creds.aws_secret_key,
+        Some(stage_info.creds.aws_token.clone()),
+        None,
+        STAGE_CREDENTIALS_PROVIDER,
+    );
+
+    let config = aws_config::defaults(BehaviorVersion::latest())
+        .credentials_provider(credentials)
+        .region(Region::new(stage_info.region.clone()))
+        .load()
+        .await;
+
+    S3Client::new(&config)
+}
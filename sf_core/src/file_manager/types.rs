@@ -1,6 +1,10 @@
+use super::multipart::MultipartConfig;
 use crate::compression_types::CompressionType;
 use serde::{Deserialize, Serialize};
 
+/// Files transferred at once when the server does not say, as in PUT and GET
+pub const DEFAULT_PARALLEL: usize = 4;
+
 // Dedicated file transfer types
 #[derive(Debug)]
 pub struct UploadData {
@@ -10,6 +14,9 @@ pub struct UploadData {
     pub auto_compress: bool,
     pub source_compression: SourceCompressionParam,
     pub overwrite: bool,
+    /// Number of files uploaded at the same time
+    pub parallel: usize,
+    pub multipart: MultipartConfig,
 }
 
 pub struct SingleUploadData {
@@ -20,6 +27,7 @@ pub struct SingleUploadData {
     pub auto_compress: bool,
     pub source_compression: SourceCompressionParam,
     pub overwrite: bool,
+    pub multipart: MultipartConfig,
 }
 
 #[derive(Debug)]
@@ -28,6 +36,8 @@ pub struct DownloadData {
     pub local_location: String,
     pub stage_info: StageInfo,
     pub encryption_materials: Vec<EncryptionMaterial>,
+    /// Number of files downloaded at the same time
+    pub parallel: usize,
 }
 
 #[derive(Debug)]
@@ -103,13 +113,22 @@ pub struct EncryptionMaterial {
     pub smk_id: String,
 }
 
-// Result of encryption containing encrypted data and metadata
+// Encrypted file ready for upload and the metadata uploaded with it
 #[derive(Debug)]
-pub struct EncryptionResult {
-    pub data: Vec<u8>,
+pub struct EncryptedUpload {
+    pub body: EncryptedBody,
+    pub size: u64,
     pub metadata: EncryptedFileMetadata,
 }
 
+/// Encrypted file contents, kept in memory while they fit in one block and
+/// spilled to a temporary file after that.
+#[derive(Debug)]
+pub enum EncryptedBody {
+    Memory(Vec<u8>),
+    File(tempfile::NamedTempFile),
+}
+
 // Encrypted file metadata that gets bundled with the encrypted data
 #[derive(Debug)]
 pub struct EncryptedFileMetadata {
@@ -1,20 +1,52 @@
+use std::sync::atomic::{AtomicUsize, Ordering};
 use std::sync::{Arc, RwLock};
 use tracing::{Level, span};
 
+// Power of two so the shard is the low bits of the id
+const SHARDS: usize = 16;
+
+static NEXT_THREAD_SHARD: AtomicUsize = AtomicUsize::new(0);
+
+thread_local! {
+    // Each thread adds to its own shard, so threads rarely share a lock
+    static THREAD_SHARD: usize = NEXT_THREAD_SHARD.fetch_add(1, Ordering::Relaxed) % SHARDS;
+}
+
 #[derive(Debug, Clone, Copy, PartialEq, Eq)]
 pub struct Handle {
     pub id: u64,
     pub magic: u64,
 }
 
-struct HandleValue<T> {
+struct Slot<T> {
+    // Generation in the high half, random bits in the low half
     magic: u64,
+    generation: u32,
     value: Option<Arc<T>>,
 }
 
+struct Shard<T> {
+    slots: Vec<Slot<T>>,
+    free: Vec<usize>,
+}
+
+impl<T> Shard<T> {
+    const fn new() -> Self {
+        Shard {
+            slots: Vec::new(),
+            free: Vec::new(),
+        }
+    }
+}
+
+/// Maps handles to shared objects.
+///
+/// Handles are spread over independently locked shards, so lookups only
+/// take the read lock of one shard. Deleted slots are reused; every reuse
+/// bumps the slot's generation, which is part of the magic, so a stale
+/// handle never resolves to the slot's new object.
 pub struct HandleManager<T> {
-    handles: RwLock<Vec<HandleValue<T>>>,
-    // TODO Add id recycling (ids are never reused, so we can run out of ids)
+    shards: [RwLock<Shard<T>>; SHARDS],
 }
 
 impl<T> Default for HandleManager<T> {
@@ -26,54 +58,55 @@ impl<T> Default for HandleManager<T> {
 impl<T> HandleManager<T> {
     pub const fn new() -> Self {
         HandleManager {
-            handles: RwLock::new(Vec::new()),
+            shards: [const { RwLock::new(Shard::new()) }; SHARDS],
         }
     }
 
     pub fn add_handle(&self, obj: T) -> Handle {
         let span = span!(target: "handle_manager", Level::INFO, "HandleManager::add_handle");
         let _enter = span.enter();
-        let mut handles = self.handles.write().unwrap();
+        let shard_index = THREAD_SHARD.with(|shard| *shard);
+        let mut shard = self.shards[shard_index].write().unwrap();
 
-        let size = handles.len();
-        let handle = Handle {
-            id: size as u64,
-            magic: rand::random::<u64>(),
+        let slot_index = match shard.free.pop() {
+            Some(slot_index) => slot_index,
+            None => {
+                shard.slots.push(Slot {
+                    magic: 0,
+                    generation: 0,
+                    value: None,
+                });
+                shard.slots.len() - 1
+            }
         };
-        let handle_value = HandleValue {
-            magic: handle.magic,
-            value: Some(Arc::new(obj)),
+        let slot = &mut shard.slots[slot_index];
+        slot.magic = ((slot.generation as u64) << 32) | rand::random::<u32>() as u64;
+        slot.value = Some(Arc::new(obj));
+
+        let handle = Handle {
+            id: (slot_index * SHARDS + shard_index) as u64,
+            magic: slot.magic,
         };
-        handles.push(handle_value);
         tracing::trace!(target: "handle_manager", "Handle {:?} added successfully", handle);
         handle
     }
 
     pub fn get_obj(&self, handle: Handle) -> Option<Arc<T>> {
-        let span = span!(target: "handle_manager", Level::INFO, "HandleManager::get_obj", handle_id = handle.id, handle_magic = handle.magic);
-        let _enter = span.enter();
-
-        let index = handle.id as usize;
-        let handles = self.handles.read().unwrap();
+        let (shard_index, slot_index) = Self::locate(handle);
+        let shard = self.shards[shard_index].read().unwrap();
 
-        if index >= handles.len() {
-            tracing::error!("Handle index out of bounds, cannot get object");
+        let Some(slot) = shard.slots.get(slot_index) else {
+            tracing::error!(target: "handle_manager", handle_id = handle.id, "Handle index out of bounds, cannot get object");
             return None;
-        }
-
-        let handle_value = &handles[index];
-        let magic = handle_value.magic;
-        match handle_value.value.as_ref() {
-            Some(val) if magic == handle.magic => {
-                tracing::trace!(target: "handle_manager", "Handle retrieved successfully");
-                Some(val.clone())
-            }
+        };
+        match slot.value.as_ref() {
+            Some(val) if slot.magic == handle.magic => Some(val.clone()),
             Some(_) => {
-                tracing::error!("Handle magic mismatch, cannot get object");
+                tracing::error!(target: "handle_manager", handle_id = handle.id, "Handle magic mismatch, cannot get object");
                 None
             }
             None => {
-                tracing::error!("Handle not found, cannot get object");
+                tracing::error!(target: "handle_manager", handle_id = handle.id, "Handle not found, cannot get object");
                 None
             }
         }
@@ -82,31 +115,93 @@ impl<T> HandleManager<T> {
     pub fn delete_handle(&self, handle: Handle) -> bool {
         let span = span!(target: "handle_manager", Level::INFO, "Deleting handle", handle_id = handle.id, handle_magic = handle.magic);
         let _enter = span.enter();
-        let index = handle.id as usize;
-        let mut handles = self.handles.write().unwrap();
+        let (shard_index, slot_index) = Self::locate(handle);
+        let mut shard = self.shards[shard_index].write().unwrap();
 
-        if index >= handles.len() {
+        let Some(slot) = shard.slots.get_mut(slot_index) else {
             tracing::error!("Handle index out of bounds, cannot delete handle");
             return false;
-        }
-
-        let handle_value = &mut handles[index];
-        let magic = handle_value.magic;
+        };
 
-        if magic != handle.magic {
+        if slot.magic != handle.magic {
             tracing::error!("Handle magic mismatch, cannot delete handle");
             return false;
         }
 
-        match handle_value.value.take() {
-            Some(_) => {
-                tracing::trace!(target: "handle_manager", "Handle deleted successfully");
-                true
-            }
-            None => {
-                tracing::error!("Handle not found, cannot delete handle");
-                false
-            }
+        // Drop the object outside the lock, it may own other handles
+        let value = slot.value.take();
+        if value.is_none() {
+            tracing::error!("Handle not found, cannot delete handle");
+            return false;
+        }
+        slot.generation = slot.generation.wrapping_add(1);
+        shard.free.push(slot_index);
+        drop(shard);
+        drop(value);
+        tracing::trace!(target: "handle_manager", "Handle deleted successfully");
+        true
+    }
+
+    fn locate(handle: Handle) -> (usize, usize) {
+        let id = handle.id as usize;
+        (id % SHARDS, id / SHARDS)
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn reuses_deleted_slots() {
+        let manager = HandleManager::new();
+        let handles: Vec<_> = (0..32).map(|i| manager.add_handle(i)).collect();
+        for handle in &handles {
+            assert!(manager.delete_handle(*handle));
+        }
+
+        let reused: Vec<_> = (0..32).map(|i| manager.add_handle(i)).collect();
+        let ids = |handles: &[Handle]| {
+            let mut ids: Vec<_> = handles.iter().map(|h| h.id).collect();
+            ids.sort_unstable();
+            ids
+        };
+        assert_eq!(ids(&reused), ids(&handles));
+    }
+
+    #[test]
+    fn stale_handle_does_not_reach_the_new_object() {
+        let manager = HandleManager::new();
+        let stale = manager.add_handle("first");
+        assert!(manager.delete_handle(stale));
+        assert!(!manager.delete_handle(stale));
+
+        let reused = manager.add_handle("second");
+        assert_eq!(reused.id, stale.id);
+        assert_ne!(reused.magic, stale.magic);
+        assert!(manager.get_obj(stale).is_none());
+        assert!(!manager.delete_handle(stale));
+        assert_eq!(*manager.get_obj(reused).unwrap(), "second");
+    }
+
+    #[test]
+    fn concurrent_add_get_delete() {
+        let manager = Arc::new(HandleManager::new());
+        let threads: Vec<_> = (0..8)
+            .map(|t| {
+                let manager = manager.clone();
+                std::thread::spawn(move || {
+                    for i in 0..1000 {
+                        let handle = manager.add_handle(t * 1000 + i);
+                        assert_eq!(*manager.get_obj(handle).unwrap(), t * 1000 + i);
+                        assert!(manager.delete_handle(handle));
+                        assert!(manager.get_obj(handle).is_none());
+                    }
+                })
+            })
+            .collect();
+        for thread in threads {
+            thread.join().unwrap();
         }
     }
 }
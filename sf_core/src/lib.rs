@@ -19,4 +19,13 @@ pub mod protobuf_apis;
 pub mod protobuf_gen;
 pub mod query_types;
 pub mod rest;
+pub mod runtime;
 pub mod tls;
+
+/// Internals measured by the benches, built only with `bench-internals`.
+#[cfg(feature = "bench-internals")]
+#[doc(hidden)]
+pub mod bench_internals {
+    pub use crate::chunks::{ChunkBatches, decode_chunk_body};
+    pub use crate::file_manager::{Credentials, StageInfo, s3_client};
+}
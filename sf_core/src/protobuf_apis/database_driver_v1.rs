@@ -4,21 +4,25 @@ use crate::apis::database_driver_v1::Setting;
 use crate::apis::database_driver_v1::error::ConfigError;
 use crate::apis::database_driver_v1::error::RestError;
 use crate::apis::database_driver_v1::statement_bind;
+use crate::apis::database_driver_v1::statement_bind_stream;
 use crate::apis::database_driver_v1::{
     connection_init, connection_new, connection_release, connection_set_option,
+    connection_set_options,
 };
 use crate::apis::database_driver_v1::{
     database_init, database_new, database_release, database_set_option,
 };
 use crate::apis::database_driver_v1::{
-    statement_execute_query, statement_new, statement_prepare, statement_release,
-    statement_set_option, statement_set_sql_query,
+    statement_execute_partitions, statement_execute_query, statement_get_parameter_schema,
+    statement_new, statement_prepare, statement_read_partition, statement_release,
+    statement_set_option, statement_set_options, statement_set_sql_query,
 };
 use crate::protobuf_gen::database_driver_v1::*;
 use arrow::ffi::FFI_ArrowArray;
 use arrow::ffi::FFI_ArrowSchema;
 use arrow::ffi_stream::FFI_ArrowArrayStream;
 use snafu::Report;
+use std::collections::HashMap;
 use tracing::instrument;
 
 impl From<ArrowArrayStreamPtr> for *mut FFI_ArrowArrayStream {
@@ -50,6 +54,16 @@ impl From<*mut FFI_ArrowArrayStream> for ArrowArrayStreamPtr {
     }
 }
 
+impl From<*mut FFI_ArrowSchema> for ArrowSchemaPtr {
+    fn from(raw: *mut FFI_ArrowSchema) -> Self {
+        let len = size_of::<*mut FFI_ArrowSchema>();
+        let buf_ptr = std::ptr::addr_of!(raw) as *const u8;
+        let slice = unsafe { std::slice::from_raw_parts(buf_ptr, len) };
+        let vec = slice.to_vec();
+        ArrowSchemaPtr { value: vec }
+    }
+}
+
 // Handle conversions from protobuf types to internal Handle type
 impl From<DatabaseHandle> for Handle {
     fn from(handle: DatabaseHandle) -> Self {
@@ -171,6 +185,10 @@ fn to_driver_error(error: &ApiError) -> DriverError {
         ApiError::QueryResponseProcessing { .. } => DriverError {
             error_type: Some(driver_error::ErrorType::InternalError(InternalError {})),
         },
+        ApiError::BindUpload { .. } => DriverError {
+            error_type: Some(driver_error::ErrorType::InternalError(InternalError {})),
+        },
+        ApiError::PartialBindStream { source, .. } => to_driver_error(source),
         ApiError::ConnectionNotInitialized { .. } => DriverError {
             error_type: Some(driver_error::ErrorType::InternalError(InternalError {})),
         },
@@ -182,8 +200,8 @@ fn to_driver_error(error: &ApiError) -> DriverError {
     }
 }
 
-fn to_driver_exception(error: ApiError) -> DriverException {
-    let status_code = match &error {
+fn status_code(error: &ApiError) -> StatusCode {
+    match error {
         ApiError::GenericError { .. } => StatusCode::GenericError,
         ApiError::RuntimeCreation { .. } => StatusCode::InternalError,
         ApiError::Configuration {
@@ -204,10 +222,15 @@ fn to_driver_exception(error: ApiError) -> DriverException {
         ApiError::StatementLocking { .. } => StatusCode::InternalError,
         ApiError::DatabaseLocking { .. } => StatusCode::InternalError,
         ApiError::QueryResponseProcessing { .. } => StatusCode::InternalError,
+        ApiError::BindUpload { .. } => StatusCode::InternalError,
         ApiError::ConnectionNotInitialized { .. } => StatusCode::InternalError,
         ApiError::TlsClientCreation { .. } => StatusCode::AuthenticationError,
-    };
+        ApiError::PartialBindStream { source, .. } => status_code(source),
+    }
+}
 
+fn to_driver_exception(error: ApiError) -> DriverException {
+    let status_code = status_code(&error);
     let message = error.to_string();
     let driver_error = to_driver_error(&error);
     let report = Report::from_error(error).to_string();
@@ -229,6 +252,25 @@ fn required<T>(value: Option<T>, message: &str) -> Result<T, DriverException> {
     })
 }
 
+#[allow(clippy::result_large_err)]
+fn to_settings(
+    options: HashMap<String, OptionValue>,
+) -> Result<HashMap<String, Setting>, DriverException> {
+    options
+        .into_iter()
+        .map(|(key, option)| {
+            let value = required(option.value, &format!("Option {key} has no value"))?;
+            let setting = match value {
+                option_value::Value::StringValue(value) => Setting::String(value),
+                option_value::Value::BytesValue(value) => Setting::Bytes(value),
+                option_value::Value::IntValue(value) => Setting::Int(value),
+                option_value::Value::DoubleValue(value) => Setting::Double(value),
+            };
+            Ok((key, setting))
+        })
+        .collect()
+}
+
 fn not_implemented(message: &str) -> DriverException {
     DriverException {
         message: message.to_string(),
@@ -386,6 +428,18 @@ impl DatabaseDriver for DatabaseDriverImpl {
         Ok(ConnectionSetOptionDoubleResponse {})
     }
 
+    #[instrument(name = "DatabaseDriverV1::connection_set_options", skip(input))]
+    fn connection_set_options(
+        input: ConnectionSetOptionsRequest,
+    ) -> Result<ConnectionSetOptionsResponse, DriverException> {
+        let conn_handle = required(input.conn_handle, "Connection handle is required")?;
+        let options = to_settings(input.options)?;
+
+        connection_set_options(conn_handle.into(), options).to_protobuf()?;
+
+        Ok(ConnectionSetOptionsResponse {})
+    }
+
     #[instrument(name = "DatabaseDriverV1::connection_init", skip(input))]
     fn connection_init(
         input: ConnectionInitRequest,
@@ -507,8 +561,11 @@ impl DatabaseDriver for DatabaseDriverImpl {
     ) -> Result<StatementPrepareResponse, DriverException> {
         let stmt_handle = required(input.stmt_handle, "Statement handle is required")?;
 
-        statement_prepare(stmt_handle.into()).to_protobuf()?;
-        Ok(StatementPrepareResponse {})
+        let prepared = statement_prepare(stmt_handle.into()).to_protobuf()?;
+        Ok(StatementPrepareResponse {
+            result_schema: Some(Box::into_raw(prepared.result_schema).into()),
+            parameter_schema: Some(Box::into_raw(prepared.parameter_schema).into()),
+        })
     }
 
     #[instrument(name = "DatabaseDriverV1::statement_set_option_string", skip(input))]
@@ -559,16 +616,27 @@ impl DatabaseDriver for DatabaseDriverImpl {
         Ok(StatementSetOptionDoubleResponse {})
     }
 
-    #[instrument(
-        name = "DatabaseDriverV1::statement_get_parameter_schema",
-        skip(_input)
-    )]
+    #[instrument(name = "DatabaseDriverV1::statement_set_options", skip(input))]
+    fn statement_set_options(
+        input: StatementSetOptionsRequest,
+    ) -> Result<StatementSetOptionsResponse, DriverException> {
+        let stmt_handle = required(input.stmt_handle, "Statement handle is required")?;
+        let options = to_settings(input.options)?;
+
+        statement_set_options(stmt_handle.into(), options).to_protobuf()?;
+
+        Ok(StatementSetOptionsResponse {})
+    }
+
+    #[instrument(name = "DatabaseDriverV1::statement_get_parameter_schema", skip(input))]
     fn statement_get_parameter_schema(
-        _input: StatementGetParameterSchemaRequest,
+        input: StatementGetParameterSchemaRequest,
     ) -> Result<StatementGetParameterSchemaResponse, DriverException> {
-        Err(not_implemented(
-            "statement_get_parameter_schema is not yet implemented",
-        ))
+        let stmt_handle = required(input.stmt_handle, "Statement handle is required")?;
+        let schema = statement_get_parameter_schema(stmt_handle.into()).to_protobuf()?;
+        Ok(StatementGetParameterSchemaResponse {
+            schema: Some(Box::into_raw(schema).into()),
+        })
     }
 
     #[instrument(name = "DatabaseDriverV1::statement_bind", skip(input))]
@@ -582,14 +650,20 @@ impl DatabaseDriver for DatabaseDriverImpl {
         Ok(StatementBindResponse {})
     }
 
-    #[instrument(name = "DatabaseDriverV1::statement_bind_stream", skip(_input))]
+    #[instrument(name = "DatabaseDriverV1::statement_bind_stream", skip(input))]
     fn statement_bind_stream(
-        _input: StatementBindStreamRequest,
+        input: StatementBindStreamRequest,
     ) -> Result<StatementBindStreamResponse, DriverException> {
-        // TODO: Implement when corresponding API method is available
-        Err(not_implemented(
-            "statement_bind_stream is not yet implemented",
-        ))
+        let stmt_handle = required(input.stmt_handle, "Statement handle is required")?;
+        // The stream field holds the pointer bytes, as ArrowArrayStreamPtr does
+        let stream = (input.stream.len() == size_of::<*mut FFI_ArrowArrayStream>()).then_some(
+            ArrowArrayStreamPtr {
+                value: input.stream,
+            },
+        );
+        let stream = required(stream, "Stream is required")?;
+        unsafe { statement_bind_stream(stmt_handle.into(), stream.into()).to_protobuf()? };
+        Ok(StatementBindStreamResponse {})
     }
 
     #[instrument(name = "DatabaseDriverV1::statement_execute_query", skip(input))]
@@ -609,22 +683,35 @@ impl DatabaseDriver for DatabaseDriverImpl {
         })
     }
 
-    #[instrument(name = "DatabaseDriverV1::statement_execute_partitions", skip(_input))]
+    #[instrument(name = "DatabaseDriverV1::statement_execute_partitions", skip(input))]
     fn statement_execute_partitions(
-        _input: StatementExecutePartitionsRequest,
+        input: StatementExecutePartitionsRequest,
     ) -> Result<StatementExecutePartitionsResponse, DriverException> {
-        Err(not_implemented(
-            "statement_execute_partitions is not yet implemented",
-        ))
+        let stmt_handle = required(input.stmt_handle, "Statement handle is required")?;
+
+        let result = statement_execute_partitions(stmt_handle.into()).to_protobuf()?;
+
+        Ok(StatementExecutePartitionsResponse {
+            result: Some(PartitionedResult {
+                schema: Box::into_raw(result.schema) as i64,
+                partitions: result.partitions,
+                rows_affected: result.rows_affected,
+            }),
+        })
     }
 
-    #[instrument(name = "DatabaseDriverV1::statement_read_partition", skip(_input))]
+    #[instrument(name = "DatabaseDriverV1::statement_read_partition", skip(input))]
     fn statement_read_partition(
-        _input: StatementReadPartitionRequest,
+        input: StatementReadPartitionRequest,
     ) -> Result<StatementReadPartitionResponse, DriverException> {
-        Err(not_implemented(
-            "statement_read_partition is not yet implemented",
-        ))
+        let stmt_handle = required(input.stmt_handle, "Statement handle is required")?;
+
+        let stream = statement_read_partition(stmt_handle.into(), &input.partition_descriptor)
+            .to_protobuf()?;
+
+        Ok(StatementReadPartitionResponse {
+            partition_stream: Box::into_raw(stream) as i64,
+        })
     }
 }
 
@@ -633,3 +720,51 @@ impl DatabaseDriverServer for DatabaseDriverImpl {}
 pub type DatabaseDriverClient = crate::protobuf_gen::database_driver_v1::DatabaseDriverClient<
     crate::protobuf_apis::RustTransport,
 >;
+
+/// Typed client for callers linked into the same binary, such as the ODBC
+/// driver. Requests and responses are passed by value instead of being
+/// encoded, while Python and JDBC keep going through `call_proto`.
+pub type DatabaseDriverLocalClient =
+    crate::protobuf_gen::database_driver_v1::DatabaseDriverLocalClient<DatabaseDriverImpl>;
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use proto_utils::ProtoError;
+
+    #[test]
+    fn local_client_reports_the_same_errors_as_the_protobuf_client() {
+        let request = StatementSetSqlQueryRequest {
+            stmt_handle: Some(StatementHandle {
+                id: i64::MAX,
+                magic: 0,
+            }),
+            query: "SELECT 1".to_string(),
+        };
+        let local = DatabaseDriverLocalClient::statement_set_sql_query(request.clone());
+        let encoded = DatabaseDriverClient::statement_set_sql_query(request);
+        match (local, encoded) {
+            (Err(ProtoError::Application(local)), Err(ProtoError::Application(encoded))) => {
+                assert_eq!(local, encoded);
+                assert_eq!(local.status_code, StatusCode::InvalidArgument as i32);
+            }
+            other => panic!("expected application errors, got {other:?}"),
+        }
+    }
+
+    #[test]
+    fn option_without_value_is_rejected() {
+        let options = HashMap::from([
+            (
+                "account".to_string(),
+                OptionValue {
+                    value: Some(option_value::Value::StringValue("acme".to_string())),
+                },
+            ),
+            ("port".to_string(), OptionValue { value: None }),
+        ]);
+        let error = to_settings(options).unwrap_err();
+        assert_eq!(error.status_code, StatusCode::InvalidArgument as i32);
+        assert_eq!(error.message, "Option port has no value");
+    }
+}
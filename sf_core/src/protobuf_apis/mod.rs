@@ -5,10 +5,7 @@ use proto_utils::*;
 pub mod database_driver_v1;
 
 pub fn call_proto(api: &str, method: &str, message: &[u8]) -> Result<Vec<u8>, ProtoError<Vec<u8>>> {
-    match api {
-        "DatabaseDriver" => DatabaseDriverImpl::handle_message(method, message.to_vec()),
-        _ => Err(ProtoError::Transport(format!("Unknown API: {}", api))),
-    }
+    RustTransport::handle_message(api, method, message.to_vec())
 }
 
 pub struct RustTransport {}
@@ -19,6 +16,9 @@ impl Transport for RustTransport {
         method: &str,
         message: Vec<u8>,
     ) -> Result<Vec<u8>, ProtoError<Vec<u8>>> {
-        call_proto(service, method, &message)
+        match service {
+            "DatabaseDriver" => DatabaseDriverImpl::handle_message(method, message),
+            _ => Err(ProtoError::Transport(format!("Unknown API: {}", service))),
+        }
     }
 }
@@ -139,6 +139,26 @@ pub struct ArrowArrayPtr {
     #[prost(bytes = "vec", tag = "1")]
     pub value: ::prost::alloc::vec::Vec<u8>,
 }
+/// Typed option value
+#[derive(Clone, PartialEq, ::prost::Message)]
+pub struct OptionValue {
+    #[prost(oneof = "option_value::Value", tags = "1, 2, 3, 4")]
+    pub value: ::core::option::Option<option_value::Value>,
+}
+/// Nested message and enum types in `OptionValue`.
+pub mod option_value {
+    #[derive(Clone, PartialEq, ::prost::Oneof)]
+    pub enum Value {
+        #[prost(string, tag = "1")]
+        StringValue(::prost::alloc::string::String),
+        #[prost(bytes, tag = "2")]
+        BytesValue(::prost::alloc::vec::Vec<u8>),
+        #[prost(int64, tag = "3")]
+        IntValue(i64),
+        #[prost(double, tag = "4")]
+        DoubleValue(f64),
+    }
+}
 #[derive(Clone, Copy, PartialEq, Eq, Hash, ::prost::Message)]
 pub struct DatabaseNewRequest {}
 #[derive(Clone, Copy, PartialEq, Eq, Hash, ::prost::Message)]
@@ -255,6 +275,15 @@ pub struct ConnectionSetOptionDoubleRequest {
 }
 #[derive(Clone, Copy, PartialEq, Eq, Hash, ::prost::Message)]
 pub struct ConnectionSetOptionDoubleResponse {}
+#[derive(Clone, PartialEq, ::prost::Message)]
+pub struct ConnectionSetOptionsRequest {
+    #[prost(message, optional, tag = "1")]
+    pub conn_handle: ::core::option::Option<ConnectionHandle>,
+    #[prost(map = "string, message", tag = "2")]
+    pub options: ::std::collections::HashMap<::prost::alloc::string::String, OptionValue>,
+}
+#[derive(Clone, Copy, PartialEq, Eq, Hash, ::prost::Message)]
+pub struct ConnectionSetOptionsResponse {}
 #[derive(Clone, Copy, PartialEq, Eq, Hash, ::prost::Message)]
 pub struct ConnectionInitRequest {
     #[prost(message, optional, tag = "1")]
@@ -385,8 +414,15 @@ pub struct StatementPrepareRequest {
     #[prost(message, optional, tag = "1")]
     pub stmt_handle: ::core::option::Option<StatementHandle>,
 }
-#[derive(Clone, Copy, PartialEq, Eq, Hash, ::prost::Message)]
-pub struct StatementPrepareResponse {}
+#[derive(Clone, PartialEq, Eq, Hash, ::prost::Message)]
+pub struct StatementPrepareResponse {
+    /// Result columns as described by the server
+    #[prost(message, optional, tag = "1")]
+    pub result_schema: ::core::option::Option<ArrowSchemaPtr>,
+    /// One field per bind marker
+    #[prost(message, optional, tag = "2")]
+    pub parameter_schema: ::core::option::Option<ArrowSchemaPtr>,
+}
 #[derive(Clone, PartialEq, Eq, Hash, ::prost::Message)]
 pub struct StatementSetOptionStringRequest {
     #[prost(message, optional, tag = "1")]
@@ -431,6 +467,15 @@ pub struct StatementSetOptionDoubleRequest {
 }
 #[derive(Clone, Copy, PartialEq, Eq, Hash, ::prost::Message)]
 pub struct StatementSetOptionDoubleResponse {}
+#[derive(Clone, PartialEq, ::prost::Message)]
+pub struct StatementSetOptionsRequest {
+    #[prost(message, optional, tag = "1")]
+    pub stmt_handle: ::core::option::Option<StatementHandle>,
+    #[prost(map = "string, message", tag = "2")]
+    pub options: ::std::collections::HashMap<::prost::alloc::string::String, OptionValue>,
+}
+#[derive(Clone, Copy, PartialEq, Eq, Hash, ::prost::Message)]
+pub struct StatementSetOptionsResponse {}
 #[derive(Clone, Copy, PartialEq, Eq, Hash, ::prost::Message)]
 pub struct StatementGetParameterSchemaRequest {
     #[prost(message, optional, tag = "1")]
@@ -661,6 +706,9 @@ pub trait DatabaseDriver {
     fn connection_set_option_double(
         input: ConnectionSetOptionDoubleRequest,
     ) -> Result<ConnectionSetOptionDoubleResponse, DriverException>;
+    fn connection_set_options(
+        input: ConnectionSetOptionsRequest,
+    ) -> Result<ConnectionSetOptionsResponse, DriverException>;
     fn connection_init(
         input: ConnectionInitRequest,
     ) -> Result<ConnectionInitResponse, DriverException>;
@@ -710,6 +758,9 @@ pub trait DatabaseDriver {
     fn statement_set_option_double(
         input: StatementSetOptionDoubleRequest,
     ) -> Result<StatementSetOptionDoubleResponse, DriverException>;
+    fn statement_set_options(
+        input: StatementSetOptionsRequest,
+    ) -> Result<StatementSetOptionsResponse, DriverException>;
     fn statement_get_parameter_schema(
         input: StatementGetParameterSchemaRequest,
     ) -> Result<StatementGetParameterSchemaResponse, DriverException>;
@@ -865,6 +916,17 @@ pub trait DatabaseDriverServer: DatabaseDriver {
                     Err(e) => Err(ProtoError::Application(e.encode_to_vec())),
                 }
             }
+            "connection_set_options" => {
+                let input = match ConnectionSetOptionsRequest::decode(&message[..]) {
+                    Ok(input) => input,
+                    Err(e) => return Err(ProtoError::Transport(e.to_string())),
+                };
+                let result = Self::connection_set_options(input);
+                match result {
+                    Ok(output) => Ok(output.encode_to_vec()),
+                    Err(e) => Err(ProtoError::Application(e.encode_to_vec())),
+                }
+            }
             "connection_init" => {
                 let input = match ConnectionInitRequest::decode(&message[..]) {
                     Ok(input) => input,
@@ -1052,6 +1114,17 @@ pub trait DatabaseDriverServer: DatabaseDriver {
                     Err(e) => Err(ProtoError::Application(e.encode_to_vec())),
                 }
             }
+            "statement_set_options" => {
+                let input = match StatementSetOptionsRequest::decode(&message[..]) {
+                    Ok(input) => input,
+                    Err(e) => return Err(ProtoError::Transport(e.to_string())),
+                };
+                let result = Self::statement_set_options(input);
+                match result {
+                    Ok(output) => Ok(output.encode_to_vec()),
+                    Err(e) => Err(ProtoError::Application(e.encode_to_vec())),
+                }
+            }
             "statement_get_parameter_schema" => {
                 let input = match StatementGetParameterSchemaRequest::decode(&message[..]) {
                     Ok(input) => input,
@@ -1434,6 +1507,33 @@ impl<T: Transport> DatabaseDriverClient<T> {
         }
     }
 
+    pub fn connection_set_options(
+        input: ConnectionSetOptionsRequest,
+    ) -> Result<ConnectionSetOptionsResponse, ProtoError<DriverException>> {
+        let result = T::handle_message(
+            "DatabaseDriver",
+            "connection_set_options",
+            input.encode_to_vec(),
+        );
+        match result {
+            Ok(output) => {
+                let output = ConnectionSetOptionsResponse::decode(&output[..]);
+                match output {
+                    Ok(output) => Ok(output),
+                    Err(e) => Err(ProtoError::Transport(e.to_string())),
+                }
+            }
+            Err(ProtoError::Application(e)) => {
+                let output = DriverException::decode(&e[..]);
+                match output {
+                    Ok(output) => Err(ProtoError::Application(output)),
+                    Err(e) => Err(ProtoError::Transport(e.to_string())),
+                }
+            }
+            Err(ProtoError::Transport(e)) => Err(ProtoError::Transport(e)),
+        }
+    }
+
     pub fn connection_init(
         input: ConnectionInitRequest,
     ) -> Result<ConnectionInitResponse, ProtoError<DriverException>> {
@@ -1876,6 +1976,33 @@ impl<T: Transport> DatabaseDriverClient<T> {
         }
     }
 
+    pub fn statement_set_options(
+        input: StatementSetOptionsRequest,
+    ) -> Result<StatementSetOptionsResponse, ProtoError<DriverException>> {
+        let result = T::handle_message(
+            "DatabaseDriver",
+            "statement_set_options",
+            input.encode_to_vec(),
+        );
+        match result {
+            Ok(output) => {
+                let output = StatementSetOptionsResponse::decode(&output[..]);
+                match output {
+                    Ok(output) => Ok(output),
+                    Err(e) => Err(ProtoError::Transport(e.to_string())),
+                }
+            }
+            Err(ProtoError::Application(e)) => {
+                let output = DriverException::decode(&e[..]);
+                match output {
+                    Ok(output) => Err(ProtoError::Application(output)),
+                    Err(e) => Err(ProtoError::Transport(e.to_string())),
+                }
+            }
+            Err(ProtoError::Transport(e)) => Err(ProtoError::Transport(e)),
+        }
+    }
+
     pub fn statement_get_parameter_schema(
         input: StatementGetParameterSchemaRequest,
     ) -> Result<StatementGetParameterSchemaResponse, ProtoError<DriverException>> {
@@ -2034,3 +2161,229 @@ impl<T: Transport> DatabaseDriverClient<T> {
         }
     }
 }
+pub struct DatabaseDriverLocalClient<S: DatabaseDriver> {
+    _marker: ::core::marker::PhantomData<S>,
+}
+impl<S: DatabaseDriver> DatabaseDriverLocalClient<S> {
+    pub fn database_new(
+        input: DatabaseNewRequest,
+    ) -> Result<DatabaseNewResponse, ProtoError<DriverException>> {
+        S::database_new(input).map_err(ProtoError::Application)
+    }
+
+    pub fn database_set_option_string(
+        input: DatabaseSetOptionStringRequest,
+    ) -> Result<DatabaseSetOptionStringResponse, ProtoError<DriverException>> {
+        S::database_set_option_string(input).map_err(ProtoError::Application)
+    }
+
+    pub fn database_set_option_bytes(
+        input: DatabaseSetOptionBytesRequest,
+    ) -> Result<DatabaseSetOptionBytesResponse, ProtoError<DriverException>> {
+        S::database_set_option_bytes(input).map_err(ProtoError::Application)
+    }
+
+    pub fn database_set_option_int(
+        input: DatabaseSetOptionIntRequest,
+    ) -> Result<DatabaseSetOptionIntResponse, ProtoError<DriverException>> {
+        S::database_set_option_int(input).map_err(ProtoError::Application)
+    }
+
+    pub fn database_set_option_double(
+        input: DatabaseSetOptionDoubleRequest,
+    ) -> Result<DatabaseSetOptionDoubleResponse, ProtoError<DriverException>> {
+        S::database_set_option_double(input).map_err(ProtoError::Application)
+    }
+
+    pub fn database_init(
+        input: DatabaseInitRequest,
+    ) -> Result<DatabaseInitResponse, ProtoError<DriverException>> {
+        S::database_init(input).map_err(ProtoError::Application)
+    }
+
+    pub fn database_release(
+        input: DatabaseReleaseRequest,
+    ) -> Result<DatabaseReleaseResponse, ProtoError<DriverException>> {
+        S::database_release(input).map_err(ProtoError::Application)
+    }
+
+    pub fn connection_new(
+        input: ConnectionNewRequest,
+    ) -> Result<ConnectionNewResponse, ProtoError<DriverException>> {
+        S::connection_new(input).map_err(ProtoError::Application)
+    }
+
+    pub fn connection_set_option_string(
+        input: ConnectionSetOptionStringRequest,
+    ) -> Result<ConnectionSetOptionStringResponse, ProtoError<DriverException>> {
+        S::connection_set_option_string(input).map_err(ProtoError::Application)
+    }
+
+    pub fn connection_set_option_bytes(
+        input: ConnectionSetOptionBytesRequest,
+    ) -> Result<ConnectionSetOptionBytesResponse, ProtoError<DriverException>> {
+        S::connection_set_option_bytes(input).map_err(ProtoError::Application)
+    }
+
+    pub fn connection_set_option_int(
+        input: ConnectionSetOptionIntRequest,
+    ) -> Result<ConnectionSetOptionIntResponse, ProtoError<DriverException>> {
+        S::connection_set_option_int(input).map_err(ProtoError::Application)
+    }
+
+    pub fn connection_set_option_double(
+        input: ConnectionSetOptionDoubleRequest,
+    ) -> Result<ConnectionSetOptionDoubleResponse, ProtoError<DriverException>> {
+        S::connection_set_option_double(input).map_err(ProtoError::Application)
+    }
+
+    pub fn connection_set_options(
+        input: ConnectionSetOptionsRequest,
+    ) -> Result<ConnectionSetOptionsResponse, ProtoError<DriverException>> {
+        S::connection_set_options(input).map_err(ProtoError::Application)
+    }
+
+    pub fn connection_init(
+        input: ConnectionInitRequest,
+    ) -> Result<ConnectionInitResponse, ProtoError<DriverException>> {
+        S::connection_init(input).map_err(ProtoError::Application)
+    }
+
+    pub fn connection_release(
+        input: ConnectionReleaseRequest,
+    ) -> Result<ConnectionReleaseResponse, ProtoError<DriverException>> {
+        S::connection_release(input).map_err(ProtoError::Application)
+    }
+
+    pub fn connection_get_info(
+        input: ConnectionGetInfoRequest,
+    ) -> Result<ConnectionGetInfoResponse, ProtoError<DriverException>> {
+        S::connection_get_info(input).map_err(ProtoError::Application)
+    }
+
+    pub fn connection_get_objects(
+        input: ConnectionGetObjectsRequest,
+    ) -> Result<ConnectionGetObjectsResponse, ProtoError<DriverException>> {
+        S::connection_get_objects(input).map_err(ProtoError::Application)
+    }
+
+    pub fn connection_get_table_schema(
+        input: ConnectionGetTableSchemaRequest,
+    ) -> Result<ConnectionGetTableSchemaResponse, ProtoError<DriverException>> {
+        S::connection_get_table_schema(input).map_err(ProtoError::Application)
+    }
+
+    pub fn connection_get_table_types(
+        input: ConnectionGetTableTypesRequest,
+    ) -> Result<ConnectionGetTableTypesResponse, ProtoError<DriverException>> {
+        S::connection_get_table_types(input).map_err(ProtoError::Application)
+    }
+
+    pub fn connection_commit(
+        input: ConnectionCommitRequest,
+    ) -> Result<ConnectionCommitResponse, ProtoError<DriverException>> {
+        S::connection_commit(input).map_err(ProtoError::Application)
+    }
+
+    pub fn connection_rollback(
+        input: ConnectionRollbackRequest,
+    ) -> Result<ConnectionRollbackResponse, ProtoError<DriverException>> {
+        S::connection_rollback(input).map_err(ProtoError::Application)
+    }
+
+    pub fn statement_new(
+        input: StatementNewRequest,
+    ) -> Result<StatementNewResponse, ProtoError<DriverException>> {
+        S::statement_new(input).map_err(ProtoError::Application)
+    }
+
+    pub fn statement_release(
+        input: StatementReleaseRequest,
+    ) -> Result<StatementReleaseResponse, ProtoError<DriverException>> {
+        S::statement_release(input).map_err(ProtoError::Application)
+    }
+
+    pub fn statement_set_sql_query(
+        input: StatementSetSqlQueryRequest,
+    ) -> Result<StatementSetSqlQueryResponse, ProtoError<DriverException>> {
+        S::statement_set_sql_query(input).map_err(ProtoError::Application)
+    }
+
+    pub fn statement_set_substrait_plan(
+        input: StatementSetSubstraitPlanRequest,
+    ) -> Result<StatementSetSubstraitPlanResponse, ProtoError<DriverException>> {
+        S::statement_set_substrait_plan(input).map_err(ProtoError::Application)
+    }
+
+    pub fn statement_prepare(
+        input: StatementPrepareRequest,
+    ) -> Result<StatementPrepareResponse, ProtoError<DriverException>> {
+        S::statement_prepare(input).map_err(ProtoError::Application)
+    }
+
+    pub fn statement_set_option_string(
+        input: StatementSetOptionStringRequest,
+    ) -> Result<StatementSetOptionStringResponse, ProtoError<DriverException>> {
+        S::statement_set_option_string(input).map_err(ProtoError::Application)
+    }
+
+    pub fn statement_set_option_bytes(
+        input: StatementSetOptionBytesRequest,
+    ) -> Result<StatementSetOptionBytesResponse, ProtoError<DriverException>> {
+        S::statement_set_option_bytes(input).map_err(ProtoError::Application)
+    }
+
+    pub fn statement_set_option_int(
+        input: StatementSetOptionIntRequest,
+    ) -> Result<StatementSetOptionIntResponse, ProtoError<DriverException>> {
+        S::statement_set_option_int(input).map_err(ProtoError::Application)
+    }
+
+    pub fn statement_set_option_double(
+        input: StatementSetOptionDoubleRequest,
+    ) -> Result<StatementSetOptionDoubleResponse, ProtoError<DriverException>> {
+        S::statement_set_option_double(input).map_err(ProtoError::Application)
+    }
+
+    pub fn statement_set_options(
+        input: StatementSetOptionsRequest,
+    ) -> Result<StatementSetOptionsResponse, ProtoError<DriverException>> {
+        S::statement_set_options(input).map_err(ProtoError::Application)
+    }
+
+    pub fn statement_get_parameter_schema(
+        input: StatementGetParameterSchemaRequest,
+    ) -> Result<StatementGetParameterSchemaResponse, ProtoError<DriverException>> {
+        S::statement_get_parameter_schema(input).map_err(ProtoError::Application)
+    }
+
+    pub fn statement_bind(
+        input: StatementBindRequest,
+    ) -> Result<StatementBindResponse, ProtoError<DriverException>> {
+        S::statement_bind(input).map_err(ProtoError::Application)
+    }
+
+    pub fn statement_bind_stream(
+        input: StatementBindStreamRequest,
+    ) -> Result<StatementBindStreamResponse, ProtoError<DriverException>> {
+        S::statement_bind_stream(input).map_err(ProtoError::Application)
+    }
+
+    pub fn statement_execute_query(
+        input: StatementExecuteQueryRequest,
+    ) -> Result<StatementExecuteQueryResponse, ProtoError<DriverException>> {
+        S::statement_execute_query(input).map_err(ProtoError::Application)
+    }
+
+    pub fn statement_execute_partitions(
+        input: StatementExecutePartitionsRequest,
+    ) -> Result<StatementExecutePartitionsResponse, ProtoError<DriverException>> {
+        S::statement_execute_partitions(input).map_err(ProtoError::Application)
+    }
+
+    pub fn statement_read_partition(
+        input: StatementReadPartitionRequest,
+    ) -> Result<StatementReadPartitionResponse, ProtoError<DriverException>> {
+        S::statement_read_partition(input).map_err(ProtoError::Application)
+    }
+}
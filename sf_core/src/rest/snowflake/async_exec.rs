@@ -8,7 +8,6 @@ use crate::rest::snowflake::{
 };
 use reqwest::{Method, StatusCode};
 use snafu::Location;
-use std::collections::HashMap;
 use std::panic::Location as StdLocation;
 use std::time::{Duration, Instant};
 use tracing::debug;
@@ -40,8 +39,10 @@ pub struct SubmitOk {
 
 fn build_async_query_request(
     sql: String,
-    parameter_bindings: Option<&HashMap<String, query_request::BindParameter>>,
+    parameter_bindings: Option<&query_request::Bindings>,
 ) -> query_request::Request {
+    let (bindings, bind_stage) =
+        query_request::Bindings::into_request_fields(parameter_bindings.cloned());
     query_request::Request {
         sql_text: sql,
         async_exec: true,
@@ -50,8 +51,8 @@ fn build_async_query_request(
         is_internal: false,
         describe_only: None,
         parameters: None,
-        bindings: parameter_bindings.cloned(),
-        bind_stage: None,
+        bindings,
+        bind_stage,
         query_context: query_request::QueryContext { entries: None },
     }
 }
@@ -125,7 +126,7 @@ pub async fn submit_statement_async(
     params: &QueryParameters,
     session_token: &str,
     sql: String,
-    parameter_bindings: Option<&HashMap<String, query_request::BindParameter>>,
+    parameter_bindings: Option<&query_request::Bindings>,
     request_id: uuid::Uuid,
     policy: &RetryPolicy,
 ) -> Result<SubmitOk, SfError> {
@@ -197,7 +198,7 @@ pub async fn execute_blocking_with_async(
     params: &QueryParameters,
     session_token: &str,
     sql: String,
-    parameter_bindings: Option<HashMap<String, query_request::BindParameter>>,
+    parameter_bindings: Option<query_request::Bindings>,
     request_id: uuid::Uuid,
     policy: &RetryPolicy,
 ) -> Result<query_response::Response, SfError> {
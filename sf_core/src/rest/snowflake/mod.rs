@@ -18,7 +18,6 @@ use crate::tls::error::TlsError;
 use reqwest::{self, header};
 use serde_json;
 use snafu::{Location, ResultExt, Snafu};
-use std::collections::HashMap;
 use std::time::{SystemTime, UNIX_EPOCH};
 use tracing;
 use url::Url;
@@ -193,7 +192,7 @@ pub async fn snowflake_query(
     query_parameters: QueryParameters,
     session_token: String,
     sql: String,
-    parameter_bindings: Option<HashMap<String, query_request::BindParameter>>,
+    parameter_bindings: Option<query_request::Bindings>,
     execution_mode: QueryExecutionMode,
 ) -> Result<query_response::Response, RestError> {
     let client = build_tls_http_client(&query_parameters.client_info)?;
@@ -219,7 +218,7 @@ pub async fn snowflake_query_with_client(
     query_parameters: QueryParameters,
     session_token: String,
     sql: String,
-    parameter_bindings: Option<HashMap<String, query_request::BindParameter>>,
+    parameter_bindings: Option<query_request::Bindings>,
     retry_policy: &RetryPolicy,
     execution_mode: QueryExecutionMode,
 ) -> Result<query_response::Response, RestError> {
@@ -235,7 +234,30 @@ pub async fn snowflake_query_with_client(
         .await;
     }
 
-    let query_request = query_request::Request {
+    let query_request = blocking_query_request(sql, parameter_bindings, None);
+    send_query_request(client, &query_parameters, &session_token, &query_request).await
+}
+
+/// Sends the query with `describeOnly`, so the server compiles it and returns
+/// the result and bind metadata without running it.
+#[tracing::instrument(skip(client, query_parameters, session_token), fields(sql))]
+pub async fn snowflake_describe_with_client(
+    client: &reqwest::Client,
+    query_parameters: QueryParameters,
+    session_token: String,
+    sql: String,
+) -> Result<query_response::Response, RestError> {
+    let query_request = blocking_query_request(sql, None, Some(true));
+    send_query_request(client, &query_parameters, &session_token, &query_request).await
+}
+
+fn blocking_query_request(
+    sql: String,
+    parameter_bindings: Option<query_request::Bindings>,
+    describe_only: Option<bool>,
+) -> query_request::Request {
+    let (bindings, bind_stage) = query_request::Bindings::into_request_fields(parameter_bindings);
+    query_request::Request {
         sql_text: sql,
         async_exec: false,
         sequence_id: 1,
@@ -244,14 +266,21 @@ pub async fn snowflake_query_with_client(
             .unwrap()
             .as_millis() as i64,
         is_internal: false,
-        describe_only: None,
+        describe_only,
         parameters: None,
-        bindings: parameter_bindings,
-        bind_stage: None,
+        bindings,
+        bind_stage,
         query_context: query_request::QueryContext { entries: None },
-    };
+    }
+}
 
-    let json_payload = serde_json::to_string_pretty(&query_request).unwrap();
+async fn send_query_request(
+    client: &reqwest::Client,
+    query_parameters: &QueryParameters,
+    session_token: &str,
+    query_request: &query_request::Request,
+) -> Result<query_response::Response, RestError> {
+    let json_payload = serde_json::to_string_pretty(query_request).unwrap();
     tracing::debug!("JSON Body Sent:\n{}", json_payload);
     let query_url = Url::parse(query_parameters.server_url.as_str())
         .and_then(|base| base.join(QUERY_REQUEST_PATH))
@@ -262,13 +291,13 @@ pub async fn snowflake_query_with_client(
     let request = apply_json_content_type(apply_query_headers(
         client.post(query_url),
         &query_parameters.client_info,
-        &session_token,
+        session_token,
     ))
     .query(&[
         ("requestId", uuid::Uuid::new_v4().to_string()),
         ("request_guid", uuid::Uuid::new_v4().to_string()),
     ])
-    .json(&query_request)
+    .json(query_request)
     .build()
     .context(RequestConstructionSnafu { request: "query" })?;
 
@@ -312,7 +341,7 @@ pub async fn snowflake_query_async_style(
     query_parameters: &QueryParameters,
     session_token: String,
     sql: String,
-    parameter_bindings: Option<HashMap<String, query_request::BindParameter>>,
+    parameter_bindings: Option<query_request::Bindings>,
     retry_policy: &RetryPolicy,
 ) -> Result<query_response::Response, RestError> {
     let request_id = uuid::Uuid::new_v4();
@@ -25,6 +25,27 @@ pub struct Request {
     pub query_context: QueryContext,
 }
 
+/// Parameters of a query, sent in the request or uploaded to a stage.
+#[derive(Clone)]
+pub enum Bindings {
+    Inline(HashMap<String, BindParameter>),
+    /// Stage location of CSV files with one line per parameter set
+    Stage(String),
+}
+
+impl Bindings {
+    /// Splits into the `bindings` and `bindStage` fields of a request.
+    pub fn into_request_fields(
+        bindings: Option<Self>,
+    ) -> (Option<HashMap<String, BindParameter>>, Option<String>) {
+        match bindings {
+            Some(Self::Inline(parameters)) => (Some(parameters), None),
+            Some(Self::Stage(location)) => (None, Some(location)),
+            None => (None, None),
+        }
+    }
+}
+
 #[derive(Serialize, Clone)]
 pub struct BindParameter {
     #[serde(rename = "type")]
@@ -2,6 +2,7 @@ use crate::chunks::ChunkDownloadData;
 use crate::file_manager::SourceCompressionParam;
 use crate::{file_manager, query_types};
 use serde::Deserialize;
+use serde_json::value::RawValue;
 use snafu::{OptionExt, Snafu};
 use std::collections::HashMap;
 // TODO: Delete all unused fields when we are sure they are not needed
@@ -19,8 +20,9 @@ pub struct Response {
 
 #[derive(Deserialize)]
 pub struct Data {
+    /// Kept as raw JSON and decoded once the row types are known
     #[serde(rename = "rowset")]
-    pub rowset: Option<Vec<Vec<String>>>,
+    pub rowset: Option<Box<RawValue>>,
     #[serde(rename = "rowsetBase64")]
     pub rowset_base64: Option<String>,
     #[serde(rename = "rowtype")]
@@ -74,7 +76,10 @@ pub struct Data {
     #[serde(rename = "finalRoleName")]
     _final_role_name: Option<String>,
     #[serde(rename = "numberOfBinds")]
-    _number_of_binds: Option<i32>,
+    pub number_of_binds: Option<i32>,
+    /// Parameter metadata, returned for describe-only requests
+    #[serde(rename = "metaDataOfBinds")]
+    pub meta_data_of_binds: Option<Vec<BindMetadata>>,
     #[serde(rename = "statementTypeId")]
     _statement_type_id: Option<i64>,
     #[serde(rename = "version")]
@@ -97,8 +102,9 @@ pub struct Data {
     _async_rows: Option<SnowflakeRows>,
     #[serde(rename = "uploadInfo")]
     _upload_info: Option<StageInfo>,
+    /// Files transferred at once, the PARALLEL option of PUT and GET
     #[serde(rename = "parallel")]
-    _parallel: Option<i64>,
+    pub parallel: Option<i64>,
     #[serde(rename = "threshold")]
     _threshold: Option<i64>,
     #[serde(rename = "clientShowEncryptionParameter")]
@@ -137,11 +143,11 @@ pub struct QueryContextEntry {
 pub struct Chunk {
     #[serde(rename = "url")]
     url: String,
+    #[serde(rename = "uncompressedSize")]
+    uncompressed_size: i64,
     //unused fields
     #[serde(rename = "rowCount")]
     _row_count: i32,
-    #[serde(rename = "uncompressedSize")]
-    _uncompressed_size: i64,
     #[serde(rename = "compressedSize")]
     _compressed_size: i64,
 }
@@ -183,6 +189,28 @@ pub struct RowType {
     pub _fields: Option<Vec<FieldMetadata>>,
 }
 
+#[derive(Deserialize)]
+pub struct BindMetadata {
+    #[serde(rename = "name")]
+    pub name: Option<String>,
+    #[serde(rename = "type")]
+    pub type_: String,
+    #[serde(rename = "nullable", default = "nullable_by_default")]
+    pub nullable: bool,
+    #[serde(rename = "scale")]
+    pub scale: Option<u64>,
+    #[serde(rename = "byteLength")]
+    pub byte_length: Option<u64>,
+    #[serde(rename = "length")]
+    pub length: Option<u64>,
+    #[serde(rename = "precision")]
+    pub precision: Option<u64>,
+}
+
+fn nullable_by_default() -> bool {
+    true
+}
+
 #[derive(Deserialize)]
 pub struct FieldMetadata {
     //unused fields
@@ -264,7 +292,10 @@ pub struct EncryptionMaterial {
 
 impl Data {
     /// Copies the fields necessary for file transfer.
-    pub fn to_file_upload_data(&self) -> Result<file_manager::UploadData, QueryResponseError> {
+    pub fn to_file_upload_data(
+        &self,
+        multipart: file_manager::MultipartConfig,
+    ) -> Result<file_manager::UploadData, QueryResponseError> {
         let src_locations = self.src_locations.as_ref().context(MissingParameterSnafu {
             parameter: "source locations",
         })?;
@@ -353,9 +384,18 @@ impl Data {
             auto_compress,
             source_compression,
             overwrite,
+            parallel: self.transfer_parallelism(),
+            multipart,
         })
     }
 
+    fn transfer_parallelism(&self) -> usize {
+        match self.parallel {
+            Some(parallel) if parallel > 0 => parallel as usize,
+            _ => file_manager::DEFAULT_PARALLEL,
+        }
+    }
+
     pub fn to_file_download_data(&self) -> Result<file_manager::DownloadData, QueryResponseError> {
         let src_locations = self
             .src_locations
@@ -409,6 +449,7 @@ impl Data {
             local_location,
             stage_info,
             encryption_materials,
+            parallel: self.transfer_parallelism(),
         })
     }
 
@@ -417,7 +458,10 @@ impl Data {
         let chunk_headers = self.chunk_headers.as_ref()?;
         let chunk_download_data = chunks
             .iter()
-            .map(|chunk| ChunkDownloadData::new(&chunk.url, chunk_headers))
+            .map(|chunk| {
+                ChunkDownloadData::new(&chunk.url, chunk_headers)
+                    .with_uncompressed_size(chunk.uncompressed_size)
+            })
             .collect();
 
         Some(chunk_download_data)
@@ -0,0 +1,149 @@
+//! Driver-wide tokio runtime.
+//!
+//! Every blocking facade (query execution, login, chunk prefetching, CRL
+//! validation) submits its futures to a single lazily created multi-threaded
+//! runtime instead of building a runtime per call.
+
+use std::future::Future;
+use std::sync::Mutex;
+
+use once_cell::sync::OnceCell;
+use tokio::runtime::{Builder, Runtime};
+
+use crate::config::ConfigError;
+use crate::config::settings::{Settings, positive_int_setting};
+
+pub const RUNTIME_WORKER_THREADS_OPTION: &str = "runtime_worker_threads";
+pub const RUNTIME_THREAD_NAME_OPTION: &str = "runtime_thread_name";
+pub const RUNTIME_THREAD_STACK_SIZE_OPTION: &str = "runtime_thread_stack_size";
+
+const DEFAULT_THREAD_NAME: &str = "sf-core-worker";
+
+#[derive(Clone, Debug, PartialEq, Eq)]
+pub struct RuntimeConfig {
+    /// Number of worker threads, tokio picks the number of cores when unset.
+    pub worker_threads: Option<usize>,
+    pub thread_name: String,
+    /// Stack size of worker threads in bytes, tokio's default when unset.
+    pub thread_stack_size: Option<usize>,
+}
+
+impl Default for RuntimeConfig {
+    fn default() -> Self {
+        Self {
+            worker_threads: None,
+            thread_name: DEFAULT_THREAD_NAME.to_string(),
+            thread_stack_size: None,
+        }
+    }
+}
+
+impl RuntimeConfig {
+    /// Returns `None` when the settings do not mention the runtime at all.
+    pub fn from_settings(settings: &dyn Settings) -> Result<Option<Self>, ConfigError> {
+        let worker_threads = positive_int_setting(settings, RUNTIME_WORKER_THREADS_OPTION)?;
+        let thread_name = settings.get_string(RUNTIME_THREAD_NAME_OPTION);
+        let thread_stack_size = positive_int_setting(settings, RUNTIME_THREAD_STACK_SIZE_OPTION)?;
+        if worker_threads.is_none() && thread_name.is_none() && thread_stack_size.is_none() {
+            return Ok(None);
+        }
+        Ok(Some(Self {
+            worker_threads,
+            thread_name: thread_name.unwrap_or_else(|| DEFAULT_THREAD_NAME.to_string()),
+            thread_stack_size,
+        }))
+    }
+
+    fn build(&self) -> std::io::Result<Runtime> {
+        let mut builder = Builder::new_multi_thread();
+        builder.enable_all().thread_name(self.thread_name.clone());
+        if let Some(worker_threads) = self.worker_threads {
+            builder.worker_threads(worker_threads);
+        }
+        if let Some(stack_size) = self.thread_stack_size {
+            builder.thread_stack_size(stack_size);
+        }
+        builder.build()
+    }
+}
+
+static RUNTIME_CONFIG: Mutex<Option<RuntimeConfig>> = Mutex::new(None);
+static RUNTIME: OnceCell<Runtime> = OnceCell::new();
+
+/// Sets the configuration used when the runtime is first needed.
+///
+/// Returns `false` and leaves the running runtime untouched if it was already
+/// started, because a live runtime cannot be reconfigured.
+pub fn configure_runtime(config: RuntimeConfig) -> bool {
+    let mut current = RUNTIME_CONFIG.lock().unwrap();
+    if RUNTIME.get().is_some() {
+        if current.as_ref() != Some(&config) {
+            tracing::warn!(
+                ?config,
+                "Driver runtime already started, ignoring new configuration"
+            );
+        }
+        return false;
+    }
+    *current = Some(config);
+    true
+}
+
+/// Returns the driver-wide runtime, creating it on first use.
+pub fn global_runtime() -> std::io::Result<&'static Runtime> {
+    RUNTIME.get_or_try_init(|| {
+        let config = RUNTIME_CONFIG
+            .lock()
+            .unwrap()
+            .get_or_insert_with(RuntimeConfig::default)
+            .clone();
+        tracing::debug!(?config, "Starting driver runtime");
+        config.build()
+    })
+}
+
+/// Runs a future to completion on the driver-wide runtime.
+///
+/// Must not be called from a thread that is already driving an async task.
+pub fn block_on<F: Future>(future: F) -> std::io::Result<F::Output> {
+    Ok(global_runtime()?.block_on(future))
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::config::settings::Setting;
+    use std::collections::HashMap;
+
+    #[test]
+    fn runtime_config_absent_without_runtime_settings() {
+        let mut settings: HashMap<String, Setting> = HashMap::new();
+        settings.insert("account".to_string(), Setting::String("test".to_string()));
+        assert_eq!(RuntimeConfig::from_settings(&settings).unwrap(), None);
+    }
+
+    #[test]
+    fn runtime_config_from_settings() {
+        let mut settings: HashMap<String, Setting> = HashMap::new();
+        settings.insert(RUNTIME_WORKER_THREADS_OPTION.to_string(), Setting::Int(2));
+        settings.insert(
+            RUNTIME_THREAD_STACK_SIZE_OPTION.to_string(),
+            Setting::String("4194304".to_string()),
+        );
+        let config = RuntimeConfig::from_settings(&settings).unwrap().unwrap();
+        assert_eq!(config.worker_threads, Some(2));
+        assert_eq!(config.thread_name, DEFAULT_THREAD_NAME);
+        assert_eq!(config.thread_stack_size, Some(4_194_304));
+    }
+
+    #[test]
+    fn block_on_reuses_single_runtime() {
+        let first = block_on(async { std::thread::current().id() }).unwrap();
+        let second = block_on(async { std::thread::current().id() }).unwrap();
+        assert_eq!(first, second);
+        assert!(std::ptr::eq(
+            global_runtime().unwrap(),
+            global_runtime().unwrap()
+        ));
+    }
+}
@@ -1,6 +1,10 @@
-use arrow::array::{Array, ArrayRef, ArrowPrimitiveType, PrimitiveArray, StructArray};
+use arrow::array::{
+    Array, ArrayRef, ArrowPrimitiveType, PrimitiveArray, RecordBatch, RecordBatchIterator,
+    StructArray,
+};
 use arrow::datatypes::{Field, Schema};
 use arrow::ffi::{FFI_ArrowArray, FFI_ArrowSchema};
+use arrow::ffi_stream::FFI_ArrowArrayStream;
 use proto_utils::ProtoError;
 use sf_core::protobuf_apis::database_driver_v1::DatabaseDriverClient;
 use sf_core::protobuf_gen::database_driver_v1::*;
@@ -177,6 +181,40 @@ impl SnowflakeTestClient {
         .unwrap();
     }
 
+    /// Binds one single-column parameter batch per slice as a parameter stream
+    pub fn bind_parameter_stream<T: ArrowPrimitiveType>(
+        &self,
+        stmt: &StatementHandle,
+        batches: &[&[T::Native]],
+    ) where
+        PrimitiveArray<T>: From<Vec<T::Native>>,
+    {
+        let schema = Arc::new(Schema::new(vec![Field::new(
+            "param_1",
+            T::DATA_TYPE,
+            false,
+        )]));
+        let batches = batches
+            .iter()
+            .map(|values| {
+                let array = Arc::new(PrimitiveArray::<T>::from(values.to_vec())) as ArrayRef;
+                RecordBatch::try_new(schema.clone(), vec![array])
+            })
+            .collect::<Vec<_>>();
+        let reader = RecordBatchIterator::new(batches, schema);
+        let raw_stream = Box::into_raw(Box::new(FFI_ArrowArrayStream::new(Box::new(reader))));
+
+        DatabaseDriverClient::statement_bind_stream(StatementBindStreamRequest {
+            stmt_handle: Some(*stmt),
+            stream: unsafe {
+                let len = size_of::<*mut FFI_ArrowArrayStream>();
+                let buf_ptr = std::ptr::addr_of!(raw_stream) as *const u8;
+                std::slice::from_raw_parts(buf_ptr, len).to_vec()
+            },
+        })
+        .unwrap();
+    }
+
     pub fn release_statement(&self, stmt: &StatementHandle) {
         DatabaseDriverClient::statement_release(StatementReleaseRequest {
             stmt_handle: Some(*stmt),
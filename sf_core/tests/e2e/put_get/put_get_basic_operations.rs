@@ -5,6 +5,7 @@ use crate::common::put_get_common::PutResult;
 use crate::common::put_get_common::assert_file_exists;
 use crate::common::put_get_common::get_file_from_stage;
 use crate::common::put_get_common::upload_to_stage;
+use crate::common::put_get_common::upload_to_stage_with_options;
 use crate::common::snowflake_test_client::SnowflakeTestClient;
 use arrow::datatypes::Field;
 use std::fs;
@@ -74,6 +75,36 @@ fn should_get_file_uploaded_to_stage() {
     );
 }
 
+#[test]
+fn should_get_file_larger_than_one_download_range() {
+    // Given Uncompressed file spanning several download ranges is uploaded to stage
+    let client = SnowflakeTestClient::connect_with_default_auth();
+    let stage_name = "TEST_STAGE_GET_RANGES";
+    let filename = "test_get_ranges.bin";
+    let temp_dir = tempfile::TempDir::new().unwrap();
+    let test_file_path = temp_dir.path().join(filename);
+    let content: Vec<u8> = (0..20 * 1024 * 1024u32)
+        .map(|i| (i.wrapping_mul(2_654_435_761) >> 24) as u8)
+        .collect();
+    fs::write(&test_file_path, &content).unwrap();
+    upload_to_stage_with_options(
+        &client,
+        stage_name,
+        test_file_path.to_str().unwrap(),
+        "AUTO_COMPRESS=FALSE",
+    );
+
+    // When File is downloaded using GET command
+    let (_get_result, download_dir) = get_file_from_stage(&client, stage_name, filename);
+
+    // Then File should have the uploaded content
+    let downloaded_content = fs::read(download_dir.path().join(filename)).unwrap();
+    assert!(
+        downloaded_content == content,
+        "Downloaded content should match original"
+    );
+}
+
 #[test]
 fn should_return_correct_rowset_for_put() {
     // Given Snowflake client is logged in
@@ -1,6 +1,8 @@
 use crate::common::arrow_result_helper::ArrowResultHelper;
 use crate::common::file_utils::create_test_file;
-use crate::common::put_get_common::{assert_file_exists, upload_to_stage};
+use crate::common::put_get_common::{
+    GetResult, PutResult, assert_file_exists, upload_to_stage, upload_to_stage_with_options,
+};
 use crate::common::snowflake_test_client::SnowflakeTestClient;
 use sf_core::protobuf_gen::database_driver_v1::ExecuteResult;
 use std::path::Path;
@@ -68,6 +70,35 @@ fn should_upload_files_that_match_wildcard_star_pattern() {
     assert_non_matching_files_not_in_stage(&result_vector, stage_name, &non_matching_files);
 }
 
+#[test]
+fn should_upload_files_in_parallel_keeping_pattern_order() {
+    // Given Files matching wildcard pattern
+    let client = SnowflakeTestClient::connect_with_default_auth();
+    let stage_name = "TEST_STAGE_PUT_WILDCARD_PARALLEL";
+    let base_file_name = "test_put_wildcard_parallel";
+    let temp_dir = TempDir::new().unwrap();
+    let matching_files = create_matching_files(&temp_dir, base_file_name);
+
+    // When Files are uploaded using command with star wildcard and parallelism below file count
+    let files_wildcard = format!(
+        "{}/{base_file_name}_*.csv",
+        temp_dir.path().to_str().unwrap().replace("\\", "/"),
+    );
+    let put_data = upload_to_stage_with_options(&client, stage_name, &files_wildcard, "PARALLEL=2");
+
+    // Then Every file is reported as uploaded in pattern order
+    let put_results: Vec<PutResult> = ArrowResultHelper::from_result(put_data)
+        .fetch_all()
+        .expect("Failed to fetch PUT results");
+    let sources: Vec<&str> = put_results.iter().map(|r| r.source.as_str()).collect();
+    assert_eq!(sources, matching_files);
+    assert!(put_results.iter().all(|r| r.status == "UPLOADED"));
+
+    // And Files are listed in stage
+    let result_vector = get_stage_listing_results(&client, stage_name);
+    assert_matching_files_in_stage(&result_vector, stage_name, base_file_name);
+}
+
 // This test's purpose is to check if download of multiple files is working correctly.
 // Regular expression handling is the job of Snowflake's backend.
 // Escaping in the regexp does not seem to work correctly, it should be taken care of in the future.
@@ -108,6 +139,43 @@ fn should_download_files_that_are_matching_wildcard_pattern() {
     assert_non_matching_files_not_downloaded(&download_temp_dir, &non_matching_files);
 }
 
+#[test]
+fn should_download_files_in_parallel() {
+    // Given Files are uploaded to stage
+    let client = SnowflakeTestClient::connect_with_default_auth();
+    let stage_name = "TEST_STAGE_GET_PARALLEL";
+    let base_file_name = "test_get_parallel";
+    let temp_dir = TempDir::new().unwrap();
+    create_matching_files(&temp_dir, base_file_name);
+    let files_wildcard = format!(
+        "{}/{base_file_name}_*.csv",
+        temp_dir.path().to_str().unwrap().replace("\\", "/"),
+    );
+    upload_to_stage(&client, stage_name, &files_wildcard);
+
+    // When Files are downloaded with parallelism below file count
+    let download_temp_dir = TempDir::new().unwrap();
+    let get_sql = format!(
+        "GET @{stage_name} file://{}/ PARALLEL=2",
+        download_temp_dir
+            .path()
+            .to_str()
+            .unwrap()
+            .replace("\\", "/"),
+    );
+    let get_data = client.execute_query(&get_sql);
+
+    // Then Every file is reported as downloaded
+    let get_results: Vec<GetResult> = ArrowResultHelper::from_result(get_data)
+        .fetch_all()
+        .expect("Failed to fetch GET results");
+    assert_eq!(get_results.len(), 5);
+    assert!(get_results.iter().all(|r| r.status == "DOWNLOADED"));
+
+    // And Files are written to the local directory
+    assert_matching_files_downloaded(&download_temp_dir, base_file_name);
+}
+
 fn create_matching_files(temp_dir: &TempDir, base_file_name: &str) -> Vec<String> {
     let matching_files: Vec<String> = (1..=5)
         .map(|i| format!("{base_file_name}_{i}.csv"))
@@ -44,3 +44,30 @@ fn should_bind_multiple_parameters_to_statement() {
     // And Statement should be released
     client.release_statement(&stmt);
 }
+
+#[test]
+fn should_insert_bound_parameter_stream_in_groups() {
+    // Given Snowflake client is logged in
+    let client = SnowflakeTestClient::connect_with_default_auth();
+
+    // And A temporary table exists
+    client.execute_query("CREATE TEMPORARY TABLE bind_stream_test (id INT)");
+
+    // And Streamed parameters are sent four rows at a time
+    client.set_connection_option("bind_stream_flush_rows", "4");
+
+    // When Insert is executed with a stream of parameter batches
+    let stmt = client.new_statement();
+    client.set_sql_query(&stmt, "INSERT INTO bind_stream_test VALUES (?)");
+    client.bind_parameter_stream::<Int32Type>(&stmt, &[&[1, 2, 3], &[4, 5, 6, 7, 8, 9, 10]]);
+    client.execute_statement_query(&stmt);
+
+    // Then Every streamed row should be inserted
+    let result = client
+        .execute_query("SELECT TO_VARCHAR(COUNT(*)), TO_VARCHAR(SUM(id)) FROM bind_stream_test");
+    let mut arrow_helper = ArrowResultHelper::from_result(result);
+    arrow_helper.assert_equals_single_row(vec!["10".to_string(), "55".to_string()]);
+
+    // And Statement should be released
+    client.release_statement(&stmt);
+}
@@ -22,9 +22,7 @@ void execute_fetch_test(SQLHDBC dbc, const std::string& sql_command, int warmup_
   std::cout << "\n=== Executing SELECT Test ===\n";
   std::cout << "Query: " << sql_command << "\n";
 
-  // TODO SNOW-2876245: Bulk fetch not yet implemented. Decision needed on which fetch method to
-  // use. Currently using row-by-row fetch.
-  bool use_bulk_fetch = false;
+  bool use_bulk_fetch = true;
 
   run_warmup(dbc, sql_command, warmup_iterations, use_bulk_fetch);
   auto results = run_test_iterations(dbc, sql_command, iterations, use_bulk_fetch);
@@ -98,15 +96,17 @@ TestResult run_query(SQLHDBC dbc, const std::string& sql_command, int iteration,
 
   if (use_bulk_fetch) {
     // Bulk fetch: Set bulk fetch size to 1024 rows (matches old implementation)
-    // Note: Universal driver doesn't support SQL_ATTR_ROW_ARRAY_SIZE yet
     const std::size_t bulk_size = 1024;
     ret = SQLSetStmtAttr(stmt, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER)bulk_size, 0);
     check_odbc_error(ret, SQL_HANDLE_STMT, stmt, "SQLSetStmtAttr ROW_ARRAY_SIZE");
+    SQLULEN rows_fetched = 0;
+    ret = SQLSetStmtAttr(stmt, SQL_ATTR_ROWS_FETCHED_PTR, &rows_fetched, 0);
+    check_odbc_error(ret, SQL_HANDLE_STMT, stmt, "SQLSetStmtAttr ROWS_FETCHED_PTR");
 
-    // Fetch in bulk (1024 rows at a time)
+    // Fetch in bulk (up to 1024 rows at a time)
     while ((ret = SQLFetch(stmt)) != SQL_NO_DATA) {
       check_odbc_error(ret, SQL_HANDLE_STMT, stmt, "SQLFetch");
-      row_count += bulk_size;
+      row_count += rows_fetched;
     }
   } else {
     // Row-by-row fetch